@@ -16,6 +16,9 @@ namespace quda {
   extern unsigned long long blas_flops;
   extern unsigned long long blas_bytes;
 
+  /**< Cumulative wall-clock time of the reductions, including the wait for their results and the global sum */
+  extern double blas_reduce_secs;
+
   // C++ linkage
 
   // Generic variants
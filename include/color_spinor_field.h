@@ -34,14 +34,14 @@ namespace quda {
     : LatticeFieldParam(), nColor(0), nSpin(0), twistFlavor(QUDA_TWIST_INVALID), 
       siteSubset(QUDA_INVALID_SITE_SUBSET), siteOrder(QUDA_INVALID_SITE_ORDER), 
       fieldOrder(QUDA_INVALID_FIELD_ORDER), gammaBasis(QUDA_INVALID_GAMMA_BASIS), 
-      create(QUDA_INVALID_FIELD_CREATE) { ; }
+      create(QUDA_INVALID_FIELD_CREATE), v(0), norm(0) { ; }
   
     // used to create cpu params
   ColorSpinorParam(void *V, QudaInvertParam &inv_param, const int *X, const bool pc_solution)
     : LatticeFieldParam(4, X, 0, inv_param.cpu_prec), nColor(3), nSpin(inv_param.dslash_type == QUDA_ASQTAD_DSLASH ? 1 : 4), 
       twistFlavor(inv_param.twist_flavor), siteSubset(QUDA_INVALID_SITE_SUBSET), siteOrder(QUDA_INVALID_SITE_ORDER), 
       fieldOrder(QUDA_INVALID_FIELD_ORDER), gammaBasis(inv_param.gamma_basis), 
-      create(QUDA_REFERENCE_FIELD_CREATE), v(V) { 
+      create(QUDA_REFERENCE_FIELD_CREATE), v(V), norm(0) { 
 
         if (nDim > QUDA_MAX_DIM) errorQuda("Number of dimensions too great");
 	for (int d=0; d<nDim; d++) x[d] = X[d];
@@ -66,6 +66,7 @@ namespace quda {
 	  fieldOrder = (precision == QUDA_DOUBLE_PRECISION || nSpin == 1) ? 
 	    QUDA_FLOAT2_FIELD_ORDER : QUDA_FLOAT4_FIELD_ORDER; 
 	  siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+	  pad = inv_param.sp_pad; // the native layout includes the pad
 	} else if (inv_param.dirac_order == QUDA_CPS_WILSON_DIRAC_ORDER) {
 	  fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
 	  siteOrder = QUDA_ODD_EVEN_SITE_ORDER;
@@ -78,6 +79,9 @@ namespace quda {
 	} else if (inv_param.dirac_order == QUDA_QDPJIT_DIRAC_ORDER) {
 	  fieldOrder = QUDA_QDPJIT_FIELD_ORDER;
 	  siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+	} else if (inv_param.dirac_order == QUDA_AOSOA_DIRAC_ORDER) {
+	  fieldOrder = QUDA_AOSOA_FIELD_ORDER;
+	  siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
 	} else {
 	  errorQuda("Dirac order %d not supported", inv_param.dirac_order);
 	}
@@ -283,6 +287,14 @@ namespace quda {
     void loadSpinorField(const ColorSpinorField &src);
     void saveSpinorField (ColorSpinorField &src) const;
 
+    /**
+       Returns true if the host field has the same native layout as
+       this field (precision, FloatN order, site order, stride, pad and
+       gamma basis), in which case it is transferred parity by parity
+       with no reordering and no staging through the pinned buffer.
+    */
+    bool directCopy(const ColorSpinorField &host) const;
+
   public:
     //cudaColorSpinorField();
     cudaColorSpinorField(const cudaColorSpinorField&);
@@ -354,6 +366,8 @@ namespace quda {
   template <typename Float> class SpaceColorSpinOrder;
   template <typename Float> class SpaceSpinColorOrder;
   template <typename Float> class QOPDomainWallOrder;
+  template <typename Float> class FloatNFieldOrder;
+  template <typename Float> class AoSoAFieldOrder;
 
   // CPU implementation
   class cpuColorSpinorField : public ColorSpinorField {
@@ -363,6 +377,8 @@ namespace quda {
     template <typename Float> friend class SpaceColorSpinOrder;
     template <typename Float> friend class SpaceSpinColorOrder;
     template <typename Float> friend class QOPDomainWallOrder;
+    template <typename Float> friend class FloatNFieldOrder;
+    template <typename Float> friend class AoSoAFieldOrder;
 
   public:
     static void* fwdGhostFaceBuffer[QUDA_MAX_DIM]; //cpu memory
@@ -3,6 +3,12 @@
   ordering.  Currently this is used for cpu fields only with limited
   ordering support, but this will be expanded for device ordering
   also.
+
+  The cpu accessors below are policies rather than an interface: none
+  of their members is virtual, and the generic host routines
+  (genericSource, genericCompare, genericPrintVector) are templated on
+  the concrete order type, so that element access is inlined into
+  their loops.
 */
 
 #include <register_traits.h>
@@ -14,17 +20,17 @@ namespace quda {
 
   protected:
     cpuColorSpinorField &field;
+    const int nColor;
+    const int nSpin;
+    const int volume;
 
   public:
-    ColorSpinorFieldOrder(cpuColorSpinorField &field) : field(field) { ; }
-    virtual ~ColorSpinorFieldOrder() { ; }
-    
-    virtual const Float& operator()(const int &x, const int &s, const int &c, const int &z) const = 0;
-    virtual Float& operator()(const int &x, const int &s, const int &c, const int &z) = 0;
+    ColorSpinorFieldOrder(cpuColorSpinorField &field) 
+      : field(field), nColor(field.Ncolor()), nSpin(field.Nspin()), volume(field.Volume()) { ; }
 
-    int Ncolor() const { return field.Ncolor(); }
-    int Nspin() const { return field.Nspin(); }
-    int Volume() const { return field.Volume(); }
+    int Ncolor() const { return nColor; }
+    int Nspin() const { return nSpin; }
+    int Volume() const { return volume; }
 
   };
 
@@ -32,21 +38,22 @@ namespace quda {
     class SpaceSpinColorOrder : public ColorSpinorFieldOrder<Float> {
 
   private:
-    cpuColorSpinorField &field; // convenient to have a "local" reference for code brevity
+    Float *v;
+    using ColorSpinorFieldOrder<Float>::nColor;
+    using ColorSpinorFieldOrder<Float>::nSpin;
 
   public:
-  SpaceSpinColorOrder(cpuColorSpinorField &field): ColorSpinorFieldOrder<Float>(field), field(field) 
+  SpaceSpinColorOrder(cpuColorSpinorField &field): ColorSpinorFieldOrder<Float>(field), v((Float*)field.v)
     { ; }
-    virtual ~SpaceSpinColorOrder() { ; }
 
     const Float& operator()(const int &x, const int &s, const int &c, const int &z) const {
-      unsigned long index = ((x*field.nSpin+s)*field.nColor+c)*2+z;
-      return *((Float*)(field.v) + index);
+      unsigned long index = ((x*nSpin+s)*nColor+c)*2+z;
+      return v[index];
     }
 
     Float& operator()(const int &x, const int &s, const int &c, const int &z) {
-      unsigned long index = ((x*field.nSpin+s)*field.nColor+c)*2+z;
-      return *((Float*)(field.v) + index);
+      unsigned long index = ((x*nSpin+s)*nColor+c)*2+z;
+      return v[index];
     }
   };
 
@@ -54,21 +61,22 @@ namespace quda {
     class SpaceColorSpinOrder : public ColorSpinorFieldOrder<Float> {
 
   private:
-    cpuColorSpinorField &field;  // convenient to have a "local" reference for code brevity
+    Float *v;
+    using ColorSpinorFieldOrder<Float>::nColor;
+    using ColorSpinorFieldOrder<Float>::nSpin;
 
   public:
-  SpaceColorSpinOrder(cpuColorSpinorField &field) : ColorSpinorFieldOrder<Float>(field), field(field)
+  SpaceColorSpinOrder(cpuColorSpinorField &field) : ColorSpinorFieldOrder<Float>(field), v((Float*)field.v)
     { ; }
-    virtual ~SpaceColorSpinOrder() { ; }
 
     const Float& operator()(const int &x, const int &s, const int &c, const int &z) const {
-      unsigned long index = ((x*field.nColor+c)*field.nSpin+s)*2+z;
-      return *((Float*)(field.v) + index);
+      unsigned long index = ((x*nColor+c)*nSpin+s)*2+z;
+      return v[index];
     }
 
     Float& operator()(const int &x, const int &s, const int &c, const int &z) {
-      unsigned long index = ((x*field.nColor+c)*field.nSpin+s)*2+z;    
-      return *((Float*)(field.v) + index);
+      unsigned long index = ((x*nColor+c)*nSpin+s)*2+z;    
+      return v[index];
     }
   };
 
@@ -76,32 +84,108 @@ namespace quda {
     class QOPDomainWallOrder : public ColorSpinorFieldOrder<Float> {
 
   private:
-    cpuColorSpinorField &field;  // convenient to have a "local" reference for code brevity
+    Float **v;
     int volume_4d;
     int Ls;
+    using ColorSpinorFieldOrder<Float>::nColor;
+    using ColorSpinorFieldOrder<Float>::nSpin;
 
   public:
   QOPDomainWallOrder(cpuColorSpinorField &field) : ColorSpinorFieldOrder<Float>(field), 
-      field(field), volume_4d(1), Ls(0)
+      v((Float**)field.v), volume_4d(1), Ls(0)
       { 
 	if (field.Ndim() != 5) errorQuda("Error, wrong number of dimensions for this ColorSpinorFieldOrder");
 	for (int i=0; i<4; i++) volume_4d *= field.x[i];
 	Ls = field.x[4];
       }
-    virtual ~QOPDomainWallOrder() { ; }
 
     const Float& operator()(const int &x, const int &s, const int &c, const int &z) const {
       int ls = x / Ls;
       int x_4d = x - ls*volume_4d;
-      unsigned long index_4d = ((x_4d*field.nColor+c)*field.nSpin+s)*2+z;
-      return ((Float**)(field.v))[ls][index_4d];
+      unsigned long index_4d = ((x_4d*nColor+c)*nSpin+s)*2+z;
+      return v[ls][index_4d];
     }
 
     Float& operator()(const int &x, const int &s, const int &c, const int &z) {
       int ls = x / Ls;
       int x_4d = x - ls*volume_4d;
-      unsigned long index_4d = ((x_4d*field.nColor+c)*field.nSpin+s)*2+z;
-      return ((Float**)(field.v))[ls][index_4d];
+      unsigned long index_4d = ((x_4d*nColor+c)*nSpin+s)*2+z;
+      return v[ls][index_4d];
+    }
+  };
+
+  /**
+     Accessor for host fields that are stored in the native FloatN
+     order, e.g., fields wrapped with QUDA_INTERNAL_DIRAC_ORDER.  Each
+     parity occupies half of the field, and within a parity internal
+     element i of site x is at ((i/N)*stride + x)*N + i%N.
+  */
+  template <typename Float>
+    class FloatNFieldOrder : public ColorSpinorFieldOrder<Float> {
+
+  private:
+    Float *v;
+    int N;
+    int volumeCB;
+    int stride;
+    size_t parityLength;
+    using ColorSpinorFieldOrder<Float>::nColor;
+
+    unsigned long index(const int &x, const int &s, const int &c, const int &z) const {
+      int parity = x / volumeCB;
+      int x_cb = x - parity*volumeCB;
+      int internal_idx = (s*nColor + c)*2 + z;
+      return parity*parityLength + ((internal_idx/N)*stride + x_cb)*N + internal_idx%N;
+    }
+
+  public:
+  FloatNFieldOrder(cpuColorSpinorField &field) : ColorSpinorFieldOrder<Float>(field), v((Float*)field.v),
+      N(field.fieldOrder == QUDA_FLOAT4_FIELD_ORDER ? 4 : 2), volumeCB(field.volumeCB), stride(field.stride),
+      parityLength(field.bytes/2/sizeof(Float))
+      { ; }
+
+    const Float& operator()(const int &x, const int &s, const int &c, const int &z) const {
+      return v[index(x, s, c, z)];
+    }
+
+    Float& operator()(const int &x, const int &s, const int &c, const int &z) {
+      return v[index(x, s, c, z)];
+    }
+  };
+
+  /**
+     Accessor for host fields in the AoSoA order: blocks of W
+     consecutive sites, with the W values of each complex
+     spin-color component stored together.
+  */
+  template <typename Float>
+    class AoSoAFieldOrder : public ColorSpinorFieldOrder<Float> {
+
+  private:
+    Float *v;
+    int volumeCB;
+    static const int W = QUDA_AOSOA_BLOCK_BYTES / sizeof(Float);
+    using ColorSpinorFieldOrder<Float>::nColor;
+    using ColorSpinorFieldOrder<Float>::nSpin;
+
+    unsigned long index(const int &x, const int &s, const int &c, const int &z) const {
+      int parity = x / volumeCB;
+      int x_cb = x - parity*volumeCB;
+      unsigned long block = parity*(volumeCB/W) + x_cb/W;
+      return (((block*nSpin + s)*nColor + c)*W + x_cb%W)*2 + z;
+    }
+
+  public:
+  AoSoAFieldOrder(cpuColorSpinorField &field) : ColorSpinorFieldOrder<Float>(field), 
+      v((Float*)field.v), volumeCB(field.volumeCB)
+    { ; }
+
+    const Float& operator()(const int &x, const int &s, const int &c, const int &z) const {
+      return v[index(x, s, c, z)];
+    }
+
+    Float& operator()(const int &x, const int &s, const int &c, const int &z) {
+      return v[index(x, s, c, z)];
     }
   };
 
@@ -145,7 +229,7 @@ struct FloatNOrder {
 	  int internal_idx = (s*Nc + c)*2 + z;
 	  int pad_idx = internal_idx / N;
 	  if (sizeof(Float)==sizeof(short))
-	    copy(field[(pad_idx * stride + x)*N + internal_idx % N], v[(s*Nc+c)*2+z] / scale);
+	    copy(field[(pad_idx * stride + x)*N + internal_idx % N], scale > 0.0 ? v[(s*Nc+c)*2+z] / scale : scale);
 	  else
 	    copy(field[(pad_idx * stride + x)*N + internal_idx % N], v[(s*Nc+c)*2+z]);
 	}
@@ -165,7 +249,11 @@ struct FloatNOrder {
     return field[(pad_idx * stride + x)*N + internal_idx % N];
   }
 
-  size_t Bytes() const { return volumeCB * Nc * Ns * 2 * sizeof(Float); }
+  size_t Bytes() const { 
+    size_t bytes = volumeCB * Nc * Ns * 2 * sizeof(Float);
+    if (sizeof(Float)==sizeof(short)) bytes += volumeCB * sizeof(float);
+    return bytes;
+  }
 };
 
 /**! float4 load specialization to obtain full coalescing. */
@@ -192,10 +280,12 @@ template <typename Float, int Ns, int Nc>
 struct SpaceColorSpinorOrder {
   typedef typename mapper<Float>::type RegType;
   Float *field;
+  float *norm;
   int volumeCB;
   int stride;
-  SpaceColorSpinorOrder(const ColorSpinorField &a, Float *field_=0) 
-  : field(field_ ? field_ : (Float*)a.V()), volumeCB(a.VolumeCB()), stride(a.Stride()) 
+  SpaceColorSpinorOrder(const ColorSpinorField &a, Float *field_=0, float *norm_=0) 
+  : field(field_ ? field_ : (Float*)a.V()), norm(norm_ ? norm_ : (float*)a.Norm()), 
+    volumeCB(a.VolumeCB()), stride(a.Stride()) 
   { if (volumeCB != stride) errorQuda("Stride must equal volume for this field order"); }
   virtual ~SpaceColorSpinorOrder() { ; }
 
@@ -204,7 +294,8 @@ struct SpaceColorSpinorOrder {
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  v[(s*Nc+c)*2+z] = field[((x*Nc + c)*Ns + s)*2 + z]; 
+	  copy(v[(s*Nc+c)*2+z], field[((x*Nc + c)*Ns + s)*2 + z]);
+	  if (sizeof(Float)==sizeof(short)) v[(s*Nc+c)*2+z] *= norm[x];
 	}
       }
     }
@@ -212,10 +303,19 @@ struct SpaceColorSpinorOrder {
 
   __device__ __host__ inline void save(const RegType v[Ns*Nc*2], int x) {
     if (x >= volumeCB) return;
+    RegType scale = 0.0;
+    if (sizeof(Float)==sizeof(short)) {
+      for (int i=0; i<2*Ns*Nc; i++) scale = fabs(v[i]) > scale ? fabs(v[i]) : scale;
+      norm[x] = scale;
+    }
+
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  field[((x*Nc + c)*Ns + s)*2 + z] = v[(s*Nc+c)*2+z];
+	  if (sizeof(Float)==sizeof(short))
+	    copy(field[((x*Nc + c)*Ns + s)*2 + z], scale > 0.0 ? v[(s*Nc+c)*2+z] / scale : scale);
+	  else
+	    field[((x*Nc + c)*Ns + s)*2 + z] = v[(s*Nc+c)*2+z];
 	}
       }
     }
@@ -342,10 +442,12 @@ template <typename Float, int Ns, int Nc>
 struct SpaceSpinorColorOrder {
   typedef typename mapper<Float>::type RegType;
   Float *field;
+  float *norm;
   int volumeCB;
   int stride;
-  SpaceSpinorColorOrder(const ColorSpinorField &a, Float *field_=0) 
-  : field(field_ ? field_ : (Float*)a.V()), volumeCB(a.VolumeCB()), stride(a.Stride())
+  SpaceSpinorColorOrder(const ColorSpinorField &a, Float *field_=0, float *norm_=0) 
+  : field(field_ ? field_ : (Float*)a.V()), norm(norm_ ? norm_ : (float*)a.Norm()), 
+    volumeCB(a.VolumeCB()), stride(a.Stride())
   { if (volumeCB != stride) errorQuda("Stride must equal volume for this field order"); }
   virtual ~SpaceSpinorColorOrder() { ; }
 
@@ -354,7 +456,8 @@ struct SpaceSpinorColorOrder {
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  v[(s*Nc+c)*2+z] = field[((x*Ns + s)*Nc + c)*2 + z];
+	  copy(v[(s*Nc+c)*2+z], field[((x*Ns + s)*Nc + c)*2 + z]);
+	  if (sizeof(Float)==sizeof(short)) v[(s*Nc+c)*2+z] *= norm[x];
 	}
       }
     }
@@ -362,10 +465,19 @@ struct SpaceSpinorColorOrder {
 
   __device__ __host__ inline void save(const RegType v[Ns*Nc*2], int x) {
     if (x >= volumeCB) return;
+    RegType scale = 0.0;
+    if (sizeof(Float)==sizeof(short)) {
+      for (int i=0; i<2*Ns*Nc; i++) scale = fabs(v[i]) > scale ? fabs(v[i]) : scale;
+      norm[x] = scale;
+    }
+
     for (int s=0; s<Ns; s++) {
       for (int c=0; c<Nc; c++) {
 	for (int z=0; z<2; z++) {
-	  field[((x*Ns + s)*Nc + c)*2 + z] = v[(s*Nc+c)*2+z];
+	  if (sizeof(Float)==sizeof(short))
+	    copy(field[((x*Ns + s)*Nc + c)*2 + z], scale > 0.0 ? v[(s*Nc+c)*2+z] / scale : scale);
+	  else
+	    field[((x*Ns + s)*Nc + c)*2 + z] = v[(s*Nc+c)*2+z];
 	}
       }
     }
@@ -384,6 +496,64 @@ struct SpaceSpinorColorOrder {
 };
 
 
+/**
+   AoSoA host order: sites are grouped in blocks of W, the number of
+   Float in QUDA_AOSOA_BLOCK_BYTES, and within a block the W values of
+   each complex spin-color component are adjacent, so that host loops
+   over the W sites of a block vectorize.
+*/
+template <typename Float, int Ns, int Nc>
+struct AoSoAOrder {
+  typedef typename mapper<Float>::type RegType;
+  static const int W = QUDA_AOSOA_BLOCK_BYTES / sizeof(Float);
+  Float *field;
+  int volumeCB;
+  int stride;
+  AoSoAOrder(const ColorSpinorField &a, Float *field_=0) 
+  : field(field_ ? field_ : (Float*)a.V()), volumeCB(a.VolumeCB()), stride(a.Stride())
+  { 
+    if (volumeCB != stride) errorQuda("Stride must equal volume for this field order"); 
+    if (volumeCB % W != 0) errorQuda("Volume %d is not a multiple of the SIMD width %d", volumeCB, W);
+  }
+  virtual ~AoSoAOrder() { ; }
+
+  __device__ __host__ inline int index(int x, int s, int c, int z) const {
+    return ((((x/W)*Ns + s)*Nc + c)*W + x%W)*2 + z;
+  }
+
+  __device__ __host__ inline void load(RegType v[Ns*Nc*2], int x) const {
+    if (x >= volumeCB) return;
+    for (int s=0; s<Ns; s++) {
+      for (int c=0; c<Nc; c++) {
+	for (int z=0; z<2; z++) {
+	  v[(s*Nc+c)*2+z] = field[index(x, s, c, z)];
+	}
+      }
+    }
+  }
+
+  __device__ __host__ inline void save(const RegType v[Ns*Nc*2], int x) {
+    if (x >= volumeCB) return;
+    for (int s=0; s<Ns; s++) {
+      for (int c=0; c<Nc; c++) {
+	for (int z=0; z<2; z++) {
+	  field[index(x, s, c, z)] = v[(s*Nc+c)*2+z];
+	}
+      }
+    }
+  }
+
+  __device__ __host__ const RegType& operator()(int x, int s, int c, int z) const {
+    return field[index(x, s, c, z)];
+  }
+
+  __device__ __host__ RegType& operator()(int x, int s, int c, int z) {
+    return field[index(x, s, c, z)];
+  }
+
+  size_t Bytes() const { return volumeCB * Nc * Ns * 2 * sizeof(Float); }
+};
+
 template <typename Float, int Ns, int Nc>
 struct QDPJITDiracOrder {
   typedef typename mapper<Float>::type RegType;
@@ -32,11 +32,40 @@ extern "C" {
   void comm_finalize(void);
   void comm_dim_partitioned_set(int dim);
   int comm_dim_partitioned(int dim);
+  double comm_auto_grid(int ndim, const int *lattice, int nranks, int ranks_per_node,
+			int *grid, int *node_block);
+
+
+  /* implemented in comm_profile.cpp */
+
+  typedef enum QudaCommProfileCollective_s {
+    QUDA_COMM_PROFILE_ALLREDUCE,
+    QUDA_COMM_PROFILE_ALLREDUCE_MAX,
+    QUDA_COMM_PROFILE_ALLREDUCE_ARRAY,
+    QUDA_COMM_PROFILE_ALLREDUCE_INT,
+    QUDA_COMM_PROFILE_BROADCAST,
+    QUDA_COMM_PROFILE_ALLGATHER,
+    QUDA_COMM_PROFILE_BARRIER,
+    QUDA_COMM_PROFILE_COLLECTIVE_COUNT
+  } QudaCommProfileCollective;
+
+  void comm_profile_init(void);
+  int comm_profile_enabled(void);
+  void comm_profile_declare(const MsgHandle *mh, const int displacement[], size_t nbytes, int send);
+  void comm_profile_start(const MsgHandle *mh);
+  void comm_profile_complete(const MsgHandle *mh, double wait);
+  void comm_profile_free(const MsgHandle *mh);
+  double comm_profile_time(void);
+  void comm_profile_collective(QudaCommProfileCollective type, size_t nbytes, double start);
+  void comm_profile_print(void);
 
 
   /* implemented in comm_single.cpp, comm_qmp.cpp, and comm_mpi.cpp */
 
   void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data);
+  int comm_world_size(void);
+  int comm_world_rank(void);
+  void comm_world_nodes(int *node_id);
   int comm_rank(void);
   int comm_size(void);
   int comm_gpuid(void);
@@ -51,7 +80,9 @@ extern "C" {
   void comm_allreduce_array(double* data, size_t size);
   void comm_allreduce_int(int* data);
   void comm_broadcast(void *data, size_t nbytes);
+  void comm_allgather(void *recv, const void *send, size_t nbytes);
   void comm_barrier(void);
+  void comm_release(void);
   void comm_abort(int status);
 
 #ifdef __cplusplus
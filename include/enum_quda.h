@@ -34,6 +34,7 @@ extern "C" {
     QUDA_CPS_WILSON_GAUGE_ORDER, // expect *gauge, even-odd, mu, spacetime, column-row color
     QUDA_MILC_GAUGE_ORDER, // expect *gauge, even-odd, mu, spacetime, row-column order
     QUDA_BQCD_GAUGE_ORDER, // expect *gauge, mu, even-odd, spacetime+halos, column-row order
+    QUDA_AOSOA_GAUGE_ORDER, // expect *gauge, even-odd, spacetime/W, mu, row-column, spacetime%W, complex
     QUDA_INVALID_GAUGE_ORDER = QUDA_INVALID_ENUM
   } QudaGaugeFieldOrder;
 
@@ -165,6 +166,7 @@ extern "C" {
     QUDA_QDPJIT_DIRAC_ORDER,     // even-odd, complex-color-spin-spacetime
     QUDA_CPS_WILSON_DIRAC_ORDER, // odd-even, color inside spin
     QUDA_LEX_DIRAC_ORDER,        // lexicographical order, color inside spin
+    QUDA_AOSOA_DIRAC_ORDER,      // even-odd, W sites interleaved per spin-color component
     QUDA_INVALID_DIRAC_ORDER = QUDA_INVALID_ENUM
   } QudaDiracFieldOrder;  
 
@@ -245,6 +247,7 @@ extern "C" {
     QUDA_LEXICOGRAPHIC_SITE_ORDER, // lexicographic ordering
     QUDA_EVEN_ODD_SITE_ORDER, // QUDA and QDP use this
     QUDA_ODD_EVEN_SITE_ORDER, // CPS uses this
+    QUDA_MORTON_SITE_ORDER, // even-odd, each parity along a 4-d Morton curve (host only)
     QUDA_INVALID_SITE_ORDER = QUDA_INVALID_ENUM
   } QudaSiteOrder;
   
@@ -257,6 +260,7 @@ extern "C" {
     QUDA_SPACE_COLOR_SPIN_FIELD_ORDER, // QLA ordering (spin inside color)
     QUDA_QDPJIT_FIELD_ORDER, // QDP field ordering (complex-color-spin-spacetime)
     QUDA_QOP_DOMAIN_WALL_FIELD_ORDER, // QOP domain-wall ordering
+    QUDA_AOSOA_FIELD_ORDER, // space/W-spin-color-space%W-complex, W sites per QUDA_AOSOA_BLOCK_BYTES block
     QUDA_INVALID_FIELD_ORDER = QUDA_INVALID_ENUM
   } QudaFieldOrder;
   
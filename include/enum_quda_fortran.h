@@ -36,6 +36,7 @@
 #define QUDA_CPS_WILSON_GAUGE_ORDER 7 //expect *gauge even-odd spacetime column-row color
 #define QUDA_MILC_GAUGE_ORDER 8 //expect *gauge even-odd mu spacetime row-column order
 #define QUDA_BQCD_GAUGE_ORDER 9 //expect *gauge mu even-odd spacetime row-column order
+#define QUDA_AOSOA_GAUGE_ORDER 10 //expect *gauge even-odd spacetime/W mu row-column spacetime%W complex
 #define QUDA_INVALID_GAUGE_ORDER QUDA_INVALID_ENUM
 
 #define QudaTboundary integer(4)
@@ -151,6 +152,7 @@
 #define QUDA_QDPJIT_DIRAC_ORDER 3       // even-odd spin inside color
 #define QUDA_CPS_WILSON_DIRAC_ORDER 4// odd-even color inside spin
 #define QUDA_LEX_DIRAC_ORDER 5       // lexicographical order color inside spin
+#define QUDA_AOSOA_DIRAC_ORDER 6     // even-odd W sites interleaved per spin-color component
 #define QUDA_INVALID_DIRAC_ORDER QUDA_INVALID_ENUM
 
 #define QudaCloverFieldOrder integer(4)
@@ -218,6 +220,7 @@
 #define QUDA_LEXICOGRAPHIC_SITE_ORDER 0 // lexicographic ordering
 #define QUDA_EVEN_ODD_SITE_ORDER 1 // QUDA and QDP use this
 #define QUDA_ODD_EVEN_SITE_ORDER 2 // CPS uses this
+#define QUDA_MORTON_SITE_ORDER 3 // even-odd, each parity along a 4-d Morton curve (host only)
 #define QUDA_INVALID_SITE_ORDER QUDA_INVALID_ENUM
   
 ! Degree of freedom ordering
@@ -229,6 +232,7 @@
 #define QUDA_SPACE_COLOR_SPIN_FIELD_ORDER 6 // QLA ordering (spin inside color)
 #define QUDA_QDPJIT_FIELD_ORDER 7 // QDP field ordering (complex-color-spin-spacetime)
 #define QUDA_QOP_DOMAIN_WALL_FIELD_ORDER 8 // QOP domain-wall ordering
+#define QUDA_AOSOA_FIELD_ORDER 9 // space/W-spin-color-space%W-complex, W sites per QUDA_AOSOA_BLOCK_BYTES block
 #define QUDA_INVALID_FIELD_ORDER QUDA_INVALID_ENUM
   
 #define QudaFieldCreate integer(4)
@@ -0,0 +1,292 @@
+#ifndef _EXTENDED_LINKS_QUDA_H
+#define _EXTENDED_LINKS_QUDA_H
+
+#include <string.h>
+#include <complex>
+#include <vector>
+
+#include <gauge_field_order.h>
+#include <host_thread_quda.h>
+#include <face_quda.h>
+
+/**
+ * Host gauge links padded by a halo, shared by the host link
+ * fattening (llfat_host.cu) and the host gauge observables
+ * (gauge_observables.cu).  The local links are copied, through the
+ * gauge_field_order.h accessors, into a lexicographically ordered
+ * field (x fastest) extended by R = 2 sites in every dimension, with
+ * the four links of each site contiguous.  On multi-rank runs the halo
+ * is filled by exchange_cpu_sitelink_ex(), otherwise by periodic
+ * wrapping of the local volume.  The fills are threaded over (z,t)
+ * planes.
+ */
+
+namespace quda {
+
+  /** An SU(3) link, as 9 complex numbers in row-major order */
+  template <typename Float>
+    struct Link {
+      Float v[18];
+    };
+
+  // c = a b
+  template <typename Float>
+    inline void mult_nn(Link<Float> &c, const Link<Float> &a, const Link<Float> &b) {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	Float re = 0, im = 0;
+	for (int k=0; k<3; k++) {
+	  const Float *x = a.v + 2*(3*i+k), *y = b.v + 2*(3*k+j);
+	  re += x[0]*y[0] - x[1]*y[1];
+	  im += x[0]*y[1] + x[1]*y[0];
+	}
+	c.v[2*(3*i+j)+0] = re;
+	c.v[2*(3*i+j)+1] = im;
+      }
+    }
+  }
+
+  // c = a b^dag
+  template <typename Float>
+    inline void mult_na(Link<Float> &c, const Link<Float> &a, const Link<Float> &b) {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	Float re = 0, im = 0;
+	for (int k=0; k<3; k++) {
+	  const Float *x = a.v + 2*(3*i+k), *y = b.v + 2*(3*j+k);
+	  re += x[0]*y[0] + x[1]*y[1];
+	  im += x[1]*y[0] - x[0]*y[1];
+	}
+	c.v[2*(3*i+j)+0] = re;
+	c.v[2*(3*i+j)+1] = im;
+      }
+    }
+  }
+
+  // c = a^dag b
+  template <typename Float>
+    inline void mult_an(Link<Float> &c, const Link<Float> &a, const Link<Float> &b) {
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	Float re = 0, im = 0;
+	for (int k=0; k<3; k++) {
+	  const Float *x = a.v + 2*(3*k+i), *y = b.v + 2*(3*k+j);
+	  re += x[0]*y[0] + x[1]*y[1];
+	  im += x[0]*y[1] - x[1]*y[0];
+	}
+	c.v[2*(3*i+j)+0] = re;
+	c.v[2*(3*i+j)+1] = im;
+      }
+    }
+  }
+
+  // c += s a
+  template <typename Float>
+    inline void axpy(Link<Float> &c, Float s, const Link<Float> &a) {
+    for (int i=0; i<18; i++) c.v[i] += s*a.v[i];
+  }
+
+  template <typename Float>
+    inline Link<Float> operator*(const Link<Float> &a, const Link<Float> &b) {
+    Link<Float> c;
+    mult_nn(c, a, b);
+    return c;
+  }
+
+  template <typename Float>
+    inline Link<Float> operator+(const Link<Float> &a, const Link<Float> &b) {
+    Link<Float> c;
+    for (int i=0; i<18; i++) c.v[i] = a.v[i] + b.v[i];
+    return c;
+  }
+
+  template <typename Float>
+    inline Link<Float> dagger(const Link<Float> &a) {
+    Link<Float> c;
+    for (int i=0; i<3; i++) {
+      for (int j=0; j<3; j++) {
+	c.v[2*(3*i+j)+0] = a.v[2*(3*j+i)+0];
+	c.v[2*(3*i+j)+1] = -a.v[2*(3*j+i)+1];
+      }
+    }
+    return c;
+  }
+
+  template <typename Float>
+    inline std::complex<double> trace(const Link<Float> &a) {
+    return std::complex<double>(a.v[0] + a.v[8] + a.v[16], a.v[1] + a.v[9] + a.v[17]);
+  }
+
+  /** Re tr(a b) without forming the product */
+  template <typename Float>
+    inline double reTraceProduct(const Link<Float> &a, const Link<Float> &b) {
+    double sum = 0.0;
+    for (int i=0; i<3; i++) {
+      for (int k=0; k<3; k++) {
+	const Float *x = a.v + 2*(3*i+k), *y = b.v + 2*(3*k+i);
+	sum += x[0]*y[0] - x[1]*y[1];
+      }
+    }
+    return sum;
+  }
+
+  /** Local links with a halo of depth R in every dimension */
+  template <typename Float>
+    struct ExtendedLinks {
+      static const int R = 2;
+      int X[4];      // local dimensions
+      int E[4];      // extended dimensions
+      int stride[4]; // site stride of each dimension
+      int volume;    // extended volume
+      std::vector<Link<Float> > links;
+
+      ExtendedLinks(const int *X_) {
+	volume = 1;
+	for (int d=0; d<4; d++) {
+	  X[d] = X_[d];
+	  if (X[d] < R) errorQuda("Local dimension X[%d]=%d smaller than the halo depth %d", d, X[d], R);
+	  E[d] = X[d] + 2*R;
+	  stride[d] = volume;
+	  volume *= E[d];
+	}
+	links.resize(4*(size_t)volume);
+      }
+
+      /** extended index of local site (x,y,z,t) */
+      int index(int x, int y, int z, int t) const {
+	return (((t+R)*E[2] + z+R)*E[1] + y+R)*E[0] + x+R;
+      }
+
+      const Link<Float>& link(int s, int dir) const { return links[4*(size_t)s + dir]; }
+    };
+
+  /**
+     Raw QDP-ordered field of the extended volume, the layout filled
+     by exchange_cpu_sitelink_ex(), with the accessor interface of
+     gauge_field_order.h.
+  */
+  template <typename Float>
+    struct ExtendedQDPOrder {
+      Float **gauge;
+      const int volumeCB;
+      ExtendedQDPOrder(Float **gauge, int volumeCB) : gauge(gauge), volumeCB(volumeCB) { }
+      template <typename RegType> void load(RegType v[18], int x, int dir, int parity) const {
+	const Float *u = gauge[dir] + ((size_t)parity*volumeCB + x)*18;
+	for (int i=0; i<18; i++) v[i] = u[i];
+      }
+      template <typename RegType> void save(const RegType v[18], int x, int dir, int parity) {
+	Float *u = gauge[dir] + ((size_t)parity*volumeCB + x)*18;
+	for (int i=0; i<18; i++) u[i] = v[i];
+      }
+    };
+
+  /**
+     Copy the links into the extended field, one (z,t) plane of the
+     extended volume per work item.  If periodic is set, the order
+     holds the local volume and the halo is filled by periodic
+     wrapping, otherwise the order itself holds the extended volume.
+  */
+  template <typename Float, typename Order>
+    struct FillExtended {
+      const Order &order;
+      ExtendedLinks<Float> &ext;
+      const bool periodic;
+
+      FillExtended(const Order &order, ExtendedLinks<Float> &ext, bool periodic)
+	: order(order), ext(ext), periodic(periodic) { }
+
+      void operator()(int zt) const {
+	typedef typename mapper<Float>::type RegType;
+	const int *X = ext.X, *E = ext.E, R = ext.R;
+	const int *D = periodic ? X : E;
+	int c[4], x[4];
+	c[2] = zt % E[2];
+	c[3] = zt / E[2];
+	for (c[1]=0; c[1]<E[1]; c[1]++) {
+	  for (c[0]=0; c[0]<E[0]; c[0]++) {
+	    for (int d=0; d<4; d++) x[d] = periodic ? (c[d] - R + X[d]) % X[d] : c[d];
+	    const int idx = ((x[3]*D[2] + x[2])*D[1] + x[1])*D[0] + x[0];
+	    const int parity = (x[0] + x[1] + x[2] + x[3]) & 1;
+	    const int s = ((c[3]*E[2] + c[2])*E[1] + c[1])*E[0] + c[0];
+	    for (int dir=0; dir<4; dir++) {
+	      RegType v[18];
+	      order.load(v, idx >> 1, dir, parity);
+	      for (int i=0; i<18; i++) ext.links[4*(size_t)s + dir].v[i] = v[i];
+	    }
+	  }
+	}
+      }
+    };
+
+  /** Copy the local links into the interior of an extended QDP-ordered field */
+  template <typename Float, typename Order>
+    struct FillInterior {
+      const Order &order;
+      ExtendedQDPOrder<Float> &out;
+      const int *X;
+      const int R;
+
+      FillInterior(const Order &order, ExtendedQDPOrder<Float> &out, const int *X, int R)
+	: order(order), out(out), X(X), R(R) { }
+
+      void operator()(int zt) const {
+	typedef typename mapper<Float>::type RegType;
+	const int E[4] = { X[0]+2*R, X[1]+2*R, X[2]+2*R, X[3]+2*R };
+	const int z = zt % X[2], t = zt / X[2];
+	for (int y=0; y<X[1]; y++) {
+	  for (int x=0; x<X[0]; x++) {
+	    const int idx = ((t*X[2] + z)*X[1] + y)*X[0] + x;
+	    const int idx_ex = (((t+R)*E[2] + z+R)*E[1] + y+R)*E[0] + x+R;
+	    const int parity = (x + y + z + t) & 1; // unchanged by the even halo depth
+	    for (int dir=0; dir<4; dir++) {
+	      RegType v[18];
+	      order.load(v, idx >> 1, dir, parity);
+	      out.save(v, idx_ex >> 1, dir, parity);
+	    }
+	  }
+	}
+      }
+    };
+
+  template <typename Float, typename Order>
+    void fillExtended(ExtendedLinks<Float> &ext, const Order &order, bool periodic) {
+    FillExtended<Float,Order> fill(order, ext, periodic);
+    hostParallelFor(ext.E[2]*ext.E[3], fill, hostThreadCount());
+  }
+
+  /**
+     Fill the extended field from the links of u, read through order.
+     An extended input field (extended set, u holding the extended
+     volume in a QDP or MILC order) only needs its halo exchanged.  The
+     local links of a standard field are either copied with periodic
+     wrapping or, on multi-rank runs, first embedded in an extended
+     QDP-ordered field of precision Float whose halo is exchanged.
+  */
+  template <typename Float, typename Order>
+    void loadExtended(ExtendedLinks<Float> &ext, const GaugeField &u, const Order &order, bool extended) {
+#ifdef MULTI_GPU
+    int R[4] = { ext.R, ext.R, ext.R, ext.R };
+    if (extended) {
+      exchange_cpu_sitelink_ex(ext.X, R, (void**)u.Gauge_p(), u.Order(), u.Precision(), 0);
+      fillExtended(ext, order, false);
+    } else {
+      const QudaPrecision precision = sizeof(Float) == sizeof(double) ? QUDA_DOUBLE_PRECISION : QUDA_SINGLE_PRECISION;
+      Float *gauge[4];
+      for (int d=0; d<4; d++) gauge[d] = (Float*)safe_malloc((size_t)ext.volume*18*sizeof(Float));
+      ExtendedQDPOrder<Float> qdp(gauge, ext.volume/2);
+
+      FillInterior<Float,Order> fill(order, qdp, ext.X, ext.R);
+      hostParallelFor(ext.X[2]*ext.X[3], fill, hostThreadCount());
+      exchange_cpu_sitelink_ex(ext.X, R, (void**)gauge, QUDA_QDP_GAUGE_ORDER, precision, 0);
+      fillExtended(ext, qdp, false);
+
+      for (int d=0; d<4; d++) host_free(gauge[d]);
+    }
+#else
+    fillExtended(ext, order, !extended);
+#endif
+  }
+
+} // namespace quda
+
+#endif // _EXTENDED_LINKS_QUDA_H
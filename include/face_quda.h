@@ -44,6 +44,13 @@ namespace quda {
     MsgHandle* mh_recv_back[QUDA_MAX_DIM];
     MsgHandle* mh_send_fwd[QUDA_MAX_DIM];
     MsgHandle* mh_send_back[QUDA_MAX_DIM];
+
+    // When the forwards and backwards neighbours in a dimension are the
+    // same rank (a dimension partitioned over two ranks), both faces are
+    // sent as a single message from contiguous buffers
+    bool aggregate[QUDA_MAX_DIM];
+    int facesReady[QUDA_MAX_DIM]; // number of faces gathered in an aggregated dimension
+    bool aggregateDone[QUDA_MAX_DIM]; // aggregated message has completed
    
     int Ninternal; // number of internal degrees of freedom (12 for spin projected Wilson, 6 for staggered)
     QudaPrecision precision;
@@ -57,8 +64,19 @@ namespace quda {
     int nDimComms; // the number of dimensions in which we communicate
     int nFace;
     size_t nbytes[QUDA_MAX_DIM];
+
+    QudaPrecision commsPrecision; // precision of the halo on the wire
+    size_t commsBytes[QUDA_MAX_DIM]; // bytes per face on the wire
+    bool staging; // do we use network buffers separate from the gathered faces?
+
+    // halo precision and ghost compression applied to newly created FaceBuffers
+    static QudaPrecision haloPrecision;
+    static bool ghostCompression;
     
     void setupDims(const int *X, int Ls);
+
+    void packComms(void *ib_buffer, const void *face, int dim);
+    void unpackComms(void *face, const void *ib_buffer, int dim);
     
     void *allocatePinned(size_t nbytes);
     void freePinned(void *ptr);
@@ -103,6 +121,32 @@ namespace quda {
     void exchangeLink(void** ghost_link, void** link_sendbuf, QudaFieldLocation location);
     
     static void flushPinnedCache();
+
+    /**
+       Set the precision in which spinor halos are exchanged by
+       subsequently created FaceBuffers.  Faces are converted on the
+       host before sending and expanded on receipt; half precision
+       uses a per-site norm.
+       @param precision Halo precision (QUDA_INVALID_PRECISION for native)
+     */
+    static void setHaloPrecision(QudaPrecision precision);
+
+    /**
+       Enable lossless byte-plane compression of host gauge ghost exchanges
+     */
+    static void setGhostCompression(bool compress);
+    static bool GhostCompression();
+
+    /**
+       Compressed blocking exchange of a host buffer with the neighbours in dimension dim
+       @param recv Buffer receiving the message from the neighbour in direction -dir
+       @param send Buffer sent to the neighbour in direction dir
+       @param dim Dimension of the exchange
+       @param dir Direction of the send (+1 or -1)
+       @param bytes Uncompressed size of the message
+       @param word Size of the elements (used to form byte planes)
+     */
+    static void exchangeCompressed(void *recv, void *send, int dim, int dir, size_t bytes, size_t word);
   };
 }
   
@@ -193,6 +193,9 @@ namespace quda {
     void destroyTexObject();
 #endif
 
+    bool streamable(const cpuGaugeField &cpu) const;
+    void copySlabs(const cpuGaugeField &cpu);
+
   public:
     cudaGaugeField(const GaugeFieldParam &);
     virtual ~cudaGaugeField();
@@ -245,6 +248,14 @@ namespace quda {
 
     void exchangeGhost();
 
+    /**
+       Copy the links and ghost zone of src into this field, converting
+       the order and precision, e.g., to keep a field in half precision
+       on the host.
+       @param src The field we are copying from (cpu or cuda)
+    */
+    void copy(const GaugeField &src);
+
     void* Gauge_p() { return gauge; }
     const void* Gauge_p() const { return gauge; }
     void setGauge(void** _gauge); //only allowed when create== QUDA_REFERENCE_FIELD_CREATE
@@ -273,6 +284,21 @@ namespace quda {
   // this is the function that is actually called, from here on down we instantiate all required templates
   void copyGenericGauge(GaugeField &out, const GaugeField &in, QudaFieldLocation location, 
 			void *Out=0, void *In=0, void **ghostOut=0, void **ghostIn=0, int type=0);
+
+  /**
+     This function reorders one slab of sites of a host gauge field
+     into a staging buffer in the native order of a device field, so
+     that the field can be transferred in pieces.  Defined in
+     copy_gauge.cu.
+     @param out The device field whose order, reconstruction and precision are used
+     @param in The host field from which we are copying
+     @param Out The staging buffer, holding volumeCB sites per parity at stride volumeCB
+     @param In The input buffer (optional)
+     @param offset The first checkerboard site of the slab
+     @param volumeCB The number of checkerboard sites in the slab
+  */
+  void copyGenericGaugeSlab(GaugeField &out, const GaugeField &in, void *Out, void *In,
+			    int offset, int volumeCB);
   /**
      This function is used for  extracting the gauge ghost zone from a
      gauge field array.  Defined in extract_gauge_ghost.cu.
@@ -289,6 +315,16 @@ namespace quda {
   */
   double maxGauge(const GaugeField &u);
 
+  /**
+     This function computes the plaquette, rectangle, Polyakov loop
+     and topological charge of a host gauge field, as described for
+     gaugeObservablesQuda().  Defined in gauge_observables.cu.
+
+     @param obs The computed observables
+     @param u The host gauge field
+  */
+  void gaugeObservables(QudaGaugeObservableParam &obs, const cpuGaugeField &u);
+
 } // namespace quda
 
 
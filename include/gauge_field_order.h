@@ -355,6 +355,26 @@ namespace quda {
           }
         }
 
+      /**
+	 Constructor for a buffer holding volumeCB sites of u per parity,
+	 with the given stride and the odd parity following the 4 even
+	 dimensions, e.g., one slab of sites of u staged for a transfer.
+	 No ghost zone or phases are stored.
+      */
+      FloatNOrder(const GaugeField &u, Float *gauge_, int volumeCB, int stride)
+      : reconstruct(u), volumeCB(volumeCB), stride(stride)
+#if __COMPUTE_CAPABILITY__ >= 200
+	, hasPhase(0), phaseOffset(0)
+#endif
+      {
+	gauge[0] = gauge_;
+	gauge[1] = gauge_ + 4*stride*reconLen;
+	for (int i=0; i<4; i++) {
+	  ghost[i] = 0;
+	  faceVolumeCB[i] = u.SurfaceCB(i)*u.Nface();
+	}
+      }
+
       FloatNOrder(const FloatNOrder &order) 
       : reconstruct(order.reconstruct), volumeCB(order.volumeCB), stride(order.stride)
 #if __COMPUTE_CAPABILITY__ >= 200
@@ -464,28 +484,45 @@ namespace quda {
 }
 
 
+#if __COMPUTE_CAPABILITY__ >= 200
+size_t Bytes() const { return (reconLen + hasPhase) * sizeof(Float); }
+#else
 size_t Bytes() const { return reconLen * sizeof(Float); }
+#endif
 };
 
 /** 
   The LegacyOrder defines the ghost zone storage and ordering for
   all cpuGaugeFields, which use the same ghost zone storage.
+
+  Half precision host links are stored as 16-bit fixed-point
+  fractions of a scale, as on the device: the link max for fat links
+  and unity otherwise.  The orders convert every element with
+  unpack() and pack().
+
+  The QDP, MILC and AoSoA orders, and the ghost zone, may store each
+  link compressed to reconLen reals (12 or 8), which are
+  reconstructed with the same Reconstruct as the FloatN orders on
+  every load.
   */
-template <typename Float, int length> 
+template <typename Float, int length, int reconLen=length> 
 struct LegacyOrder {
   typedef typename mapper<Float>::type RegType;
+  Reconstruct<reconLen,Float> reconstruct;
   Float *ghost[QUDA_MAX_DIM];
   int faceVolumeCB[QUDA_MAX_DIM];
   const int volumeCB;
   const int stride;
   const int hasPhase;
-LegacyOrder(const GaugeField &u, Float **ghost_) : volumeCB(u.VolumeCB()), stride(u.Stride()), hasPhase(0) {
+  const RegType scale;
+LegacyOrder(const GaugeField &u, Float **ghost_) : reconstruct(u), volumeCB(u.VolumeCB()), stride(u.Stride()), hasPhase(0),
+    scale((u.LinkType() == QUDA_ASQTAD_FAT_LINKS && u.LinkMax() > 0.0) ? u.LinkMax() : 1.0) {
     for (int i=0; i<4; i++) {
       ghost[i] = (ghost_) ? ghost_[i] : (Float*)(u.Ghost()[i]);
       faceVolumeCB[i] = u.SurfaceCB(i)*u.Nface(); // face volume equals surface * depth
     }
   }
-LegacyOrder(const LegacyOrder &order) : volumeCB(order.volumeCB), stride(order.stride), hasPhase(0) {
+LegacyOrder(const LegacyOrder &order) : reconstruct(order.reconstruct), volumeCB(order.volumeCB), stride(order.stride), hasPhase(0), scale(order.scale) {
     for (int i=0; i<4; i++) {
       ghost[i] = order.ghost[i];
       faceVolumeCB[i] = order.faceVolumeCB[i];
@@ -493,12 +530,28 @@ LegacyOrder(const LegacyOrder &order) : volumeCB(order.volumeCB), stride(order.s
   }
   virtual ~LegacyOrder() { ; }
 
+  __device__ __host__ inline RegType unpack(const Float &a) const {
+    RegType v;
+    copy(v, a);
+    return (sizeof(Float)==sizeof(short)) ? v*scale : v;
+  }
+
+  __device__ __host__ inline Float pack(const RegType &v) const {
+    Float a;
+    copy(a, (sizeof(Float)==sizeof(short)) ? v/scale : v);
+    return a;
+  }
+
   __device__ __host__ inline void loadGhost(RegType v[length], int x, int dir, int parity) const {
-    for (int i=0; i<length; i++) v[i] = ghost[dir][(parity*faceVolumeCB[dir] + x)*length + i];
+    RegType tmp[reconLen];
+    for (int i=0; i<reconLen; i++) tmp[i] = unpack(ghost[dir][(parity*faceVolumeCB[dir] + x)*reconLen + i]);
+    reconstruct.Unpack(v, tmp, x, dir, 0);
   }
 
   __device__ __host__ inline void saveGhost(const RegType v[length], int x, int dir, int parity) {
-    for (int i=0; i<length; i++) ghost[dir][(parity*faceVolumeCB[dir] + x)*length + i] = v[i];
+    RegType tmp[reconLen];
+    reconstruct.Pack(tmp, v, x);
+    for (int i=0; i<reconLen; i++) ghost[dir][(parity*faceVolumeCB[dir] + x)*reconLen + i] = pack(tmp[i]);
   }
 };
 
@@ -506,31 +559,35 @@ LegacyOrder(const LegacyOrder &order) : volumeCB(order.volumeCB), stride(order.s
   struct to define QDP ordered gauge fields: 
   [[dim]] [[parity][volumecb][row][col]]
   */
-template <typename Float, int length> struct QDPOrder : public LegacyOrder<Float,length> {
+template <typename Float, int length, int reconLen=length> struct QDPOrder : public LegacyOrder<Float,length,reconLen> {
   typedef typename mapper<Float>::type RegType;
   Float *gauge[QUDA_MAX_DIM];
   const int volumeCB;
   QDPOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) 
-    : LegacyOrder<Float,length>(u, ghost_), volumeCB(u.VolumeCB())
+    : LegacyOrder<Float,length,reconLen>(u, ghost_), volumeCB(u.VolumeCB())
   { for (int i=0; i<4; i++) gauge[i] = gauge_ ? ((Float**)gauge_)[i] : ((Float**)u.Gauge_p())[i]; }
-  QDPOrder(const QDPOrder &order) : LegacyOrder<Float,length>(order), volumeCB(order.volumeCB) {
+  QDPOrder(const QDPOrder &order) : LegacyOrder<Float,length,reconLen>(order), volumeCB(order.volumeCB) {
     for(int i=0; i<4; i++) gauge[i] = order.gauge[i];
   }
   virtual ~QDPOrder() { ; }
 
   __device__ __host__ inline void load(RegType v[length], int x, int dir, int parity) const {
-    for (int i=0; i<length; i++) {
-      v[i] = (RegType)gauge[dir][(parity*volumeCB + x)*length + i];
+    RegType tmp[reconLen];
+    for (int i=0; i<reconLen; i++) {
+      tmp[i] = this->unpack(gauge[dir][(parity*volumeCB + x)*reconLen + i]);
     }
+    this->reconstruct.Unpack(v, tmp, x, dir, 0);
   }
 
   __device__ __host__ inline void save(const RegType v[length], int x, int dir, int parity) {
-    for (int i=0; i<length; i++) {
-      gauge[dir][(parity*volumeCB + x)*length + i] = (Float)v[i];
+    RegType tmp[reconLen];
+    this->reconstruct.Pack(tmp, v, x);
+    for (int i=0; i<reconLen; i++) {
+      gauge[dir][(parity*volumeCB + x)*reconLen + i] = this->pack(tmp[i]);
     }
   }
 
-  size_t Bytes() const { return length * sizeof(Float); }
+  size_t Bytes() const { return reconLen * sizeof(Float); }
 };
 
 /**
@@ -553,7 +610,7 @@ template <typename Float, int length> struct QDPJITOrder : public LegacyOrder<Fl
     for (int i=0; i<length; i++) {
       int z = i%2;
       int rolcol = i/2;
-      v[i] = (RegType)gauge[dir][((z*(length/2) + rolcol)*2 + parity)*volumeCB + x];
+      v[i] = this->unpack(gauge[dir][((z*(length/2) + rolcol)*2 + parity)*volumeCB + x]);
     }
   }
 
@@ -561,7 +618,7 @@ template <typename Float, int length> struct QDPJITOrder : public LegacyOrder<Fl
     for (int i=0; i<length; i++) {
       int z = i%2;
       int rolcol = i/2;
-      gauge[dir][((z*(length/2) + rolcol)*2 + parity)*volumeCB + x] = (Float)v[i];
+      gauge[dir][((z*(length/2) + rolcol)*2 + parity)*volumeCB + x] = this->pack(v[i]);
     }
   }
 
@@ -572,29 +629,69 @@ template <typename Float, int length> struct QDPJITOrder : public LegacyOrder<Fl
   struct to define MILC ordered gauge fields: 
   [parity][dim][volumecb][row][col]
   */
-template <typename Float, int length> struct MILCOrder : public LegacyOrder<Float,length> {
+template <typename Float, int length, int reconLen=length> struct MILCOrder : public LegacyOrder<Float,length,reconLen> {
   typedef typename mapper<Float>::type RegType;
   Float *gauge;
   const int volumeCB;
   MILCOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) : 
-    LegacyOrder<Float,length>(u, ghost_), gauge(gauge_ ? gauge_ : (Float*)u.Gauge_p()), volumeCB(u.VolumeCB()) { ; }
-  MILCOrder(const MILCOrder &order) : LegacyOrder<Float,length>(order), gauge(order.gauge), volumeCB(order.volumeCB)
+    LegacyOrder<Float,length,reconLen>(u, ghost_), gauge(gauge_ ? gauge_ : (Float*)u.Gauge_p()), volumeCB(u.VolumeCB()) { ; }
+  MILCOrder(const MILCOrder &order) : LegacyOrder<Float,length,reconLen>(order), gauge(order.gauge), volumeCB(order.volumeCB)
   { ; }
   virtual ~MILCOrder() { ; }
 
   __device__ __host__ inline void load(RegType v[length], int x, int dir, int parity) const {
-    for (int i=0; i<length; i++) {
-      v[i] = (RegType)gauge[((parity*volumeCB+x)*4 + dir)*length + i];
+    RegType tmp[reconLen];
+    for (int i=0; i<reconLen; i++) {
+      tmp[i] = this->unpack(gauge[((parity*volumeCB+x)*4 + dir)*reconLen + i]);
     }
+    this->reconstruct.Unpack(v, tmp, x, dir, 0);
   }
 
   __device__ __host__ inline void save(const RegType v[length], int x, int dir, int parity) {
-    for (int i=0; i<length; i++) {
-      gauge[((parity*volumeCB+x)*4 + dir)*length + i] = (Float)v[i];
+    RegType tmp[reconLen];
+    this->reconstruct.Pack(tmp, v, x);
+    for (int i=0; i<reconLen; i++) {
+      gauge[((parity*volumeCB+x)*4 + dir)*reconLen + i] = this->pack(tmp[i]);
     }
   }
 
-  size_t Bytes() const { return length * sizeof(Float); }
+  size_t Bytes() const { return reconLen * sizeof(Float); }
+};
+
+/**
+  struct to define AoSoA ordered host gauge fields, where W is the
+  number of Float in QUDA_AOSOA_BLOCK_BYTES:
+  [parity][volumecb/W][dim][row][col][volumecb%W][complex]
+  */
+template <typename Float, int length, int reconLen=length> struct AoSoAOrder : public LegacyOrder<Float,length,reconLen> {
+  typedef typename mapper<Float>::type RegType;
+  static const int W = QUDA_AOSOA_BLOCK_BYTES / sizeof(Float);
+  Float *gauge;
+  const int volumeCB;
+  AoSoAOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) : 
+    LegacyOrder<Float,length,reconLen>(u, ghost_), gauge(gauge_ ? gauge_ : (Float*)u.Gauge_p()), volumeCB(u.VolumeCB())
+  { if (volumeCB % W != 0) errorQuda("Volume %d is not a multiple of the SIMD width %d", volumeCB, W); }
+  AoSoAOrder(const AoSoAOrder &order) : LegacyOrder<Float,length,reconLen>(order), gauge(order.gauge), volumeCB(order.volumeCB)
+  { ; }
+  virtual ~AoSoAOrder() { ; }
+
+  __device__ __host__ inline int index(int x, int dir, int parity, int i) const {
+    return ((((parity*(volumeCB/W) + x/W)*4 + dir)*(reconLen/2) + i/2)*W + x%W)*2 + i%2;
+  }
+
+  __device__ __host__ inline void load(RegType v[length], int x, int dir, int parity) const {
+    RegType tmp[reconLen];
+    for (int i=0; i<reconLen; i++) tmp[i] = this->unpack(gauge[index(x, dir, parity, i)]);
+    this->reconstruct.Unpack(v, tmp, x, dir, 0);
+  }
+
+  __device__ __host__ inline void save(const RegType v[length], int x, int dir, int parity) {
+    RegType tmp[reconLen];
+    this->reconstruct.Pack(tmp, v, x);
+    for (int i=0; i<reconLen; i++) gauge[index(x, dir, parity, i)] = this->pack(tmp[i]);
+  }
+
+  size_t Bytes() const { return reconLen * sizeof(Float); }
 };
 
 /**
@@ -605,7 +702,7 @@ template <typename Float, int length> struct CPSOrder : LegacyOrder<Float,length
   typedef typename mapper<Float>::type RegType;
   Float *gauge;
   const int volumeCB;
-  const Float anisotropy;
+  const RegType anisotropy;
   const int Nc;
   CPSOrder(const GaugeField &u, Float *gauge_=0, Float **ghost_=0) 
     : LegacyOrder<Float,length>(u, ghost_), gauge(gauge_ ? gauge_ : (Float*)u.Gauge_p()), volumeCB(u.VolumeCB()), anisotropy(u.Anisotropy()), Nc(3) 
@@ -621,7 +718,7 @@ template <typename Float, int length> struct CPSOrder : LegacyOrder<Float,length
       for (int j=0; j<Nc; j++) {
         for (int z=0; z<2; z++) {
           v[(i*Nc+j)*2+z] = 
-            (RegType)(gauge[((((parity*volumeCB+x)*4 + dir)*Nc + j)*Nc + i)*2 + z] / anisotropy);
+            this->unpack(gauge[((((parity*volumeCB+x)*4 + dir)*Nc + j)*Nc + i)*2 + z]) / anisotropy;
         }
       }
     }
@@ -632,7 +729,7 @@ template <typename Float, int length> struct CPSOrder : LegacyOrder<Float,length
       for (int j=0; j<Nc; j++) {
         for (int z=0; z<2; z++) {
           gauge[((((parity*volumeCB+x)*4 + dir)*Nc + j)*Nc + i)*2 + z] = 
-            (Float)(anisotropy * v[(i*Nc+j)*2+z]);
+            this->pack(anisotropy * v[(i*Nc+j)*2+z]);
         }
       }
     }
@@ -670,7 +767,7 @@ template <typename Float, int length> struct BQCDOrder : LegacyOrder<Float,lengt
     for (int i=0; i<Nc; i++) {
       for (int j=0; j<Nc; j++) {
         for (int z=0; z<2; z++) {
-          v[(i*Nc+j)*2+z] = (RegType)gauge[((((dir*2+parity)*exVolumeCB + x)*Nc + j)*Nc + i)*2 + z];
+          v[(i*Nc+j)*2+z] = this->unpack(gauge[((((dir*2+parity)*exVolumeCB + x)*Nc + j)*Nc + i)*2 + z]);
         }
       }
     }
@@ -680,7 +777,7 @@ template <typename Float, int length> struct BQCDOrder : LegacyOrder<Float,lengt
     for (int i=0; i<Nc; i++) {
       for (int j=0; j<Nc; j++) {
         for (int z=0; z<2; z++) {
-          gauge[((((dir*2+parity)*exVolumeCB + x)*Nc + j)*Nc + i)*2 + z] = (Float)v[(i*Nc+j)*2+z];
+          gauge[((((dir*2+parity)*exVolumeCB + x)*Nc + j)*Nc + i)*2 + z] = this->pack(v[(i*Nc+j)*2+z]);
         }
       }
     }
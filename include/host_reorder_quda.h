@@ -0,0 +1,36 @@
+#ifndef _HOST_REORDER_QUDA_H
+#define _HOST_REORDER_QUDA_H
+
+#include <quda.h>
+
+/**
+ * Fast host reordering between site-major application orders and the
+ * internal FloatN order, used by copyGenericGauge and
+ * copyGenericColorSpinor for the common pairs (QDP and MILC gauge
+ * fields, space-spin-color spinors).  In the site-major order, the
+ * length elements of site x start at x*siteStride; in the FloatN
+ * order, element i of site x is at ((i/N)*stride + x)*N + i%N.
+ *
+ * Sites are processed in tiles: a tile of the site-major side is
+ * gathered into a buffer that stays in cache and the contiguous rows
+ * of the FloatN side are written, or read, in one pass.  The tile size,
+ * thread count and whether the destination rows use non-temporal
+ * stores are tuned.  nBlock independent blocks of volume sites each
+ * (e.g., the parities and dimensions of a gauge field) are converted
+ * in one threaded loop.  Only double and single precision are
+ * supported.
+ */
+
+namespace quda {
+
+  /** Reorder from the site-major order in[b] into the FloatN order out[b], for b in [0,nBlock) */
+  void reorderToFloatN(void **out, void **in, int nBlock, QudaPrecision outPrec, QudaPrecision inPrec,
+		       int volume, int length, int siteStride, int N, int stride);
+
+  /** Reorder from the FloatN order in[b] into the site-major order out[b], for b in [0,nBlock) */
+  void reorderFromFloatN(void **out, void **in, int nBlock, QudaPrecision outPrec, QudaPrecision inPrec,
+			 int volume, int length, int siteStride, int N, int stride);
+
+} // namespace quda
+
+#endif // _HOST_REORDER_QUDA_H
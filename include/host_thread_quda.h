@@ -0,0 +1,177 @@
+#ifndef _HOST_THREAD_QUDA_H
+#define _HOST_THREAD_QUDA_H
+
+#include <vector>
+#include <tune_quda.h>
+
+/**
+ * Host execution layer for the QUDA_CPU_FIELD_LOCATION code paths.  A
+ * persistent pool of worker threads is started on first use and
+ * joined by endQuda().  A parallel loop runs on the calling thread
+ * (as thread 0) plus nthreads-1 workers.  Loops issued from within a
+ * parallel loop, or while another application thread is using the
+ * pool, run serially on the calling thread.
+ *
+ * When QUDA_HOST_AFFINITY lists cores, e.g., "0-7,16-23", worker i is
+ * bound to the i-th core of the list (modulo its length); entry 0 is
+ * left to the calling thread, which is never rebound.
+ */
+
+namespace quda {
+
+  enum HostSchedule {
+    HOST_SCHEDULE_STATIC, /**< one contiguous range per thread */
+    HOST_SCHEDULE_STEAL   /**< chunks of per-thread ranges, with idle threads stealing half of another's remainder */
+  };
+
+  /** The body of a parallel loop, called on contiguous sub-ranges of the iteration space */
+  class HostLoop {
+  public:
+    virtual ~HostLoop() { }
+    virtual void operator()(int begin, int end, int thread) const = 0;
+  };
+
+  /**
+   * Execute loop over [0,n) on nthreads threads.
+   * @param chunk Work-stealing granularity; 0 picks n/(16*nthreads)
+   */
+  void hostParallelFor(const HostLoop &loop, int n, int nthreads,
+		       HostSchedule schedule=HOST_SCHEDULE_STATIC, int chunk=0);
+
+  /**< Stop and join the worker threads; called from endQuda() */
+  void hostThreadsEnd();
+
+  template <typename Functor>
+    class HostLoopFunctor : public HostLoop {
+    const Functor &f;
+  public:
+    HostLoopFunctor(const Functor &f) : f(f) { }
+    void operator()(int begin, int end, int thread) const { for (int i=begin; i<end; i++) f(i); }
+  };
+
+  /** Call f(i) for i in [0,n) on nthreads threads */
+  template <typename Functor>
+    void hostParallelFor(int n, const Functor &f, int nthreads, HostSchedule schedule=HOST_SCHEDULE_STATIC) {
+    hostParallelFor(HostLoopFunctor<Functor>(f), n, nthreads, schedule);
+  }
+
+  struct HostSum {
+    template <typename T> T operator()(const T &a, const T &b) const { return a + b; }
+  };
+
+  struct HostMax {
+    template <typename T> T operator()(const T &a, const T &b) const { return a > b ? a : b; }
+  };
+
+  template <typename T, typename Functor, typename Reducer>
+    class HostReduceLoop : public HostLoop {
+    const Functor &f;
+    const Reducer &reduce;
+    const T init;
+    const int n;
+    const int block;
+    T *partial;
+  public:
+    HostReduceLoop(const Functor &f, const Reducer &reduce, const T &init, int n, int block, T *partial)
+      : f(f), reduce(reduce), init(init), n(n), block(block), partial(partial) { }
+    void operator()(int begin, int end, int thread) const {
+      for (int b=begin; b<end; b++) {
+	T sum = init;
+	const int last = (b+1)*block < n ? (b+1)*block : n;
+	for (int i=b*block; i<last; i++) sum = reduce(sum, f(i));
+	partial[b] = sum;
+      }
+    }
+  };
+
+  /**
+   * Reduce f(i) over [0,n) on nthreads threads.  The items are split
+   * into (at most) 256 fixed blocks whose partial results are combined
+   * in order, so the result does not depend on the number of threads
+   * or the schedule.
+   */
+  template <typename T, typename Functor, typename Reducer>
+    T hostParallelReduce(int n, const Functor &f, const T &init, const Reducer &reduce, int nthreads,
+			 HostSchedule schedule=HOST_SCHEDULE_STATIC) {
+    if (n <= 0) return init;
+    const int block = (n + 255) / 256;
+    const int nblock = (n + block - 1) / block;
+    std::vector<T> partial(nblock);
+    hostParallelFor(HostReduceLoop<T,Functor,Reducer>(f, reduce, init, n, block, &partial[0]),
+		    nblock, nthreads, schedule, 1);
+    T sum = init;
+    for (int b=0; b<nblock; b++) sum = reduce(sum, partial[b]);
+    return sum;
+  }
+
+  /**
+   * A host loop of n independent items, f(i), tuned over the number of
+   * threads.  The caller supplies the tune key and the flop and byte
+   * counts of the whole loop.  Each tuning trial re-runs the loop, so
+   * f must be idempotent (e.g., out-of-place).
+   */
+  template <typename Functor>
+    class TunableHostLoop : public TunableCPU {
+    const Functor &f;
+    const int n;
+    const TuneKey key;
+    const long long flops_;
+    const long long bytes_;
+    const HostSchedule schedule;
+
+  protected:
+    int maxThreads() const { return n < hostThreadCount() ? (n > 0 ? n : 1) : hostThreadCount(); }
+    long long flops() const { return flops_; }
+    long long bytes() const { return bytes_; }
+
+  public:
+    TunableHostLoop(const Functor &f, int n, const TuneKey &key, long long flops, long long bytes,
+		    HostSchedule schedule=HOST_SCHEDULE_STATIC)
+      : f(f), n(n), key(key), flops_(flops), bytes_(bytes), schedule(schedule) { }
+    virtual ~TunableHostLoop() { }
+
+    void apply(const cudaStream_t &stream) {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      HostKernelScope scope(*this);
+      hostParallelFor(n, f, tp.threads, schedule);
+    }
+
+    TuneKey tuneKey() const { return key; }
+  };
+
+  /** As TunableHostLoop, but reducing f(i) into result */
+  template <typename T, typename Functor, typename Reducer>
+    class TunableHostReduce : public TunableCPU {
+    const Functor &f;
+    const int n;
+    const T init;
+    const Reducer reduce;
+    const TuneKey key;
+    const long long flops_;
+    const long long bytes_;
+
+  protected:
+    int maxThreads() const { return n < hostThreadCount() ? (n > 0 ? n : 1) : hostThreadCount(); }
+    long long flops() const { return flops_; }
+    long long bytes() const { return bytes_; }
+
+  public:
+    T result;
+
+    TunableHostReduce(const Functor &f, int n, const T &init, const TuneKey &key,
+		      long long flops, long long bytes, const Reducer &reduce=Reducer())
+      : f(f), n(n), init(init), reduce(reduce), key(key), flops_(flops), bytes_(bytes), result(init) { }
+    virtual ~TunableHostReduce() { }
+
+    void apply(const cudaStream_t &stream) {
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      HostKernelScope scope(*this);
+      result = hostParallelReduce(n, f, init, reduce, tp.threads);
+    }
+
+    TuneKey tuneKey() const { return key; }
+  };
+
+} // namespace quda
+
+#endif // _HOST_THREAD_QUDA_H
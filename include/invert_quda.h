@@ -122,6 +122,15 @@ namespace quda {
 
     /**< The Gflops rate of the solver */
     double gflops;
+
+    /**< Caller-provided buffer for per-iteration telemetry (may be NULL) */
+    QudaSolverTelemetry *telemetry;
+
+    /**< The number of records the telemetry buffer can hold */
+    int telemetry_size;
+
+    /**< The number of telemetry records written so far */
+    int telemetry_count;
     
     /**
        Constructor that matches the initial values to that of the
@@ -139,7 +148,8 @@ namespace quda {
       preserve_source(param.preserve_source), num_offset(param.num_offset), 
       Nkrylov(param.gcrNkrylov), precondition_cycle(param.precondition_cycle), 
       tol_precondition(param.tol_precondition), maxiter_precondition(param.maxiter_precondition), 
-      omega(param.omega), schwarz_type(param.schwarz_type), secs(param.secs), gflops(param.gflops)
+      omega(param.omega), schwarz_type(param.schwarz_type), secs(param.secs), gflops(param.gflops),
+      telemetry(param.telemetry), telemetry_size(param.telemetry_size), telemetry_count(param.telemetry_count)
     { 
       for (int i=0; i<num_offset; i++) {
 	offset[i] = param.offset[i];
@@ -159,6 +169,7 @@ namespace quda {
       param.iter += iter;
       param.gflops = (param.gflops*param.secs + gflops*secs) / (param.secs + secs);
       param.secs += secs;
+      param.telemetry_count = telemetry_count;
       if (offset >= 0) {
 	param.true_res_offset[offset] = true_res_offset[offset];
 	param.true_res_hq_offset[offset] = true_res_hq_offset[offset];
@@ -206,6 +217,59 @@ namespace quda {
 
   };
 
+  /**
+     Records the per-iteration telemetry of a solve (see
+     QudaInvertParam::telemetry) into the caller's buffer and, if
+     QUDA_SOLVER_TELEMETRY is set, streams it to that file.  Create one
+     at the start of the solve, bracket the operator applications with
+     MatvecStart() and MatvecStop(), and call Record() once per
+     iteration.  The reduction time is taken from blas_reduce_secs.
+     Inner (preconditioner) solves are not recorded.  When neither
+     output is requested, each call is a single branch.
+   */
+  class SolverTelemetry {
+
+  private:
+    SolverParam &param;
+    const char *name;
+    const bool active;
+    int solve;                // index of this solve, for the stream
+    QudaPrecision last_precision;
+    double iteration_start;   // time of the last record
+    double matvec_start;
+    double matvec_secs;       // operator time since the last record
+    double reduce_start;      // blas_reduce_secs at the last record
+
+  public:
+    SolverTelemetry(SolverParam &param, const char *name);
+    ~SolverTelemetry();
+
+    bool Active() const { return active; }
+
+    void MatvecStart() { if (active) StartMatvec(); }
+    void MatvecStop() { if (active) StopMatvec(); }
+
+    /**
+       Record iteration k
+       @param r2 The squared residual norm
+       @param b2 The squared source norm
+       @param hq The heavy-quark residual norm (0 if not computed)
+       @param reliable Whether this iteration did a reliable update
+       @param precision The precision of the operator applied in this iteration
+     */
+    void Record(int k, double r2, double b2, double hq, bool reliable, QudaPrecision precision) {
+      if (active) RecordIteration(k, r2, b2, hq, reliable, precision);
+    }
+
+  private:
+    void StartMatvec();
+    void StopMatvec();
+    void RecordIteration(int k, double r2, double b2, double hq, bool reliable, QudaPrecision precision);
+  };
+
+  /**< Close the QUDA_SOLVER_TELEMETRY stream; called from endQuda() */
+  void closeSolverTelemetry();
+
   class CG : public Solver {
 
   private:
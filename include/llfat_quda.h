@@ -94,6 +94,24 @@ namespace quda {
 			  QudaGaugeParam* qudaGaugeParam, QudaComputeFatMethod method,
 			  cudaGaugeField* cudaFatLink, cudaGaugeField* cudaLongLink, 
                           TimeProfile& profile);
+
+  class cpuGaugeField;
+
+  /**
+     Compute the fat links, and the long links if lng is not NULL, on
+     the host threads, with the path coefficients of computeKSLinkQuda().
+     With QUDA_COMPUTE_FAT_EXTENDED_VOLUME the site links hold the local
+     volume extended by two sites in each direction, otherwise the local
+     volume; the halo is exchanged here.  Defined in llfat_host.cu.
+
+     @param fat The fat links (QDP or MILC order)
+     @param lng The long links (QDP or MILC order), or NULL
+     @param sitelink The site links (QDP or MILC order)
+     @param act_path_coeff The path coefficients
+     @param method Whether the site links are extended
+  */
+  void computeKSLinkCPU(cpuGaugeField &fat, cpuGaugeField *lng, cpuGaugeField &sitelink,
+			const double *act_path_coeff, QudaComputeFatMethod method);
   
 } // namespace quda
 
@@ -0,0 +1,73 @@
+#ifndef _PERF_COUNTER_QUDA_H
+#define _PERF_COUNTER_QUDA_H
+
+/**
+ * Hardware performance counters for host code, read through Linux
+ * perf_event_open.  Counting is enabled by setting the environment
+ * variable QUDA_PERF_COUNTERS=1.  Each thread opens its own counters
+ * on first use.  The workers of the host thread pool register theirs,
+ * so that a pool sample also covers the work they do for a parallel
+ * loop issued by the calling thread.  Counters
+ * that the kernel or the processor does not provide (e.g., with a
+ * restrictive perf_event_paranoid setting, or in a virtual machine) are
+ * reported as unavailable, and the rest of the library is unaffected.
+ */
+
+namespace quda {
+
+  enum QudaPerfCounter {
+    QUDA_PERF_CYCLES,            /**< core clock cycles */
+    QUDA_PERF_INSTRUCTIONS,      /**< instructions retired */
+    QUDA_PERF_LLC_READ_MISSES,   /**< last-level cache read misses */
+    QUDA_PERF_LLC_WRITE_MISSES,  /**< last-level cache write misses */
+    QUDA_PERF_FLOPS,             /**< floating-point operations, from the raw events in QUDA_PERF_FP_EVENTS */
+    QUDA_PERF_COUNTER_COUNT
+  };
+
+  /**< Cumulative counter values, scaled for multiplexing */
+  struct PerfSample {
+    double value[QUDA_PERF_COUNTER_COUNT];
+  };
+
+  /**< Is counting enabled (set by QUDA_PERF_COUNTERS)? */
+  extern bool perfEnabled;
+
+  /**
+   * Enable counting if requested.  The floating-point operation count
+   * has no portable event, so it is only available when
+   * QUDA_PERF_FP_EVENTS lists raw event codes, each with the number of
+   * flops per count, e.g., "0x01c7:1,0x02c7:1,0x04c7:2,0x08c7:4,0x10c7:4,0x20c7:8"
+   * for the FP_ARITH_INST_RETIRED events on Intel Skylake.  Called from
+   * initQuda().
+   */
+  void perfCountersInit();
+
+  /**< Read the calling thread's counters, opening them if necessary */
+  void perfCountersRead(PerfSample &sample);
+
+  /**
+   * Read the counters of the calling thread summed with those of the
+   * host pool workers (see host_thread_quda.h).  When called on a
+   * worker, only that worker is read.  Should another application
+   * thread be running a parallel loop at the same time, its workers
+   * are included.
+   */
+  void perfCountersReadPool(PerfSample &sample);
+
+  /**< Open the counters of a pool worker and register them; called by each worker before it runs a loop */
+  void perfCountersAttachWorker();
+
+  /**< Is this counter available to the calling thread? */
+  bool perfCounterAvailable(QudaPerfCounter counter);
+
+  /**< Bytes moved to or from memory, estimated from the LLC misses */
+  double perfMemoryBytes(const PerfSample &delta);
+
+  /**< Accumulate sum += end - start */
+  void perfAccumulate(PerfSample &sum, const PerfSample &start, const PerfSample &end);
+
+  void perfClear(PerfSample &sample);
+
+} // namespace quda
+
+#endif // _PERF_COUNTER_QUDA_H
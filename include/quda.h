@@ -38,6 +38,17 @@
  */
 #define QUDA_MAX_MULTI_SHIFT 32
 
+/**
+ * @def QUDA_AOSOA_BLOCK_BYTES
+ * @brief Size in bytes of the site blocks of the AoSoA host field
+ *        orders (QUDA_AOSOA_GAUGE_ORDER and QUDA_AOSOA_DIRAC_ORDER):
+ *        each block holds QUDA_AOSOA_BLOCK_BYTES/precision sites.
+ *        This is part of the field layout and does not depend on the
+ *        instruction set the library is built for; 64 bytes fill one
+ *        AVX-512 or two AVX registers.
+ */
+#define QUDA_AOSOA_BLOCK_BYTES 64
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +74,7 @@ extern "C" {
     QudaTboundary t_boundary;  /**< The temporal boundary condition that will be used for fermion fields */
 
     QudaPrecision cpu_prec; /**< The precision used by the caller */
+    QudaReconstructType cpu_reconstruct; /**< The reconstruction type of the host gauge field (Wilson links in QDP, MILC or AoSoA order) */
 
     QudaPrecision cuda_prec; /**< The precision of the cuda gauge field */
     QudaReconstructType reconstruct; /**< The reconstruction type of the cuda gauge field */
@@ -85,10 +97,39 @@ extern "C" {
     double gaugeGiB;  /**< The storage used by the gauge fields */
 
     int preserve_gauge; /**< Used by link fattening */
+    QudaFieldLocation fat_link_location; /**< Where link fattening is computed (host threads or device) */
     
   } QudaGaugeParam;
 
 
+  /**
+   * Gauge observables computed by gaugeObservablesQuda().  The
+   * averages are normalized to one on the unit gauge field.
+   */
+  typedef struct QudaGaugeObservableParam_s {
+    double plaquette[3];     /**< Average plaquette: total, spatial and temporal (output) */
+    double rectangle;        /**< Average 2x1 rectangle over all 12 orientations (output) */
+    double polyakov_loop[2]; /**< Real and imaginary parts of the spatially averaged temporal Polyakov loop (output) */
+    double qcharge;          /**< Clover-leaf topological charge (output) */
+    double *qcharge_density; /**< Host array of the local volume, ordered lexicographically with x fastest, for the charge density, or NULL (output) */
+  } QudaGaugeObservableParam;
+
+  /**
+   * One iteration of a linear solver, as recorded in the telemetry
+   * buffer (see QudaInvertParam::telemetry).
+   */
+  typedef struct QudaSolverTelemetry_s {
+    int iter;               /**< Iteration number */
+    double residual;        /**< L2 relative residual norm |r|/|b| (the true residual after a reliable update) */
+    double residual_hq;     /**< Heavy-quark residual norm, if it is being computed (it may lag by a few iterations) */
+    int reliable_update;    /**< Whether a reliable update was performed in this iteration */
+    int precision_switch;   /**< Whether the precision differs from that of the previous iteration */
+    QudaPrecision precision; /**< The highest precision of the operator applied in this iteration (the full precision on reliable updates) */
+    double secs;            /**< The time taken by this iteration */
+    double matvec_secs;     /**< The time spent applying the operator in this iteration */
+    double reduction_secs;  /**< The time spent in reductions (including the global sums) in this iteration */
+  } QudaSolverTelemetry;
+
   /**
    * Parameters relating to the solver and the choice of Dirac operator.
    */
@@ -219,6 +260,21 @@ extern "C" {
      */
     QudaResidualType residual_type;
 
+    /**
+     * Optional caller-allocated buffer of telemetry_size records.  When
+     * non-NULL, the solver appends one record per iteration, and
+     * telemetry_count returns the number of iterations recorded, of
+     * which the first telemetry_size are stored.  Timing the operator separately from
+     * the reductions requires a device synchronization per iteration,
+     * so this should not be enabled in production runs that do not use
+     * the data.  Setting the environment variable
+     * QUDA_SOLVER_TELEMETRY=<file> additionally streams every record to
+     * the given file.
+     */
+    QudaSolverTelemetry *telemetry;
+    int telemetry_size;    /**< The number of records that the telemetry buffer can hold */
+    int telemetry_count;   /**< The number of iterations recorded by the last invertQuda() call */
+
   } QudaInvertParam;
 
 
@@ -294,6 +350,50 @@ extern "C" {
    */
   void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata);
 
+  /**
+   * Declare the communication grid automatically, as an alternative
+   * to initCommsGridQuda().  Among all process grids that evenly
+   * divide the global lattice (with even local dimensions), the one
+   * minimizing the halo surface per process is chosen.  Processes
+   * sharing a host are assigned a contiguous block of the grid, so
+   * that as many neighbours as possible communicate within the node,
+   * and the block shape is chosen to minimize inter-node traffic.
+   *
+   * @param nDim   Number of grid dimensions.  "4" is the only supported
+   *               value currently.
+   *
+   * @param X      Global lattice dimensions
+   *
+   * @param dims   Returned array of grid dimensions chosen, from
+   *               which the local lattice dimensions X[i]/dims[i]
+   *               follow
+   */
+  void initCommsGridAutoQuda(int nDim, const int *X, int *dims);
+
+  /**
+   * Set the precision used for exchanging spinor halos between
+   * processes.  Halos are converted to this precision on the host
+   * before being sent and expanded on receipt, trading accuracy of
+   * the ghost zones for reduced network bandwidth.  Half precision
+   * uses a per-site normalization.  This applies to Dirac operators
+   * created after the call, and has no effect if the requested
+   * precision is not lower than that of the field.
+   *
+   * @param precision  Halo precision, or QUDA_INVALID_PRECISION to
+   *                   exchange halos in the native precision (default)
+   */
+  void setHaloPrecisionQuda(QudaPrecision precision);
+
+  /**
+   * Enable or disable lossless byte-plane compression of host gauge
+   * field ghost exchanges (e.g., when loading a gauge field or
+   * constructing extended fields for link fattening).  Disabled by
+   * default.
+   *
+   * @param enable  Non-zero to enable compression
+   */
+  void setGaugeGhostCompressionQuda(int enable);
+
   /**
    * Initialize the library.  This is a low-level interface that is
    * called by initQuda.  Calling initQudaDevice requires that the
@@ -487,6 +587,24 @@ extern "C" {
    */
   void updateGaugeFieldQuda(void* gauge, void* momentum, double dt, QudaGaugeParam* param);
 
+  /**
+   * Compute the gauge observables of a host gauge field with the host
+   * threads (QUDA_HOST_THREADS), exchanging the halo between ranks.
+   * The plaquette is Re tr U_{mu nu}/3, the rectangle is the 2x1 loop
+   * Re tr/3 and the Polyakov loop is tr/3 of the product of the
+   * temporal links, each averaged over the sites (and orientations).
+   * The topological charge density is
+   * q = eps_{mu nu rho sigma} tr(F_{mu nu} F_{rho sigma})/(32 pi^2),
+   * with F the traceless clover-leaf field strength.  The links must
+   * be SU(3) matrices without staggered phases or boundary conditions
+   * applied.  The result does not depend on the number of threads.
+   *
+   * @param h_gauge Base pointer to host gauge field (regardless of dimensionality)
+   * @param param   Contains the metadata of the host gauge field
+   * @param obs     The computed observables
+   */
+  void gaugeObservablesQuda(void *h_gauge, QudaGaugeParam *param, QudaGaugeObservableParam *obs);
+
 #ifdef __cplusplus
 }
 #endif
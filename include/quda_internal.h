@@ -38,6 +38,9 @@
 #define DagType QudaDagType
 #define TEX_ALIGN_REQ (512*2) //Fermi, factor 2 comes from even/odd
 #define ALIGNMENT_ADJUST(n) ( (n+TEX_ALIGN_REQ-1)/TEX_ALIGN_REQ*TEX_ALIGN_REQ)
+
+// Number of sites interleaved by the AoSoA host field orders
+#define AOSOA_WIDTH(precision) (QUDA_AOSOA_BLOCK_BYTES/(precision))
 #include <enum_quda.h>
 #include <quda.h>
 #include <util_quda.h>
@@ -169,6 +172,40 @@ namespace quda {
     QUDA_PROFILE_COUNT /**< The total number of timers we have.  Must be last enum type. */
   };
 
+  /**< Is hierarchical tracing enabled (set by QUDA_PROFILE_TRACE)? */
+  extern bool traceEnabled;
+
+  /**
+   * Enable tracing if the environment variable QUDA_PROFILE_TRACE is
+   * set to a file prefix.  Called from initQuda().
+   */
+  void traceInit();
+
+  /**
+   * Write the Chrome trace-event file <prefix>.<rank>.json and the
+   * per-scope summary <prefix>.<rank>.tsv, and disable tracing.
+   * Called from endQuda() before the communicator is destroyed.
+   */
+  void traceFinalize();
+
+  /**
+   * Open and close a named scope on the calling thread's timeline.
+   * Scopes nest, and the summary aggregates time by the path of
+   * enclosing scopes.  Only call these when traceEnabled is set.
+   */
+  void traceBegin(const char *name);
+  void traceEnd(const char *name);
+
+  /**
+   * Convenience object that traces its own lifetime, e.g., one solver
+   * iteration.  The name must outlive the object.
+   */
+  struct TraceScope {
+    const char *name;
+    TraceScope(const char *name) : name(name) { if (traceEnabled) traceBegin(name); }
+    ~TraceScope() { if (traceEnabled) traceEnd(name); }
+  };
+
   struct TimeProfile {
     std::string fname;  /**< Which function are we profiling */
 
@@ -182,22 +219,31 @@ namespace quda {
     /**< Print out the profile information */
     void Print();
 
+    /**< Name of the trace scope corresponding to timer idx */
+    const char* scopeName(QudaProfileType idx) {
+      return idx == QUDA_PROFILE_TOTAL ? fname.c_str() : pname[idx].c_str();
+    }
+
     void Start(QudaProfileType idx) { 
       // if total timer isn't running, then start it running
       if (!profile[QUDA_PROFILE_TOTAL].running && idx != QUDA_PROFILE_TOTAL) {
 	profile[QUDA_PROFILE_TOTAL].Start(); 
+	if (traceEnabled) traceBegin(scopeName(QUDA_PROFILE_TOTAL));
 	switchOff = true;
       }
 
       profile[idx].Start(); 
+      if (traceEnabled) traceBegin(scopeName(idx));
     }
 
     void Stop(QudaProfileType idx) { 
       profile[idx].Stop(); 
+      if (traceEnabled) traceEnd(scopeName(idx));
 
       // switch off total timer if we need to
       if (switchOff && idx != QUDA_PROFILE_TOTAL) {
 	profile[QUDA_PROFILE_TOTAL].Stop(); 
+	if (traceEnabled) traceEnd(scopeName(QUDA_PROFILE_TOTAL));
 	switchOff = false;
       }
     }
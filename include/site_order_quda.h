@@ -0,0 +1,68 @@
+#ifndef _SITE_ORDER_QUDA_H
+#define _SITE_ORDER_QUDA_H
+
+#include <vector>
+
+/**
+ * Site tables for host fields in QUDA_MORTON_SITE_ORDER.  The field
+ * is split into its even and odd halves as in the even-odd order, but
+ * the sites of each parity are stored along a 4-d Morton (Z-order)
+ * curve: sorted by the key obtained by interleaving the bits of their
+ * (x,y,z,t) coordinates.  Any aligned 2^k x 2^k x 2^k x 2^k tile of
+ * the lattice is then contiguous in memory, so that all eight
+ * neighbours of a site are close to it in memory, rather than only the
+ * x neighbours as in the lexicographic order.  Dimensions that are not
+ * powers of two are allowed; the curve simply skips the coordinates
+ * outside the lattice.  All dimensions must be even, so that every
+ * neighbour, including those across the boundary, has the opposite
+ * parity.
+ *
+ * The checkerboard index used by the even-odd order is the
+ * lexicographic index (x fastest) divided by two, with parity
+ * (x+y+z+t)%2.  Neighbours wrap around the local volume.
+ */
+
+namespace quda {
+
+  class MortonSiteOrder {
+    int X[4];
+    int volumeCB;
+    std::vector<int> toCurve[2];
+    std::vector<int> fromCurve[2];
+    std::vector<int> neighbour[2];
+
+  public:
+    MortonSiteOrder(const int *X);
+
+    const int* Dims() const { return X; }
+    int VolumeCB() const { return volumeCB; }
+
+    /** Map from the checkerboard index of a site of the given parity to its position along the curve */
+    const int* ToCurve(int parity) const { return &toCurve[parity][0]; }
+
+    /** Map from the position along the curve to the checkerboard index */
+    const int* FromCurve(int parity) const { return &fromCurve[parity][0]; }
+
+    /**
+       Neighbour table of the given parity: entry 8*i + 2*mu + d is the
+       curve position, in the opposite parity, of the forwards (d=0) or
+       backwards (d=1) neighbour in dimension mu of the site at curve
+       position i
+    */
+    const int* Neighbours(int parity) const { return &neighbour[parity][0]; }
+  };
+
+  /**
+     Return the tables for the local lattice dimensions X[0..3] (X[0]
+     is the full, not the checkerboarded, extent).  The tables are
+     built on first use and cached until freeSiteOrderTables() is
+     called.
+  */
+  const MortonSiteOrder& mortonSiteOrder(const int *X);
+
+  /** Release the cached site tables */
+  void freeSiteOrderTables();
+
+} // namespace quda
+
+#endif // _SITE_ORDER_QUDA_H
@@ -3,6 +3,7 @@
 
 #include <quda_internal.h>
 #include <dirac_quda.h>
+#include <perf_counter_quda.h>
 
 #include <string>
 #include <iostream>
@@ -10,29 +11,68 @@
 
 namespace quda {
 
+  /** The hardware a Tunable executes on.  This is recorded in the TuneKey so that host and device
+      variants of the same kernel are cached separately. */
+  enum QudaTuneBackend {
+    QUDA_TUNE_BACKEND_CUDA,
+    QUDA_TUNE_BACKEND_CPU
+  };
+
+  const char *getTuneBackendString(QudaTuneBackend backend);
+
+  /**
+   * Identifies a kernel launch for the purposes of tuning.  A 64-bit
+   * hash of the strings is computed on construction, so that the
+   * tunecache lookup in tuneLaunch() costs a hash comparison rather than
+   * a series of string comparisons.  Code that modifies the strings
+   * after construction must call rehash().
+   */
   class TuneKey {
 
   public:
+    std::string backend;
     std::string volume;
     std::string name;
     std::string aux;
+    unsigned long long hash;
 
-    TuneKey() { }
+  TuneKey() : backend("cuda") { rehash(); }
   TuneKey(std::string v, std::string n, std::string a=std::string("type=default"))
-    : volume(v), name(n), aux(a) { }
+    : backend("cuda"), volume(v), name(n), aux(a) { rehash(); }
   TuneKey(const TuneKey &key)
-    : volume(key.volume), name(key.name), aux(key.aux) { }
+    : backend(key.backend), volume(key.volume), name(key.name), aux(key.aux), hash(key.hash) { }
 
     TuneKey& operator=(const TuneKey &key) {
       if (&key != this) {
+	backend = key.backend;
 	volume = key.volume;
 	name = key.name;
 	aux = key.aux;
+	hash = key.hash;
       }
       return *this;
     }
 
+    /** recompute the hash (64-bit FNV-1a over the strings, each terminated by a NUL) */
+    void rehash() {
+      const std::string *field[] = { &backend, &volume, &name, &aux };
+      hash = 14695981039346656037ull;
+      for (int f=0; f<4; f++) {
+	const char *c = field[f]->c_str();
+	for (size_t i=0; i<=field[f]->length(); i++) { // include the terminating NUL as a separator
+	  hash ^= static_cast<unsigned char>(c[i]);
+	  hash *= 1099511628211ull;
+	}
+      }
+    }
+
+    bool operator==(const TuneKey &other) const {
+      return hash == other.hash && backend == other.backend && volume == other.volume &&
+	name == other.name && aux == other.aux;
+    }
+
     bool operator<(const TuneKey &other) const {
+      if (backend != other.backend) return backend < other.backend;
       return (volume < other.volume) ||
 	((volume == other.volume) && (name < other.name)) ||
 	((volume == other.volume) && (name == other.name) && (aux < other.aux));
@@ -44,19 +84,32 @@ namespace quda {
   class TuneParam {
 
   public:
+    // CUDA launch parameters
     dim3 block;
     dim3 grid;
     int shared_bytes;
+
+    // host parameters: thread count, cache-block tile shape and SIMD code path
+    int threads;
+    dim3 tile;
+    int simd;
+
+    float time; // measured time per launch in seconds, negative if unknown
     std::string comment;
 
-  TuneParam() : block(32, 1, 1), grid(1, 1, 1), shared_bytes(0) { }
+  TuneParam() : block(32, 1, 1), grid(1, 1, 1), shared_bytes(0), threads(1), tile(1, 1, 1), simd(0), time(-1) { }
   TuneParam(const TuneParam &param)
-    : block(param.block), grid(param.grid), shared_bytes(param.shared_bytes), comment(param.comment) { }
+    : block(param.block), grid(param.grid), shared_bytes(param.shared_bytes),
+      threads(param.threads), tile(param.tile), simd(param.simd), time(param.time), comment(param.comment) { }
     TuneParam& operator=(const TuneParam &param) {
       if (&param != this) {
 	block = param.block;
 	grid = param.grid;
 	shared_bytes = param.shared_bytes;
+	threads = param.threads;
+	tile = param.tile;
+	simd = param.simd;
+	time = param.time;
 	comment = param.comment;
       }
       return *this;
@@ -65,6 +118,13 @@ namespace quda {
   };
 
 
+  /**
+   * The number of host threads available to host Tunables: the value of
+   * QUDA_HOST_THREADS if set, otherwise the number of online cores.
+   */
+  int hostThreadCount();
+
+
   class Tunable {
 
   protected:
@@ -156,9 +216,17 @@ namespace quda {
       }
     }
 
+    friend TuneParam tuneLaunch(Tunable &tunable, QudaTune enabled, QudaVerbosity verbosity);
+    friend class HostKernelScope;
+
+    /** memoized tunecache entry of the most recent launch, which tuneLaunch() checks before the cache */
+    unsigned long long cached_hash;
+    const TuneParam *cached_param;
+
   public:
-    Tunable() { }
+    Tunable() : cached_hash(0), cached_param(0) { }
     virtual ~Tunable() { }
+    virtual QudaTuneBackend backend() const { return QUDA_TUNE_BACKEND_CUDA; }
     virtual TuneKey tuneKey() const = 0;
     virtual void apply(const cudaStream_t &stream) = 0;
     virtual void preTune() { }
@@ -223,7 +291,7 @@ namespace quda {
      * Check the launch parameters of the kernel to ensure that they are
      * valid for the current device.
      */
-    void checkLaunchParam(TuneParam &param) {
+    virtual void checkLaunchParam(TuneParam &param) {
     
       if (param.block.x > (unsigned int)deviceProp.maxThreadsDim[0])
 	errorQuda("Requested X-dimension block size %d greater than hardware limit %d", 
@@ -253,10 +321,148 @@ namespace quda {
 
   };
 
+
+  /**
+   * Base class for host kernels.  Instead of the CUDA launch
+   * configuration, the tuned parameters are the number of threads, the
+   * shape of the cache-blocking tile over (up to) the three fastest
+   * running dimensions of the iteration space, and which of the
+   * kernel's SIMD code paths to use.  apply() is passed a null stream
+   * and should call tuneLaunch() and honour the returned parameters.
+   */
+  class TunableCPU : public Tunable {
+
+  protected:
+    unsigned int sharedBytesPerThread() const { return 0; }
+    unsigned int sharedBytesPerBlock(const TuneParam &param) const { return 0; }
+    bool tuneGridDim() const { return false; }
+
+    /** the maximum number of threads worth using, e.g., limited by the available parallelism */
+    virtual int maxThreads() const { return hostThreadCount(); }
+
+    /** the extent of the blockable iteration space; 1 in a dimension disables blocking there */
+    virtual dim3 tileExtent() const { return dim3(1, 1, 1); }
+
+    /** the number of SIMD code paths the kernel provides, with variant 0 the default */
+    virtual int simdVariants() const { return 1; }
+
+    virtual bool advanceSimd(TuneParam &param) const
+    {
+      if (++param.simd < simdVariants()) return true;
+      param.simd = 0;
+      return false;
+    }
+
+    /** halve the tile extent in x, then y, then z (odometer order) */
+    virtual bool advanceTile(TuneParam &param) const
+    {
+      const dim3 extent = tileExtent();
+      unsigned int *tile[] = { &param.tile.x, &param.tile.y, &param.tile.z };
+      const unsigned int max[] = { extent.x, extent.y, extent.z };
+      for (int d=0; d<3; d++) {
+	if (*tile[d] > 1) {
+	  *tile[d] /= 2;
+	  return true;
+	}
+	*tile[d] = max[d];
+      }
+      return false;
+    }
+
+    /** powers of two up to maxThreads(), always including maxThreads() itself */
+    virtual bool advanceThreads(TuneParam &param) const
+    {
+      const int max_threads = maxThreads();
+      if (param.threads >= max_threads) {
+	param.threads = 1;
+	return false;
+      }
+      param.threads = (2*param.threads < max_threads) ? 2*param.threads : max_threads;
+      return true;
+    }
+
+  public:
+    TunableCPU() { }
+    virtual ~TunableCPU() { }
+    QudaTuneBackend backend() const { return QUDA_TUNE_BACKEND_CPU; }
+
+    virtual std::string paramString(const TuneParam &param) const
+      {
+	std::stringstream ps;
+	ps << "threads=" << param.threads << ", ";
+	ps << "tile=(" << param.tile.x << "," << param.tile.y << "," << param.tile.z << "), ";
+	ps << "simd=" << param.simd;
+	return ps.str();
+      }
+
+    virtual void initTuneParam(TuneParam &param) const
+    {
+      param.threads = 1;
+      param.tile = tileExtent();
+      param.simd = 0;
+    }
+
+    /** sets default values for when tuning is disabled */
+    virtual void defaultTuneParam(TuneParam &param) const
+    {
+      initTuneParam(param);
+      param.threads = maxThreads();
+    }
+
+    virtual bool advanceTuneParam(TuneParam &param) const
+    {
+      return advanceSimd(param) || advanceTile(param) || advanceThreads(param);
+    }
+
+    virtual void checkLaunchParam(TuneParam &param) {
+      const dim3 extent = tileExtent();
+      if (param.threads < 1 || param.threads > maxThreads())
+	errorQuda("Requested thread count %d outside of valid range [1,%d]", param.threads, maxThreads());
+      if (param.tile.x < 1 || param.tile.x > extent.x || param.tile.y < 1 || param.tile.y > extent.y ||
+	  param.tile.z < 1 || param.tile.z > extent.z)
+	errorQuda("Requested tile (%u,%u,%u) exceeds iteration space (%u,%u,%u)",
+		  param.tile.x, param.tile.y, param.tile.z, extent.x, extent.y, extent.z);
+      if (param.simd < 0 || param.simd >= simdVariants())
+	errorQuda("Requested SIMD variant %d but only %d are available", param.simd, simdVariants());
+    }
+
+  };
+
   void loadTuneCache(QudaVerbosity verbosity);
   void saveTuneCache(QudaVerbosity verbosity);
   TuneParam tuneLaunch(Tunable &tunable, QudaTune enabled, QudaVerbosity verbosity);
 
+  /**
+   * Brackets one execution of a host Tunable, e.g., the body of
+   * apply() after tuneLaunch().  When QUDA_PERF_COUNTERS is set, the
+   * elapsed time and the hardware counters of the calling thread and
+   * the host pool workers are accumulated per TuneKey, together with the flops() and bytes()
+   * estimates, and reported by printHostKernelProfile().  The
+   * execution also appears as a scope in the trace.  Otherwise the cost
+   * is one branch.
+   */
+  class HostKernelScope {
+    const Tunable &tunable;
+    bool active;
+    std::string name;
+    double start;
+    PerfSample counters;
+
+  public:
+    HostKernelScope(const Tunable &tunable);
+    ~HostKernelScope();
+  };
+
+  /**< Print the host kernel measurements; called from endQuda() */
+  void printHostKernelProfile();
+
+  /**
+   * When QUDA_ROOFLINE is set, print the achieved throughput and
+   * bandwidth of every device kernel against the peaks of the device;
+   * called from endQuda()
+   */
+  void printRooflineProfile();
+
 } // namespace quda
 
 #endif // _TUNE_QUDA_H
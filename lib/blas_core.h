@@ -74,13 +74,9 @@ public:
   virtual ~BlasCuda() { }
 
   TuneKey tuneKey() const {
-    std::stringstream vol, aux;
-    vol << blasConstants.x[0] << "x";
-    vol << blasConstants.x[1] << "x";
-    vol << blasConstants.x[2] << "x";
-    vol << blasConstants.x[3];    
-    aux << "stride=" << blasConstants.stride << ",prec=" << arg.X.Precision();
-    return TuneKey(vol.str(), typeid(arg.f).name(), aux.str());
+    char aux[64];
+    snprintf(aux, sizeof(aux), "%s%d", blasConstants.aux, arg.X.Precision());
+    return TuneKey(blasConstants.vol, typeid(arg.f).name(), aux);
   }  
 
   void apply(const cudaStream_t &stream) {
@@ -130,8 +126,7 @@ void blasCuda(const double2 &a, const double2 &b, const double2 &c,
     return;
   }
 
-  for (int d=0; d<QUDA_MAX_DIM; d++) blasConstants.x[d] = x.X()[d];
-  blasConstants.stride = x.Stride();
+  setBlasConstants(x);
 
   if (x.SiteSubset() == QUDA_FULL_SITE_SUBSET) {
     blasCuda<Functor,writeX,writeY,writeZ,writeW>
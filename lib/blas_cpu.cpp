@@ -1,20 +1,159 @@
+#include <vector>
+#include <cstring>
+#include <sstream>
 #include <color_spinor_field.h>
 #include <blas_quda.h>
 #include <face_quda.h>
+#include <host_thread_quda.h>
+
+// the longest site vector of a host spinor field (4 spins x 3 colors, complex)
+#define HALF_SITE_MAX 24
 
 namespace quda {
 
+  /**
+     Sites of a half precision host field, which holds 16-bit values
+     with one float norm per site (see cpuColorSpinorField).  The half
+     precision BLAS below load each site into double precision, apply
+     the same kernels as the other precisions and re-normalize the
+     sites they write.  Sites are independent, so the kernels are
+     threaded over them.
+  */
+  class HalfSites {
+    short *v;
+    float *norm;
+    const int nInt; // reals per site
+    const int N; // short vector length of the FloatN orders, 0 for site-major orders
+    const int volumeCB;
+    const int stride;
+    const int sites;
+    const size_t parityLength;
+    const size_t parityNorm;
+
+    size_t index(int s, int i) const {
+      if (N == 0) return (size_t)s*nInt + i;
+      const int parity = s / volumeCB;
+      const int x = s - parity*volumeCB;
+      return parity*parityLength + ((size_t)(i/N)*stride + x)*N + i%N;
+    }
+
+    size_t normIndex(int s) const {
+      if (N == 0) return s;
+      const int parity = s / volumeCB;
+      return parity*parityNorm + s - parity*volumeCB;
+    }
+
+  public:
+    HalfSites(const cpuColorSpinorField &a)
+      : v((short*)a.V()), norm((float*)a.Norm()), nInt(2*a.Nspin()*a.Ncolor()),
+	N(a.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER ? 4 : a.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER ? 2 : 0),
+	volumeCB(a.VolumeCB()), stride(a.Stride()),
+	sites((a.SiteSubset() == QUDA_FULL_SITE_SUBSET ? 2 : 1) * a.VolumeCB()),
+	parityLength(a.Bytes()/2/sizeof(short)), parityNorm(a.NormBytes()/2/sizeof(float)) {
+      if (nInt > HALF_SITE_MAX) errorQuda("Site length %d exceeds %d", nInt, HALF_SITE_MAX);
+    }
+
+    int Sites() const { return sites; }
+    int Length() const { return nInt; }
+
+    void load(double *u, int s) const {
+      const double scale = norm[normIndex(s)] / MAX_SHORT;
+      for (int i=0; i<nInt; i++) u[i] = v[index(s, i)] * scale;
+    }
+
+    void save(const double *u, int s) const {
+      double max = 0.0;
+      for (int i=0; i<nInt; i++) max = fabs(u[i]) > max ? fabs(u[i]) : max;
+      norm[normIndex(s)] = max;
+      const double scale = max > 0.0 ? MAX_SHORT / max : 0.0;
+      for (int i=0; i<nInt; i++) v[index(s, i)] = (short)(u[i] * scale);
+    }
+
+    /** Bytes read or written per site */
+    long long SiteBytes() const { return nInt*sizeof(short) + sizeof(float); }
+  };
+
+  static TuneKey halfKey(const cpuColorSpinorField &a, const char *name) {
+    std::stringstream vol, aux;
+    vol << a.Volume();
+    aux << "order=" << a.FieldOrder() << ",nSpin=" << a.Nspin();
+    return TuneKey(vol.str(), name, aux.str());
+  }
+
+  /**
+     A half precision kernel writing the field y in place, threaded
+     over its sites.  Since each tuning trial re-runs the kernel, y is
+     saved before tuning and restored afterwards.
+  */
+  template <typename Functor>
+  class HalfBlas : public TunableHostLoop<Functor> {
+    cpuColorSpinorField &y;
+    std::vector<char> v, norm;
+
+  public:
+    HalfBlas(const Functor &f, cpuColorSpinorField &y, const char *name, int nRead, long long flops)
+      : TunableHostLoop<Functor>(f, HalfSites(y).Sites(), halfKey(y, name), flops,
+				 (nRead+1)*HalfSites(y).Sites()*HalfSites(y).SiteBytes()), y(y) { }
+    virtual ~HalfBlas() { }
+
+    void preTune() {
+      v.resize(y.Bytes());
+      norm.resize(y.NormBytes());
+      memcpy(&v[0], y.V(), y.Bytes());
+      memcpy(&norm[0], y.Norm(), y.NormBytes());
+    }
+
+    void postTune() {
+      memcpy(y.V(), &v[0], y.Bytes());
+      memcpy(y.Norm(), &norm[0], y.NormBytes());
+      std::vector<char>().swap(v);
+      std::vector<char>().swap(norm);
+    }
+  };
+
+  template <typename T, typename Functor>
+  T halfReduce(const Functor &f, const cpuColorSpinorField &a, const char *name, int nRead, long long flops) {
+    HalfSites A(a);
+    TunableHostReduce<T, Functor, HostSum> reduce(f, A.Sites(), T(), halfKey(a, name), flops,
+						   nRead*A.Sites()*A.SiteBytes());
+    reduce.apply(0);
+    return reduce.result;
+  }
+
   template <typename Float>
   void axpby(const Float &a, const Float *x, const Float &b, Float *y, const int N) {
     for (int i=0; i<N; i++) y[i] = a*x[i] + b*y[i];
   }
 
+  struct AxpbyHalf {
+    const double a, b;
+    const HalfSites X, Y;
+    AxpbyHalf(const double &a, const cpuColorSpinorField &x, const double &b, cpuColorSpinorField &y)
+      : a(a), b(b), X(x), Y(y) { }
+    void operator()(int s) const {
+      double xs[HALF_SITE_MAX], ys[HALF_SITE_MAX];
+      X.load(xs, s);
+      Y.load(ys, s);
+      axpby(a, xs, b, ys, X.Length());
+      Y.save(ys, s);
+    }
+  };
+
+  void axpbyHalf(const double &a, const cpuColorSpinorField &x, 
+		 const double &b, cpuColorSpinorField &y) {
+    AxpbyHalf f(a, x, b, y);
+    HalfBlas<AxpbyHalf> blas(f, y, "axpbyHalf", 1, 3ll*x.Length());
+    blas.apply(0);
+  }
+
   void axpbyCpu(const double &a, const cpuColorSpinorField &x, 
 		const double &b, cpuColorSpinorField &y) {
     if (x.Precision() == QUDA_DOUBLE_PRECISION)
       axpby(a, (double*)x.V(), b, (double*)y.V(), x.Length());
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       axpby((float)a, (float*)x.V(), (float)b, (float*)y.V(), x.Length());
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      axpbyHalf(a, x, b, y);
     else
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -24,6 +163,8 @@ namespace quda {
       axpby(1.0, (double*)x.V(), 1.0, (double*)y.V(), x.Length());
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       axpby(1.0f, (float*)x.V(), 1.0f, (float*)y.V(), x.Length());
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      axpbyHalf(1.0, x, 1.0, y);
     else
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -34,6 +175,8 @@ namespace quda {
       axpby(a, (double*)x.V(), 1.0, (double*)y.V(), x.Length());
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       axpby((float)a, (float*)x.V(), 1.0f, (float*)y.V(), x.Length());
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      axpbyHalf(a, x, 1.0, y);
     else
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -44,6 +187,8 @@ namespace quda {
       axpby(1.0, (double*)x.V(), a, (double*)y.V(), x.Length());
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       axpby(1.0f, (float*)x.V(), (float)a, (float*)y.V(), x.Length());
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      axpbyHalf(1.0, x, a, y);
     else
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -53,6 +198,8 @@ namespace quda {
       axpby(-1.0, (double*)x.V(), 1.0, (double*)y.V(), x.Length());
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       axpby(-1.0f, (float*)x.V(), 1.0f, (float*)y.V(), x.Length());
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      axpbyHalf(-1.0, x, 1.0, y);
     else
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -62,6 +209,8 @@ namespace quda {
       axpby(0.0, (double*)x.V(), a, (double*)x.V(), x.Length());
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       axpby(0.0f, (float*)x.V(), (float)a, (float*)x.V(), x.Length());
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      axpbyHalf(0.0, x, a, x);
     else
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -76,6 +225,27 @@ namespace quda {
 
   }
 
+  struct CaxpbyHalf {
+    const Complex a, b;
+    const HalfSites X, Y;
+    CaxpbyHalf(const Complex &a, const cpuColorSpinorField &x, const Complex &b, cpuColorSpinorField &y)
+      : a(a), b(b), X(x), Y(y) { }
+    void operator()(int s) const {
+      double xs[HALF_SITE_MAX], ys[HALF_SITE_MAX];
+      X.load(xs, s);
+      Y.load(ys, s);
+      caxpby(a, (Complex*)xs, b, (Complex*)ys, X.Length()/2);
+      Y.save(ys, s);
+    }
+  };
+
+  void caxpbyHalf(const Complex &a, const cpuColorSpinorField &x,
+		  const Complex &b, cpuColorSpinorField &y) {
+    CaxpbyHalf f(a, x, b, y);
+    HalfBlas<CaxpbyHalf> blas(f, y, "caxpbyHalf", 1, 7ll*x.Length());
+    blas.apply(0);
+  }
+
   void caxpyCpu(const Complex &a, const cpuColorSpinorField &x,
 		cpuColorSpinorField &y) {
 
@@ -85,6 +255,8 @@ namespace quda {
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       caxpby((std::complex<float>)a, (std::complex<float>*)x.V(), std::complex<float>(1.0), 
 	     (std::complex<float>*)y.V(), x.Length()/2);
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      caxpbyHalf(a, x, Complex(1.0), y);
     else 
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -97,6 +269,8 @@ namespace quda {
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       caxpby((std::complex<float>)a, (std::complex<float>*)x.V(), (std::complex<float>)b, 
 	     (std::complex<float>*)y.V(), x.Length()/2);
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      caxpbyHalf(a, x, b, y);
     else 
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -112,6 +286,30 @@ namespace quda {
 
   }
 
+  struct CaxpbypczHalf {
+    const Complex a, b, c;
+    const HalfSites X, Y, Z;
+    CaxpbypczHalf(const Complex &a, const cpuColorSpinorField &x, const Complex &b,
+		  const cpuColorSpinorField &y, const Complex &c, cpuColorSpinorField &z)
+      : a(a), b(b), c(c), X(x), Y(y), Z(z) { }
+    void operator()(int s) const {
+      double xs[HALF_SITE_MAX], ys[HALF_SITE_MAX], zs[HALF_SITE_MAX];
+      X.load(xs, s);
+      Y.load(ys, s);
+      Z.load(zs, s);
+      caxpbypcz(a, (Complex*)xs, b, (Complex*)ys, c, (Complex*)zs, X.Length()/2);
+      Z.save(zs, s);
+    }
+  };
+
+  void caxpbypczHalf(const Complex &a, const cpuColorSpinorField &x,
+		     const Complex &b, const cpuColorSpinorField &y, 
+		     const Complex &c, cpuColorSpinorField &z) {
+    CaxpbypczHalf f(a, x, b, y, c, z);
+    HalfBlas<CaxpbypczHalf> blas(f, z, "caxpbypczHalf", 2, 11ll*x.Length());
+    blas.apply(0);
+  }
+
   void cxpaypbzCpu(const cpuColorSpinorField &x, const Complex &a, 
 		   const cpuColorSpinorField &y, const Complex &b,
 		   cpuColorSpinorField &z) {
@@ -122,6 +320,8 @@ namespace quda {
     else if (x.Precision() == QUDA_SINGLE_PRECISION)
       caxpbypcz(std::complex<float>(1, 0), (std::complex<float>*)x.V(), (std::complex<float>)a, (std::complex<float>*)y.V(), 
 		(std::complex<float>)b, (std::complex<float>*)z.V(), x.Length()/2);
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      caxpbypczHalf(Complex(1, 0), x, a, y, b, z);
     else 
       errorQuda("Precision type %d not implemented", x.Precision());
   }
@@ -150,6 +350,8 @@ namespace quda {
       caxpbypcz((std::complex<float>)a, (std::complex<float>*)x.V(), 
 		(std::complex<float>)b, (std::complex<float>*)y.V(), 
 		(std::complex<float>)(1.0f), (std::complex<float>*)z.V(), x.Length()/2);
+    else if (x.Precision() == QUDA_HALF_PRECISION)
+      caxpbypczHalf(a, x, b, y, Complex(1, 0), z);
     else 
       errorQuda("Precision type %d not implemented", x.Precision());
 
@@ -163,12 +365,28 @@ namespace quda {
     return norm2;
   }
 
+  struct NormHalf {
+    const HalfSites A;
+    NormHalf(const cpuColorSpinorField &a) : A(a) { }
+    double operator()(int s) const {
+      double as[HALF_SITE_MAX];
+      A.load(as, s);
+      return norm(as, A.Length());
+    }
+  };
+
+  double normHalf(const cpuColorSpinorField &a) {
+    return halfReduce<double>(NormHalf(a), a, "normHalf", 1, 2ll*a.Length());
+  }
+
   double normCpu(const cpuColorSpinorField &a) {
     double norm2 = 0.0;
     if (a.Precision() == QUDA_DOUBLE_PRECISION)
       norm2 = norm((double*)a.V(), a.Length());
     else if (a.Precision() == QUDA_SINGLE_PRECISION)
       norm2 = norm((float*)a.V(), a.Length());
+    else if (a.Precision() == QUDA_HALF_PRECISION)
+      norm2 = normHalf(a);
     else
       errorQuda("Precision type %d not implemented", a.Precision());
     reduceDouble(norm2);
@@ -188,12 +406,29 @@ namespace quda {
     return dot;
   }
 
+  struct ReDotProductHalf {
+    const HalfSites A, B;
+    ReDotProductHalf(const cpuColorSpinorField &a, const cpuColorSpinorField &b) : A(a), B(b) { }
+    double operator()(int s) const {
+      double as[HALF_SITE_MAX], bs[HALF_SITE_MAX];
+      A.load(as, s);
+      B.load(bs, s);
+      return reDotProduct(as, bs, A.Length());
+    }
+  };
+
+  double reDotProductHalf(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
+    return halfReduce<double>(ReDotProductHalf(a, b), a, "reDotProductHalf", 2, 2ll*a.Length());
+  }
+
   double reDotProductCpu(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
     double dot = 0.0;
     if (a.Precision() == QUDA_DOUBLE_PRECISION)
       dot = reDotProduct((double*)a.V(), (double*)b.V(), a.Length());
     else if (a.Precision() == QUDA_SINGLE_PRECISION)
       dot = reDotProduct((float*)a.V(), (float*)b.V(), a.Length());
+    else if (a.Precision() == QUDA_HALF_PRECISION)
+      dot = reDotProductHalf(a, b);
     else
       errorQuda("Precision type %d not implemented", a.Precision());
     reduceDouble(dot);
@@ -214,12 +449,29 @@ namespace quda {
     return dot;
   }
 
+  struct CDotProductHalf {
+    const HalfSites A, B;
+    CDotProductHalf(const cpuColorSpinorField &a, const cpuColorSpinorField &b) : A(a), B(b) { }
+    Complex operator()(int s) const {
+      double as[HALF_SITE_MAX], bs[HALF_SITE_MAX];
+      A.load(as, s);
+      B.load(bs, s);
+      return cDotProduct((Complex*)as, (Complex*)bs, A.Length()/2);
+    }
+  };
+
+  Complex cDotProductHalf(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
+    return halfReduce<Complex>(CDotProductHalf(a, b), a, "cDotProductHalf", 2, 4ll*a.Length());
+  }
+
   Complex cDotProductCpu(const cpuColorSpinorField &a, const cpuColorSpinorField &b) {
     Complex dot = 0.0;
     if (a.Precision() == QUDA_DOUBLE_PRECISION)
       dot = cDotProduct((Complex*)a.V(), (Complex*)b.V(), a.Length()/2);
     else if (a.Precision() == QUDA_SINGLE_PRECISION)
       dot = cDotProduct((std::complex<float>*)a.V(), (std::complex<float>*)b.V(), a.Length()/2);
+    else if (a.Precision() == QUDA_HALF_PRECISION)
+      dot = cDotProductHalf(a, b);
     else
       errorQuda("Precision type %d not implemented", a.Precision());
     reduceDoubleArray((double*)&dot, 2);
@@ -328,6 +580,33 @@ namespace quda {
   }
   
   
+  struct HeavyQuarkResidualNormHalf {
+    const HalfSites X, R;
+    HeavyQuarkResidualNormHalf(const cpuColorSpinorField &x, const cpuColorSpinorField &r) : X(x), R(r) { }
+    double3 operator()(int s) const {
+      double xs[HALF_SITE_MAX], rs[HALF_SITE_MAX];
+      X.load(xs, s);
+      R.load(rs, s);
+      return HeavyQuarkResidualNorm(xs, rs, 1, X.Length());
+    }
+  };
+
+  struct Double3Sum {
+    double3 operator()(const double3 &a, const double3 &b) const {
+      return make_double3(a.x + b.x, a.y + b.y, a.z + b.z);
+    }
+  };
+
+  double3 heavyQuarkResidualNormHalf(const cpuColorSpinorField &x, const cpuColorSpinorField &r) {
+    HalfSites X(x);
+    HeavyQuarkResidualNormHalf f(x, r);
+    TunableHostReduce<double3, HeavyQuarkResidualNormHalf, Double3Sum>
+      reduce(f, X.Sites(), make_double3(0.0, 0.0, 0.0),
+	     halfKey(x, "heavyQuarkResidualNormHalf"), 4ll*x.Length(), 2*X.Sites()*X.SiteBytes());
+    reduce.apply(0);
+    return reduce.result;
+  }
+  
   double3 HeavyQuarkResidualNormCpu(cpuColorSpinorField &x, cpuColorSpinorField &r) {
     double3 rtn;
     if (x.Precision() == QUDA_DOUBLE_PRECISION) {
@@ -336,6 +615,8 @@ namespace quda {
     } else if (x.Precision() == QUDA_SINGLE_PRECISION) {
       rtn = HeavyQuarkResidualNorm<float>((const float*)(x.V()), (const float*)(r.V()), 
 					  x.Volume(), 2*x.Ncolor()*x.Nspin());
+    } else if (x.Precision() == QUDA_HALF_PRECISION) {
+      rtn = heavyQuarkResidualNormHalf(x, r);
     } else {
       errorQuda("Precision type %d not implemented", x.Precision());
     }
@@ -28,6 +28,7 @@ namespace quda {
 
   unsigned long long blas_flops;
   unsigned long long blas_bytes;
+  double blas_reduce_secs;
 
   void zeroCuda(cudaColorSpinorField &a) { a.zero(); }
 
@@ -36,8 +37,28 @@ namespace quda {
   static struct {
     int x[QUDA_MAX_DIM];
     int stride;
+    char vol[64]; // tuneKey() strings
+    char aux[64];
   } blasConstants;
 
+  /**
+     Record the field geometry used by the kernels.  The volume and aux
+     strings used by tuneKey() are only rebuilt when the geometry
+     changes, rather than on every launch.
+  */
+  static void setBlasConstants(const cudaColorSpinorField &x)
+  {
+    bool changed = (blasConstants.stride != x.Stride());
+    for (int d=0; d<QUDA_MAX_DIM; d++) changed = changed || (blasConstants.x[d] != x.X()[d]);
+    if (!changed) return;
+
+    for (int d=0; d<QUDA_MAX_DIM; d++) blasConstants.x[d] = x.X()[d];
+    blasConstants.stride = x.Stride();
+    snprintf(blasConstants.vol, sizeof(blasConstants.vol), "%dx%dx%dx%d",
+	     blasConstants.x[0], blasConstants.x[1], blasConstants.x[2], blasConstants.x[3]);
+    snprintf(blasConstants.aux, sizeof(blasConstants.aux), "stride=%d,prec=", blasConstants.stride);
+  }
+
   void initReduce();
   void endReduce();
 
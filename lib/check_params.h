@@ -67,6 +67,11 @@ void printQudaGaugeParam(QudaGaugeParam *param) {
   P(gauge_order, QUDA_INVALID_GAUGE_ORDER);
   P(t_boundary, QUDA_INVALID_T_BOUNDARY);
   P(cpu_prec, QUDA_INVALID_PRECISION);
+#if defined INIT_PARAM
+  P(cpu_reconstruct, QUDA_RECONSTRUCT_NO);
+#else
+  P(cpu_reconstruct, QUDA_RECONSTRUCT_INVALID);
+#endif
   P(cuda_prec, QUDA_INVALID_PRECISION);
   P(reconstruct, QUDA_RECONSTRUCT_INVALID);
   P(cuda_prec_sloppy, QUDA_INVALID_PRECISION);
@@ -92,8 +97,10 @@ void printQudaGaugeParam(QudaGaugeParam *param) {
 
 #if defined INIT_PARAM
   P(preserve_gauge, 0);
+  P(fat_link_location, QUDA_CUDA_FIELD_LOCATION);
 #else
   P(preserve_gauge, INVALID_INT);
+  P(fat_link_location, QUDA_INVALID_FIELD_LOCATION);
 #endif
 
 #ifdef INIT_PARAM
@@ -287,6 +294,16 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(secs, INVALID_DOUBLE);
 #endif
 
+#ifdef INIT_PARAM
+  ret.telemetry = 0;
+  P(telemetry_size, 0);
+  P(telemetry_count, 0);
+#elif defined(PRINT_PARAM)
+  printfQuda("telemetry = %p\n", (void*)param->telemetry);
+  P(telemetry_size, INVALID_INT);
+  P(telemetry_count, INVALID_INT);
+#endif
+
 
 #ifdef INIT_PARAM
   //p(ghostDim[0],0);
@@ -3,18 +3,55 @@
 
 namespace quda {
 
-  template <typename Float>
-  ColorSpinorFieldOrder<Float>* createOrder(const cpuColorSpinorField &a) {
-    ColorSpinorFieldOrder<Float>* ptr=0;
-    if (a.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) 
-      ptr = new SpaceSpinColorOrder<Float>(const_cast<cpuColorSpinorField&>(a));
-    else if (a.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) 
-      ptr = new SpaceColorSpinOrder<Float>(const_cast<cpuColorSpinorField&>(a));
-    else if (a.FieldOrder() == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) 
-      ptr = new QOPDomainWallOrder<Float>(const_cast<cpuColorSpinorField&>(a));
-    else
+  /**
+     Construct the accessor for the order of a and apply the functor op
+     to it.  The functor is instantiated for every concrete order, so
+     the element accesses in its loops are resolved at compile time.
+  */
+  template <typename Float, typename Op>
+  void applyOrder(const cpuColorSpinorField &a, Op &op) {
+    cpuColorSpinorField &A = const_cast<cpuColorSpinorField&>(a);
+    if (a.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
+      SpaceSpinColorOrder<Float> order(A);
+      op(order);
+    } else if (a.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
+      SpaceColorSpinOrder<Float> order(A);
+      op(order);
+    } else if (a.FieldOrder() == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
+      QOPDomainWallOrder<Float> order(A);
+      op(order);
+    } else if (a.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER || a.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER) {
+      FloatNFieldOrder<Float> order(A);
+      op(order);
+    } else if (a.FieldOrder() == QUDA_AOSOA_FIELD_ORDER) {
+      AoSoAFieldOrder<Float> order(A);
+      op(order);
+    } else {
       errorQuda("Order %d not supported in cpuColorSpinorField", a.FieldOrder());
-    return ptr;
+    }
+  }
+
+  /**
+     Half precision fields are accessed through a single precision
+     copy, which is written back if the functor updates the field.
+  */
+  template <typename Op>
+  void applyOrder(const cpuColorSpinorField &a, Op &op, bool update=false) {
+    if (a.Precision() == QUDA_DOUBLE_PRECISION) {
+      applyOrder<double>(a, op);
+    } else if (a.Precision() == QUDA_SINGLE_PRECISION) {
+      applyOrder<float>(a, op);
+    } else if (a.Precision() == QUDA_HALF_PRECISION) {
+      ColorSpinorParam param(a);
+      param.precision = QUDA_SINGLE_PRECISION;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      cpuColorSpinorField tmp(param);
+      tmp.copy(a);
+      applyOrder<float>(tmp, op);
+      if (update) const_cast<cpuColorSpinorField&>(a).copy(tmp);
+    } else {
+      errorQuda("Precision %d not implemented", a.Precision());
+    }
   }
 
   // Random number insertion over all field elements
@@ -35,24 +72,20 @@ namespace quda {
   template <class T>
   void point(T &t, int x, int s, int c) { t(x, s, c, 0) = 1.0; }
 
-  void genericSource(cpuColorSpinorField &a, QudaSourceType sourceType, int x, int s, int c) {
-
-    if (a.Precision() == QUDA_DOUBLE_PRECISION) {
-      ColorSpinorFieldOrder<double> *A = createOrder<double>(a);
-      if (sourceType == QUDA_RANDOM_SOURCE) random(*A);
-      else if (sourceType == QUDA_POINT_SOURCE) point(*A, x, s, c);
-      else errorQuda("Unsupported source type %d", sourceType);
-      delete A;
-    } else if (a.Precision() == QUDA_SINGLE_PRECISION) {
-      ColorSpinorFieldOrder<float> *A = createOrder<float>(a);
-      if (sourceType == QUDA_RANDOM_SOURCE) random(*A);
-      else if (sourceType == QUDA_POINT_SOURCE) point(*A, x, s, c);
+  struct Source {
+    const QudaSourceType sourceType;
+    const int x, s, c;
+    Source(QudaSourceType sourceType, int x, int s, int c) : sourceType(sourceType), x(x), s(s), c(c) { }
+    template <class T> void operator()(T &t) const {
+      if (sourceType == QUDA_RANDOM_SOURCE) random(t);
+      else if (sourceType == QUDA_POINT_SOURCE) point(t, x, s, c);
       else errorQuda("Unsupported source type %d", sourceType);
-      delete A;
-    } else {
-      errorQuda("Precision not supported");
     }
+  };
 
+  void genericSource(cpuColorSpinorField &a, QudaSourceType sourceType, int x, int s, int c) {
+    Source source(sourceType, x, s, c);
+    applyOrder(a, source, true);
   }
 
 
@@ -60,7 +93,11 @@ namespace quda {
   int compareSpinor(const U &u, const V &v, const int tol) {
     int fail_check = 16*tol;
     int *fail = new int[fail_check];
-    for (int f=0; f<fail_check; f++) fail[f] = 0;
+    double *threshold = new double[fail_check];
+    for (int f=0; f<fail_check; f++) {
+      fail[f] = 0;
+      threshold[f] = pow(10.0,-(f+1)/(double)tol);
+    }
 
     int N = 2*u.Nspin()*u.Ncolor();
     int *iter = new int[N];
@@ -72,8 +109,8 @@ namespace quda {
 	  for (int z=0; z<2; z++) {
 	    double diff = fabs(u(x,s,c,z) - v(x,s,c,z));
 
-	    for (int f=0; f<fail_check; f++)
-	      if (diff > pow(10.0,-(f+1)/(double)tol)) fail[f]++;
+	    // the thresholds decrease with f, so stop at the first one from the end not exceeded
+	    for (int f=fail_check-1; f>=0 && diff > threshold[f]; f--) fail[f]++;
 
 	    int j = (s*u.Ncolor() + c)*2+z;
 	    if (diff > 1e-3) iter[j]++;
@@ -83,51 +120,49 @@ namespace quda {
     }
 
     for (int i=0; i<N; i++) printfQuda("%d fails = %d\n", i, iter[i]);
-    
+
     int accuracy_level =0;
     for (int f=0; f<fail_check; f++) {
       if (fail[f] == 0) accuracy_level = f+1;
     }
 
     for (int f=0; f<fail_check; f++) {
-      printfQuda("%e Failures: %d / %d  = %e\n", pow(10.0,-(f+1)/(double)tol), 
+      printfQuda("%e Failures: %d / %d  = %e\n", threshold[f],
 		 fail[f], u.Volume()*N, fail[f] / (double)(u.Volume()*N));
     }
-  
+
     delete []iter;
+    delete []threshold;
     delete []fail;
-  
+
     return accuracy_level;
   }
 
-  int genericCompare(const cpuColorSpinorField &a, const cpuColorSpinorField &b, int tol) {
-    int ret = 0;
-    if (a.Precision() == QUDA_DOUBLE_PRECISION) {
-      ColorSpinorFieldOrder<double> *A = createOrder<double>(a);
-      if (b.Precision() == QUDA_DOUBLE_PRECISION) {
-	ColorSpinorFieldOrder<double> *B = createOrder<double>(b);
-	ret = compareSpinor(*A, *B, tol);
-	delete B;
-      } else {
-	ColorSpinorFieldOrder<float> *B = createOrder<float>(b);
-	ret = compareSpinor(*A, *B, tol);
-	delete B;
-      }
-      delete A;
-    } else {
-      ColorSpinorFieldOrder<float> *A = createOrder<float>(a);
-      if (b.Precision() == QUDA_DOUBLE_PRECISION) {
-	ColorSpinorFieldOrder<double> *B = createOrder<double>(b);
-	ret = compareSpinor(*A, *B, tol);
-	delete B;
-      } else {
-	ColorSpinorFieldOrder<float> *B = createOrder<float>(b);
-	ret = compareSpinor(*A, *B, tol);
-	delete B;
-      }
-      delete A;
+  template <class U>
+  struct CompareTo {
+    const U &u;
+    const int tol;
+    int result;
+    CompareTo(const U &u, int tol) : u(u), tol(tol), result(0) { }
+    template <class V> void operator()(V &v) { result = compareSpinor(u, v, tol); }
+  };
+
+  struct Compare {
+    const cpuColorSpinorField &b;
+    const int tol;
+    int result;
+    Compare(const cpuColorSpinorField &b, int tol) : b(b), tol(tol), result(0) { }
+    template <class U> void operator()(U &u) {
+      CompareTo<U> compare(u, tol);
+      applyOrder(b, compare);
+      result = compare.result;
     }
-    return ret;
+  };
+
+  int genericCompare(const cpuColorSpinorField &a, const cpuColorSpinorField &b, int tol) {
+    Compare compare(b, tol);
+    applyOrder(a, compare);
+    return compare.result;
   }
 
 
@@ -146,21 +181,16 @@ namespace quda {
 
   }
 
+  struct PrintVector {
+    const unsigned int x;
+    PrintVector(unsigned int x) : x(x) { }
+    template <class T> void operator()(T &t) const { print_vector(t, x); }
+  };
+
   // print out the vector at volume point x
   void genericPrintVector(cpuColorSpinorField &a, unsigned int x) {
-  
-    if (a.Precision() == QUDA_DOUBLE_PRECISION) {
-      ColorSpinorFieldOrder<double> *A = createOrder<double>(a);
-      print_vector(*A, x);
-      delete A;
-    } else if (a.Precision() == QUDA_SINGLE_PRECISION) {
-      ColorSpinorFieldOrder<float> *A = createOrder<float>(a);
-      print_vector(*A, x);
-      delete A;
-    } else {
-      errorQuda("Precision %d not implemented", a.Precision()); 
-    }
-    
+    PrintVector print(x);
+    applyOrder(a, print);
   }
 
 
@@ -1,4 +1,5 @@
 #include <unistd.h> // for gethostname()
+#include <vector>
 
 #include <quda_internal.h>
 #include <comm_quda.h>
@@ -249,6 +250,7 @@ MsgHandle *comm_declare_receive_relative(void *buffer, int dim, int dir, size_t
 
 void comm_finalize(void)
 {
+  comm_release();
   Topology *topo = comm_default_topology();
   comm_destroy_topology(topo);
   comm_set_default_topology(NULL);
@@ -267,3 +269,117 @@ int comm_dim_partitioned(int dim)
 {
   return (manual_set_partition[dim] || (comm_dim(dim) > 1));
 }
+
+
+/**
+ * Find all ways of writing n as an ordered product of ndim factors,
+ * where factor i must divide limit[i].
+ */
+static void factorize(int n, int ndim, const int *limit, int dim, std::vector<int> &factor,
+		      std::vector< std::vector<int> > &result)
+{
+  if (dim == ndim-1) {
+    if (limit[dim] % n == 0) {
+      factor[dim] = n;
+      result.push_back(factor);
+    }
+    return;
+  }
+  for (int k = 1; k <= n; k++) {
+    if (n % k || limit[dim] % k) continue;
+    factor[dim] = k;
+    factorize(n/k, ndim, limit, dim+1, factor, result);
+  }
+}
+
+
+/**
+ * Relative cost of moving a halo byte between ranks on the same node
+ * compared to between nodes (shared memory vs. network).
+ */
+static const double intra_node_weight = 0.25;
+
+/**
+ * Cost of a process grid with a given intra-node block: the sum over
+ * partitioned dimensions of the per-rank face area, with faces that
+ * stay on the node weighted by intra_node_weight.
+ */
+static double grid_cost(int ndim, const int *lattice, const int *grid, const int *block)
+{
+  double cost = 0.0;
+  for (int d = 0; d < ndim; d++) {
+    if (grid[d] == 1) continue;
+    double area = 2.0;
+    for (int e = 0; e < ndim; e++) if (e != d) area *= lattice[e] / grid[e];
+    // each line of block[d] ranks has two faces that leave the node,
+    // unless the whole dimension lives on the node
+    double inter = (grid[d] == block[d]) ? 0.0 : 1.0 / block[d];
+    cost += area * (inter + intra_node_weight * (1.0 - inter));
+  }
+  return cost;
+}
+
+
+/**
+ * Choose the process grid for a given global lattice that minimizes
+ * halo traffic.  Ranks are assumed to be grouped into nodes of
+ * ranks_per_node processes, and each node is assigned a contiguous
+ * block of the process grid so that as many neighbours as possible
+ * share a node.  Ties are broken in favour of partitioning t, then z,
+ * and so on.
+ *
+ * @param ndim            Number of dimensions
+ * @param lattice         Global lattice dimensions
+ * @param nranks          Total number of processes
+ * @param ranks_per_node  Number of processes per node (1 if unknown)
+ * @param grid            Returned process grid
+ * @param node_block      Returned block of the process grid held by each node
+ * @return                Cost of the chosen grid (negative if no valid grid exists)
+ */
+double comm_auto_grid(int ndim, const int *lattice, int nranks, int ranks_per_node,
+		      int *grid, int *node_block)
+{
+  if (ndim > QUDA_MAX_DIM) errorQuda("ndim exceeds QUDA_MAX_DIM");
+  if (ranks_per_node < 1 || nranks % ranks_per_node) ranks_per_node = 1;
+
+  std::vector<int> factor(ndim);
+  std::vector< std::vector<int> > grids;
+  factorize(nranks, ndim, lattice, 0, factor, grids);
+
+  double best_cost = -1.0;
+  for (size_t i = 0; i < grids.size(); i++) {
+    const int *g = &grids[i][0];
+
+    // local lattice dimensions must be even for even-odd preconditioning
+    bool valid = true;
+    for (int d = 0; d < ndim; d++) if ((lattice[d] / g[d]) % 2) valid = false;
+    if (!valid) continue;
+
+    std::vector< std::vector<int> > blocks;
+    factorize(ranks_per_node, ndim, g, 0, factor, blocks);
+
+    for (size_t j = 0; j < blocks.size(); j++) {
+      const int *b = &blocks[j][0];
+      double cost = grid_cost(ndim, lattice, g, b);
+
+      bool better = (best_cost < 0.0 || cost < best_cost);
+      if (!better && cost == best_cost) {
+	for (int d = ndim-1; d >= 0; d--) {
+	  if (g[d] == grid[d]) continue;
+	  better = (g[d] > grid[d]);
+	  break;
+	}
+      }
+
+      if (better) {
+	best_cost = cost;
+	for (int d = 0; d < ndim; d++) {
+	  grid[d] = g[d];
+	  node_block[d] = b[d];
+	}
+      }
+    }
+  }
+
+  return best_cost;
+}
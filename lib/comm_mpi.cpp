@@ -1,7 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <fcntl.h>    // for O_* constants
+#include <sys/mman.h> // for shm_open(), mmap()
 #include <mpi.h>
+#include <vector>
 
 #include <quda_internal.h>
 #include <comm_quda.h>
@@ -19,8 +23,48 @@
 } while (0)
 
 
+/**
+ * A shared-memory channel carries the messages travelling in one
+ * direction of one dimension from a rank to its neighbour on the same
+ * node.  It is a ring of SHM_SLOTS slots of SHM_SLOT_BYTES each,
+ * preceded by one control block per slot.  The n-th message on a
+ * channel (counting from one) uses slot n % SHM_SLOTS: the sender
+ * waits until the "ack" of the slot has reached n - SHM_SLOTS, deposits
+ * the message and sets "seq" to n; the receiver waits until "seq" is n,
+ * copies the message out and sets "ack" to n.  Sends and receives are
+ * matched in the order in which they are started, as MPI matches
+ * messages with the same source and tag, and several may be
+ * outstanding at once: waiting on any message advances all the
+ * started shared-memory messages of the process, in the manner of an
+ * MPI progress engine.  Messages larger than a slot go through MPI.
+ * The pages of a slot are only touched once a message is placed in it,
+ * so the resident size of a channel follows the messages sent.
+ */
+#define SHM_SLOTS 4
+#define SHM_SLOT_BYTES (8ul << 20)
+
+struct ShmSlot {
+  volatile unsigned long seq;
+  char pad0[64 - sizeof(unsigned long)];
+  volatile unsigned long ack;
+  char pad1[64 - sizeof(unsigned long)];
+};
+
+struct ShmChannel {
+  ShmSlot *slot;        // control blocks
+  char *data;           // message slots
+  unsigned long posted; // sequence number of the last message started at this end
+  std::vector<MsgHandle*> pending; // started messages, in sequence order
+};
+
 struct MsgHandle_s {
   MPI_Request request;
+  ShmChannel *shm;      // non-NULL if the message goes through shared memory
+  bool send;            // are we the sender or the receiver?
+  void *buffer;         // user buffer (only used for shared-memory messages)
+  size_t nbytes;
+  unsigned long seq;    // sequence number of the message on the channel
+  bool active;          // started but not yet completed
 };
 
 
@@ -28,6 +72,176 @@ static int rank = -1;
 static int size = -1;
 static int gpuid = -1;
 
+// per-rank flag set if the given rank shares our node
+static bool *same_node = NULL;
+static bool shm_enabled = false;
+
+// channels to and from the nearest neighbours, indexed by dimension
+// and by the direction (0 backwards, 1 forwards) the messages travel
+static ShmChannel *shm_send[QUDA_MAX_DIM][2];
+static ShmChannel *shm_recv[QUDA_MAX_DIM][2];
+
+
+static size_t comm_shm_bytes(void)
+{
+  return SHM_SLOTS * (sizeof(ShmSlot) + SHM_SLOT_BYTES);
+}
+
+
+static void comm_shm_name(char *name, size_t len, long token, int src, int dim, int dir)
+{
+  snprintf(name, len, "/quda_%ld_%d_%d_%c", token, src, dim, dir ? 'f' : 'b');
+}
+
+
+static ShmChannel *comm_shm_map(int fd)
+{
+  void *ptr = mmap(NULL, comm_shm_bytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) return NULL;
+
+  ShmChannel *ch = new ShmChannel;
+  ch->slot = (ShmSlot *)ptr;
+  ch->data = (char *)ptr + SHM_SLOTS*sizeof(ShmSlot);
+  ch->posted = 0;
+  return ch;
+}
+
+
+/**
+ * Create the segment of a channel we send on.  A segment of the same
+ * name left behind by a crashed job is removed first, and the control
+ * blocks of the new one are zeroed.  Returns NULL on failure.
+ */
+static ShmChannel *comm_shm_create(const char *name)
+{
+  shm_unlink(name);
+  int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1) return NULL;
+  if (ftruncate(fd, comm_shm_bytes()) == -1) {
+    close(fd);
+    shm_unlink(name);
+    return NULL;
+  }
+  ShmChannel *ch = comm_shm_map(fd);
+  if (!ch) {
+    shm_unlink(name);
+    return NULL;
+  }
+  memset(ch->slot, 0, SHM_SLOTS*sizeof(ShmSlot));
+  return ch;
+}
+
+
+/** Attach to the segment of a channel we receive on, or return NULL */
+static ShmChannel *comm_shm_attach(const char *name)
+{
+  int fd = shm_open(name, O_RDWR, 0600);
+  if (fd == -1) return NULL;
+  return comm_shm_map(fd);
+}
+
+
+static void comm_shm_release(void)
+{
+  for (int i = 0; i < QUDA_MAX_DIM; i++) {
+    for (int j = 0; j < 2; j++) {
+      ShmChannel *ch[2] = { shm_send[i][j], shm_recv[i][j] };
+      for (int k = 0; k < 2; k++) {
+	if (!ch[k]) continue;
+	munmap(ch[k]->slot, comm_shm_bytes());
+	delete ch[k];
+      }
+      shm_send[i][j] = NULL;
+      shm_recv[i][j] = NULL;
+    }
+  }
+  shm_enabled = false;
+}
+
+
+/**
+ * Set up the channels to the nearest neighbours that share our node.
+ * Each rank creates the segments it sends on, and after a barrier
+ * attaches to those it receives on; the names are then unlinked, so
+ * nothing is left in /dev/shm even if the job dies.  If any rank fails
+ * to set up a channel, all messages go through MPI.
+ */
+static void comm_shm_init(void)
+{
+  long token = (long)getpid();
+  MPI_CHECK( MPI_Bcast(&token, 1, MPI_LONG, 0, MPI_COMM_WORLD) );
+
+  Topology *topo = comm_default_topology();
+  int ndim = comm_ndim(topo);
+  int ok = 1;
+  char name[128];
+
+  for (int i = 0; i < ndim; i++) {
+    for (int j = 0; j < 2; j++) {
+      int disp[QUDA_MAX_DIM] = {0};
+      disp[i] = j ? +1 : -1;
+      int dst = comm_rank_displaced(topo, disp);
+      if (dst == rank || !same_node[dst]) continue;
+      comm_shm_name(name, sizeof(name), token, rank, i, j);
+      shm_send[i][j] = comm_shm_create(name);
+      if (!shm_send[i][j]) ok = 0;
+    }
+  }
+
+  MPI_CHECK( MPI_Barrier(MPI_COMM_WORLD) );
+
+  for (int i = 0; i < ndim; i++) {
+    for (int j = 0; j < 2; j++) {
+      int disp[QUDA_MAX_DIM] = {0};
+      disp[i] = j ? -1 : +1; // messages travelling forwards come from behind
+      int src = comm_rank_displaced(topo, disp);
+      if (src == rank || !same_node[src]) continue;
+      comm_shm_name(name, sizeof(name), token, src, i, j);
+      shm_recv[i][j] = comm_shm_attach(name);
+      if (!shm_recv[i][j]) ok = 0;
+    }
+  }
+
+  MPI_CHECK( MPI_Barrier(MPI_COMM_WORLD) );
+
+  for (int i = 0; i < ndim; i++) {
+    for (int j = 0; j < 2; j++) {
+      comm_shm_name(name, sizeof(name), token, rank, i, j);
+      if (shm_send[i][j]) shm_unlink(name);
+    }
+  }
+
+  int all_ok;
+  MPI_CHECK( MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD) );
+  if (!all_ok) {
+    if (rank == 0) warningQuda("Failed to set up shared-memory channels; using MPI for all messages");
+    comm_shm_release();
+  }
+}
+
+
+/**
+ * Return the channel for a message travelling with the given
+ * displacement, or NULL if the message goes through MPI.  Both ends
+ * of a message must declare the same size.
+ */
+static ShmChannel *comm_shm_channel(ShmChannel *table[][2], const int displacement[], size_t nbytes)
+{
+  if (!shm_enabled || nbytes > SHM_SLOT_BYTES) return NULL;
+
+  int ndim = comm_ndim(comm_default_topology());
+  int dim = -1;
+  for (int i = 0; i < ndim; i++) {
+    if (displacement[i] == 0) continue;
+    if (dim >= 0 || abs(displacement[i]) != 1) return NULL; // not a nearest neighbour
+    dim = i;
+  }
+  if (dim < 0) return NULL;
+
+  return table[dim][displacement[dim] > 0 ? 1 : 0];
+}
+
 
 void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data)
 {
@@ -52,6 +266,7 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
 
   Topology *topo = comm_create_topology(ndim, dims, rank_from_coords, map_data);
   comm_set_default_topology(topo);
+  comm_profile_init();
 
   // determine which GPU this MPI rank will use
 
@@ -66,8 +281,19 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
       gpuid++;
     }
   }
+
+  // record which ranks share our node, to be used by the shared-memory transport
+  same_node = (bool *)safe_malloc(size*sizeof(bool));
+  for (int i = 0; i < size; i++) {
+    same_node[i] = !strncmp(hostname, &hostname_recv_buf[128*i], 128);
+  }
   host_free(hostname_recv_buf);
 
+  // shared-memory halo exchange is enabled unless explicitly disabled
+  char *disable_shm = getenv("QUDA_DISABLE_SHM_COMMS");
+  shm_enabled = !(disable_shm && strcmp(disable_shm, "0"));
+  if (shm_enabled) comm_shm_init();
+
   int device_count;
   cudaGetDeviceCount(&device_count);
   if (device_count == 0) {
@@ -79,6 +305,55 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
 }
 
 
+/**
+ * Number of processes, available prior to comm_init()
+ */
+int comm_world_size(void)
+{
+  int world_size;
+  MPI_CHECK( MPI_Comm_size(MPI_COMM_WORLD, &world_size) );
+  return world_size;
+}
+
+
+/**
+ * Rank of this process, available prior to comm_init()
+ */
+int comm_world_rank(void)
+{
+  int world_rank;
+  MPI_CHECK( MPI_Comm_rank(MPI_COMM_WORLD, &world_rank) );
+  return world_rank;
+}
+
+
+/**
+ * Assign every process a node index, numbering hosts in order of
+ * their lowest rank.  Available prior to comm_init().
+ */
+void comm_world_nodes(int *node_id)
+{
+  int world_size = comm_world_size();
+  char *hostname = comm_hostname();
+  char *hostname_recv_buf = (char *)safe_malloc(128*world_size);
+
+  MPI_CHECK( MPI_Allgather(hostname, 128, MPI_CHAR, hostname_recv_buf, 128, MPI_CHAR, MPI_COMM_WORLD) );
+
+  int nodes = 0;
+  for (int i = 0; i < world_size; i++) {
+    node_id[i] = nodes;
+    for (int j = 0; j < i; j++) {
+      if (!strncmp(&hostname_recv_buf[128*i], &hostname_recv_buf[128*j], 128)) {
+	node_id[i] = node_id[j];
+	break;
+      }
+    }
+    if (node_id[i] == nodes) nodes++;
+  }
+  host_free(hostname_recv_buf);
+}
+
+
 int comm_rank(void)
 {
   return rank;
@@ -107,7 +382,16 @@ MsgHandle *comm_declare_send_displaced(void *buffer, const int displacement[], s
   int rank = comm_rank_displaced(topo, displacement);
   int tag = comm_rank();
   MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
-  MPI_CHECK( MPI_Send_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
+  mh->send = true;
+  mh->buffer = buffer;
+  mh->nbytes = nbytes;
+  mh->active = false;
+
+  mh->shm = comm_shm_channel(shm_send, displacement, nbytes);
+  if (!mh->shm) {
+    MPI_CHECK( MPI_Send_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
+  }
+  comm_profile_declare(mh, displacement, nbytes, 1);
 
   return mh;
 }
@@ -123,7 +407,19 @@ MsgHandle *comm_declare_receive_displaced(void *buffer, const int displacement[]
   int rank = comm_rank_displaced(topo, displacement);
   int tag = rank;
   MsgHandle *mh = (MsgHandle *)safe_malloc(sizeof(MsgHandle));
-  MPI_CHECK( MPI_Recv_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
+  mh->send = false;
+  mh->buffer = buffer;
+  mh->nbytes = nbytes;
+  mh->active = false;
+
+  // the message travels opposite to the displacement of its source
+  int send_disp[QUDA_MAX_DIM] = {0};
+  for (int i = 0; i < comm_ndim(topo); i++) send_disp[i] = -displacement[i];
+  mh->shm = comm_shm_channel(shm_recv, send_disp, nbytes);
+  if (!mh->shm) {
+    MPI_CHECK( MPI_Recv_init(buffer, nbytes, MPI_BYTE, rank, tag, MPI_COMM_WORLD, &(mh->request)) );
+  }
+  comm_profile_declare(mh, displacement, nbytes, 0);
 
   return mh;
 }
@@ -131,73 +427,201 @@ MsgHandle *comm_declare_receive_displaced(void *buffer, const int displacement[]
 
 void comm_free(MsgHandle *mh)
 {
+  comm_profile_free(mh);
+  if (mh->shm && mh->active) errorQuda("Shared-memory message freed before completion");
+  if (!mh->shm) MPI_CHECK( MPI_Request_free(&(mh->request)) );
   host_free(mh);
 }
 
 
+/**
+ * Try to complete a shared-memory message: a send deposits the message
+ * once its slot has been drained, a receive copies it out once it has
+ * arrived.  Returns 1 when the message is complete.
+ */
+static int comm_shm_complete(MsgHandle *mh)
+{
+  ShmSlot *slot = mh->shm->slot + mh->seq % SHM_SLOTS;
+  char *data = mh->shm->data + (mh->seq % SHM_SLOTS) * SHM_SLOT_BYTES;
+
+  if (mh->send) {
+    if (slot->ack + SHM_SLOTS < mh->seq) return 0; // the slot still holds an earlier message
+    __sync_synchronize();
+    memcpy(data, mh->buffer, mh->nbytes);
+    __sync_synchronize(); // data must be visible before the sequence number
+    slot->seq = mh->seq;
+  } else {
+    if (slot->seq != mh->seq) return 0;
+    __sync_synchronize();
+    memcpy(mh->buffer, data, mh->nbytes);
+    __sync_synchronize(); // finish reading before releasing the slot
+    slot->ack = mh->seq;
+  }
+  mh->active = false;
+
+  return 1;
+}
+
+
+/** Advance every started shared-memory message */
+static void comm_shm_progress(void)
+{
+  for (int i = 0; i < QUDA_MAX_DIM; i++) {
+    for (int j = 0; j < 2; j++) {
+      ShmChannel *ch[2] = { shm_send[i][j], shm_recv[i][j] };
+      for (int k = 0; k < 2; k++) {
+	if (!ch[k]) continue;
+	std::vector<MsgHandle*> &pending = ch[k]->pending;
+	unsigned int n = 0;
+	for (unsigned int m = 0; m < pending.size(); m++) {
+	  if (!comm_shm_complete(pending[m])) pending[n++] = pending[m];
+	}
+	pending.resize(n);
+      }
+    }
+  }
+}
+
+
+/**
+ * Shared-memory sends are single-copy: the message is deposited
+ * directly into its slot, here if the slot is free and otherwise in
+ * comm_query() / comm_wait().  Receives take the next sequence number
+ * of the channel; the copy out happens in comm_query() / comm_wait().
+ */
 void comm_start(MsgHandle *mh)
 {
-  MPI_CHECK( MPI_Start(&(mh->request)) );
+  comm_profile_start(mh);
+
+  if (!mh->shm) {
+    MPI_CHECK( MPI_Start(&(mh->request)) );
+    return;
+  }
+
+  mh->seq = ++mh->shm->posted;
+  mh->active = true;
+  if (!mh->send || !comm_shm_complete(mh)) mh->shm->pending.push_back(mh);
 }
 
 
-void comm_wait(MsgHandle *mh)
+/**
+ * A message that is not complete advances the other transport too:
+ * the peer of a shared-memory message may itself be waiting for MPI
+ * to progress one of our messages, and vice versa.  MPI_Iprobe() is
+ * used only to drive MPI progress.
+ */
+static int comm_query_(MsgHandle *mh) 
 {
-  MPI_CHECK( MPI_Wait(&(mh->request), MPI_STATUS_IGNORE) );
+  if (!mh->shm) {
+    int query;
+    MPI_CHECK( MPI_Test(&(mh->request), &query, MPI_STATUS_IGNORE) );
+    if (!query && shm_enabled) comm_shm_progress();
+    return query;
+  }
+
+  if (mh->active) {
+    comm_shm_progress();
+    int flag;
+    MPI_CHECK( MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE) );
+  }
+  return !mh->active;
 }
 
 
 int comm_query(MsgHandle *mh) 
 {
-  int query;
-  MPI_CHECK( MPI_Test(&(mh->request), &query, MPI_STATUS_IGNORE) );
-
+  int query = comm_query_(mh);
+  if (query) comm_profile_complete(mh, 0.0);
   return query;
 }
 
 
+void comm_wait(MsgHandle *mh)
+{
+  double start = comm_profile_time();
+
+  if (!mh->shm && !shm_enabled) {
+    MPI_CHECK( MPI_Wait(&(mh->request), MPI_STATUS_IGNORE) );
+  } else {
+    while (!comm_query_(mh)) { }
+  }
+
+  comm_profile_complete(mh, comm_profile_time() - start);
+}
+
+
 void comm_allreduce(double* data)
 {
+  double start = comm_profile_time();
   double recvbuf;
   MPI_CHECK( MPI_Allreduce(data, &recvbuf, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD) );
   *data = recvbuf;
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE, sizeof(double), start);
 } 
 
 
 void comm_allreduce_max(double* data)
 {
+  double start = comm_profile_time();
   double recvbuf;
   MPI_CHECK( MPI_Allreduce(data, &recvbuf, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD) );
   *data = recvbuf;
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE_MAX, sizeof(double), start);
 } 
 
 
 void comm_allreduce_array(double* data, size_t size)
 {
+  double start = comm_profile_time();
   double recvbuf[size];
   MPI_CHECK( MPI_Allreduce(data, &recvbuf, size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD) );
   memcpy(data, recvbuf, sizeof(recvbuf));
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE_ARRAY, size*sizeof(double), start);
 }
 
 
 void comm_allreduce_int(int* data)
 {
+  double start = comm_profile_time();
   int recvbuf;
   MPI_CHECK( MPI_Allreduce(data, &recvbuf, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD) );
   *data = recvbuf;
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE_INT, sizeof(int), start);
 }
 
 
 /**  broadcast from rank 0 */
 void comm_broadcast(void *data, size_t nbytes)
 {
+  double start = comm_profile_time();
   MPI_CHECK( MPI_Bcast(data, (int)nbytes, MPI_BYTE, 0, MPI_COMM_WORLD) );
+  comm_profile_collective(QUDA_COMM_PROFILE_BROADCAST, nbytes, start);
+}
+
+
+/**  gather nbytes from every rank into recv, ordered by rank, on all ranks */
+void comm_allgather(void *recv, const void *send, size_t nbytes)
+{
+  double start = comm_profile_time();
+  MPI_CHECK( MPI_Allgather(const_cast<void*>(send), (int)nbytes, MPI_BYTE, recv, (int)nbytes, MPI_BYTE,
+			   MPI_COMM_WORLD) );
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLGATHER, nbytes, start);
 }
 
 
 void comm_barrier(void)
 {
+  double start = comm_profile_time();
   MPI_CHECK( MPI_Barrier(MPI_COMM_WORLD) );
+  comm_profile_collective(QUDA_COMM_PROFILE_BARRIER, 0, start);
+}
+
+
+void comm_release(void)
+{
+  comm_shm_release();
+  if (same_node) host_free(same_node);
+  same_node = NULL;
 }
 
 
@@ -0,0 +1,253 @@
+/**
+ * Communication profiler.  When the environment variable
+ * QUDA_ENABLE_COMM_PROFILE is set, every message handle and
+ * collective is timed, and the results are aggregated into
+ * histograms per dimension and direction.  Setting QUDA_COMM_TRACE to
+ * a path prefix additionally writes one trace line per message to
+ * <prefix>.<rank>.  The comms backends call the hooks below; when
+ * profiling is disabled each hook is a single branch.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <map>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+
+
+namespace {
+
+  const int nbin = 24; // log2 bins: <1, [1,2), [2,4), ... (us for latency, MB/s for bandwidth)
+
+  // message categories: (dim, dir) pairs, followed by general displacements
+  const int ncat_dir = 2*QUDA_MAX_DIM + 1;
+  const int ncat_msg = 2*ncat_dir; // send and receive
+
+  const int ncat_coll = QUDA_COMM_PROFILE_COLLECTIVE_COUNT;
+
+  const char *coll_name[] = { "allreduce", "allreduce_max", "allreduce_array",
+			      "allreduce_int", "broadcast", "allgather", "barrier" };
+
+  struct Stats {
+    double count;
+    double bytes;
+    double latency;    // total start -> complete time
+    double wait;       // total time spent blocked in comm_wait()
+    double latency_hist[nbin];
+    double bandwidth_hist[nbin];
+  };
+
+  struct Record {
+    int category;
+    size_t nbytes;
+    bool active;
+    double start;
+  };
+
+  bool enabled = false;
+  bool suspended = false; // don't profile the profiler's own reductions
+  double t0 = 0.0;
+  FILE *trace = NULL;
+
+  Stats msg_stats[ncat_msg];
+  double msg_latency_max[ncat_msg];
+  Stats coll_stats[ncat_coll];
+  double coll_latency_max[ncat_coll];
+  std::map<const MsgHandle*, Record> records;
+
+  double wtime()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9*ts.tv_nsec;
+  }
+
+  int bin(double x)
+  {
+    int b = 0;
+    while (x >= 1.0 && b < nbin-1) { x *= 0.5; b++; }
+    return b;
+  }
+
+  void record(Stats &s, size_t nbytes, double latency, double wait)
+  {
+    s.count += 1;
+    s.bytes += nbytes;
+    s.latency += latency;
+    s.wait += wait;
+    s.latency_hist[bin(1e6*latency)] += 1;
+    if (latency > 0.0) s.bandwidth_hist[bin(1e-6*nbytes/latency)] += 1;
+  }
+
+  void printHist(const char *label, const double *hist)
+  {
+    char line[1024];
+    int len = sprintf(line, "       %-14s", label);
+    for (int b=0; b<nbin; b++) {
+      if (hist[b] == 0) continue;
+      if (b == 0) len += sprintf(line+len, " <1:%.0f", hist[b]);
+      else len += sprintf(line+len, " %d-%d:%.0f", 1 << (b-1), 1 << b, hist[b]);
+      if (len > 900) break;
+    }
+    printfQuda("%s\n", line);
+  }
+
+  void printStats(const char *label, const Stats &s, double latency_max)
+  {
+    if (s.count == 0) return;
+    double gbytes = s.latency > 0.0 ? 1e-9 * s.bytes / s.latency : 0.0;
+    printfQuda("     %-22s %9.0f msgs %11.4e bytes, latency mean %9.2f us max %9.2f us, "
+	       "wait mean %9.2f us, %8.3f GB/s\n", label, s.count, s.bytes,
+	       1e6*s.latency/s.count, 1e6*latency_max, 1e6*s.wait/s.count, gbytes);
+    printHist("latency [us]", s.latency_hist);
+    printHist("bandwidth [MB/s]", s.bandwidth_hist);
+  }
+
+} // anonymous namespace
+
+
+void comm_profile_init(void)
+{
+  char *enable = getenv("QUDA_ENABLE_COMM_PROFILE");
+  char *trace_path = getenv("QUDA_COMM_TRACE");
+  enabled = (enable && strcmp(enable, "0")) || trace_path;
+  if (!enabled) return;
+
+  memset(msg_stats, 0, sizeof(msg_stats));
+  memset(msg_latency_max, 0, sizeof(msg_latency_max));
+  memset(coll_stats, 0, sizeof(coll_stats));
+  memset(coll_latency_max, 0, sizeof(coll_latency_max));
+  records.clear();
+  t0 = wtime();
+
+  if (trace_path && !trace) {
+    char name[1024];
+    snprintf(name, sizeof(name), "%s.%d", trace_path, comm_rank());
+    trace = fopen(name, "w");
+    if (!trace) warningQuda("Unable to open comms trace file %s", name);
+    else fprintf(trace, "# start(s)\tend(s)\tdim\tdir\ttype\tbytes\twait(s)\n");
+  }
+}
+
+
+int comm_profile_enabled(void)
+{
+  return enabled && !suspended;
+}
+
+
+void comm_profile_declare(const MsgHandle *mh, const int displacement[], size_t nbytes, int send)
+{
+  if (!comm_profile_enabled()) return;
+
+  // classify as a (dim, dir) pair if displaced along a single dimension
+  int ndim = comm_ndim(comm_default_topology());
+  int dim = -1, nonzero = 0;
+  for (int i=0; i<ndim; i++) {
+    if (displacement[i]) { dim = i; nonzero++; }
+  }
+  int cat = (nonzero == 1) ? 2*dim + (displacement[dim] > 0 ? 1 : 0) : ncat_dir - 1;
+
+  Record r;
+  r.category = 2*cat + (send ? 0 : 1);
+  r.nbytes = nbytes;
+  r.active = false;
+  r.start = 0.0;
+  records[mh] = r;
+}
+
+
+void comm_profile_start(const MsgHandle *mh)
+{
+  if (!comm_profile_enabled()) return;
+  std::map<const MsgHandle*, Record>::iterator it = records.find(mh);
+  if (it == records.end()) return;
+  it->second.active = true;
+  it->second.start = wtime();
+}
+
+
+void comm_profile_complete(const MsgHandle *mh, double wait)
+{
+  if (!comm_profile_enabled()) return;
+  std::map<const MsgHandle*, Record>::iterator it = records.find(mh);
+  if (it == records.end() || !it->second.active) return;
+
+  Record &r = it->second;
+  double end = wtime();
+  double latency = end - r.start;
+  record(msg_stats[r.category], r.nbytes, latency, wait);
+  if (latency > msg_latency_max[r.category]) msg_latency_max[r.category] = latency;
+  r.active = false;
+
+  if (trace) {
+    int cat = r.category / 2;
+    int dim = (cat == ncat_dir - 1) ? -1 : cat / 2;
+    int dir = (cat == ncat_dir - 1) ? 0 : (cat % 2 ? +1 : -1);
+    fprintf(trace, "%.9f\t%.9f\t%d\t%+d\t%s\t%lu\t%.9f\n", r.start - t0, end - t0, dim, dir,
+	    r.category % 2 ? "recv" : "send", (unsigned long)r.nbytes, wait);
+  }
+}
+
+
+void comm_profile_free(const MsgHandle *mh)
+{
+  if (!enabled) return;
+  records.erase(mh);
+}
+
+
+double comm_profile_time(void)
+{
+  return comm_profile_enabled() ? wtime() : 0.0;
+}
+
+
+void comm_profile_collective(QudaCommProfileCollective type, size_t nbytes, double start)
+{
+  if (!comm_profile_enabled()) return;
+  double latency = wtime() - start;
+  record(coll_stats[type], nbytes, latency, latency);
+  if (latency > coll_latency_max[type]) coll_latency_max[type] = latency;
+}
+
+
+/**
+ * Sum the statistics over all ranks and print them.  This must be
+ * called collectively.
+ */
+void comm_profile_print(void)
+{
+  if (!enabled) return;
+  suspended = true;
+
+  const int stat_len = sizeof(Stats)/sizeof(double);
+  comm_allreduce_array((double*)msg_stats, ncat_msg*stat_len);
+  comm_allreduce_array((double*)coll_stats, ncat_coll*stat_len);
+  for (int i=0; i<ncat_msg; i++) comm_allreduce_max(&msg_latency_max[i]);
+  for (int i=0; i<ncat_coll; i++) comm_allreduce_max(&coll_latency_max[i]);
+
+  const char *dims = "xyzt5";
+  printfQuda("\n   Communication profile (summed over %d ranks)\n", comm_size());
+  for (int cat=0; cat<ncat_dir; cat++) {
+    for (int type=0; type<2; type++) {
+      char label[64];
+      if (cat == ncat_dir - 1) sprintf(label, "other %s", type ? "recv" : "send");
+      else sprintf(label, "%c %s %s", dims[cat/2], cat % 2 ? "fwd" : "back", type ? "recv" : "send");
+      printStats(label, msg_stats[2*cat+type], msg_latency_max[2*cat+type]);
+    }
+  }
+  for (int i=0; i<ncat_coll; i++) {
+    printStats(coll_name[i], coll_stats[i], coll_latency_max[i]);
+  }
+
+  if (trace) {
+    fclose(trace);
+    trace = NULL;
+  }
+
+  suspended = false;
+  enabled = false;
+}
@@ -1,3 +1,4 @@
+#include <string.h>
 #include <qmp.h>
 
 #include <quda_internal.h>
@@ -37,6 +38,7 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
 
   Topology *topo = comm_create_topology(ndim, dims, rank_from_coords, map_data);
   comm_set_default_topology(topo);
+  comm_profile_init();
 
   // determine which GPU this process will use (FIXME: adopt the scheme in comm_mpi.cpp)
 
@@ -50,6 +52,28 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
 }
 
 
+int comm_world_size(void)
+{
+  return QMP_get_number_of_nodes();
+}
+
+
+int comm_world_rank(void)
+{
+  return QMP_get_node_number();
+}
+
+
+/**
+ * QMP provides no way to identify which processes share a host, so
+ * every process is treated as its own node.
+ */
+void comm_world_nodes(int *node_id)
+{
+  for (int i = 0; i < QMP_get_number_of_nodes(); i++) node_id[i] = i;
+}
+
+
 int comm_rank(void)
 {
   return QMP_get_node_number();
@@ -83,6 +107,7 @@ MsgHandle *comm_declare_send_displaced(void *buffer, const int displacement[], s
 
   mh->handle = QMP_declare_send_to(mh->mem, rank, 0);
   if (mh->handle == NULL) errorQuda("Unable to allocate QMP message handle");
+  comm_profile_declare(mh, displacement, nbytes, 1);
 
   return mh;
 }
@@ -103,6 +128,7 @@ MsgHandle *comm_declare_receive_displaced(void *buffer, const int displacement[]
 
   mh->handle = QMP_declare_receive_from(mh->mem, rank, 0);
   if (mh->handle == NULL) errorQuda("Unable to allocate QMP message handle");
+  comm_profile_declare(mh, displacement, nbytes, 0);
 
   return mh;
 }
@@ -110,6 +136,7 @@ MsgHandle *comm_declare_receive_displaced(void *buffer, const int displacement[]
 
 void comm_free(MsgHandle *mh)
 {
+  comm_profile_free(mh);
   QMP_free_msghandle(mh->handle);
   QMP_free_msgmem(mh->mem);
   host_free(mh);
@@ -118,55 +145,100 @@ void comm_free(MsgHandle *mh)
 
 void comm_start(MsgHandle *mh)
 {
+  comm_profile_start(mh);
   QMP_CHECK( QMP_start(mh->handle) );
 }
 
 
 void comm_wait(MsgHandle *mh)
 {
+  double start = comm_profile_time();
   QMP_CHECK( QMP_wait(mh->handle) ); 
+  comm_profile_complete(mh, comm_profile_time() - start);
 }
 
 
 int comm_query(MsgHandle *mh) 
 {
-  return (QMP_is_complete(mh->handle) == QMP_TRUE);
+  int query = (QMP_is_complete(mh->handle) == QMP_TRUE);
+  if (query) comm_profile_complete(mh, 0.0);
+  return query;
 }
 
 
 void comm_allreduce(double* data)
 {
+  double start = comm_profile_time();
   QMP_CHECK( QMP_sum_double(data) );
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE, sizeof(double), start);
 } 
 
 
 void comm_allreduce_max(double* data)
 {
+  double start = comm_profile_time();
   QMP_CHECK( QMP_max_double(data) );
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE_MAX, sizeof(double), start);
 } 
 
 
 void comm_allreduce_array(double* data, size_t size)
 {
+  double start = comm_profile_time();
   QMP_CHECK( QMP_sum_double_array(data, size) );
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE_ARRAY, size*sizeof(double), start);
 }
 
 
 void comm_allreduce_int(int* data)
 {
+  double start = comm_profile_time();
   QMP_CHECK( QMP_sum_int(data) );
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLREDUCE_INT, sizeof(int), start);
 }
 
 
 void comm_broadcast(void *data, size_t nbytes)
 {
+  double start = comm_profile_time();
   QMP_CHECK( QMP_broadcast(data, nbytes) );
+  comm_profile_collective(QUDA_COMM_PROFILE_BROADCAST, nbytes, start);
+}
+
+
+static size_t allgather_bytes = 0;
+
+static void allgather_or(void *inout, void *in)
+{
+  for (size_t i=0; i<allgather_bytes; i++) ((char*)inout)[i] |= ((char*)in)[i];
+}
+
+
+/**
+ * QMP has no gather, so each node places its data in its own (otherwise zeroed) slot and the slots
+ * are combined with a bitwise-or reduction.
+ */
+void comm_allgather(void *recv, const void *send, size_t nbytes)
+{
+  double start = comm_profile_time();
+  allgather_bytes = nbytes * comm_size();
+  memset(recv, 0, allgather_bytes);
+  memcpy((char*)recv + comm_rank()*nbytes, send, nbytes);
+  QMP_CHECK( QMP_binary_reduction(recv, allgather_bytes, allgather_or) );
+  comm_profile_collective(QUDA_COMM_PROFILE_ALLGATHER, nbytes, start);
 }
 
 
 void comm_barrier(void)
 {
+  double start = comm_profile_time();
   QMP_CHECK( QMP_barrier() );  
+  comm_profile_collective(QUDA_COMM_PROFILE_BARRIER, 0, start);
+}
+
+
+void comm_release(void)
+{
 }
 
 
@@ -3,6 +3,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <comm_quda.h>
 
 void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data)
@@ -11,6 +12,12 @@ void comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *m
   comm_set_default_topology(topo);
 }
 
+int comm_world_size(void) { return 1; }
+
+int comm_world_rank(void) { return 0; }
+
+void comm_world_nodes(int *node_id) { node_id[0] = 0; }
+
 int comm_rank(void) { return 0; }
 
 int comm_size(void) { return 1; }
@@ -39,7 +46,11 @@ void comm_allreduce_int(int* data) {}
 
 void comm_broadcast(void *data, size_t nbytes) {}
 
+void comm_allgather(void *recv, const void *send, size_t nbytes) { memcpy(recv, send, nbytes); }
+
 void comm_barrier(void) {}
 
+void comm_release(void) {}
+
 void comm_abort(int status) { exit(status); }
 
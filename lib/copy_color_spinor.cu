@@ -11,6 +11,9 @@
 #include <color_spinor_field.h>
 #include <color_spinor_field_order.h>
 #include <tune_quda.h>
+#include <host_thread_quda.h>
+#include <host_reorder_quda.h>
+#include <site_order_quda.h>
 #include <algorithm> // for std::swap
 
 #define PRESERVE_SPINOR_NORM
@@ -82,18 +85,40 @@ namespace quda {
       }
     };
 
+  /** CPU functor to reorder one site of a spinor field.  If map is
+      set, input site x is stored at output site map[x] (used to
+      convert to and from the Morton site order). */
+  template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder, typename Basis>
+    struct PackSpinorSite {
+      OutOrder &outOrder;
+      const InOrder &inOrder;
+      Basis &basis;
+      const int *map;
+      PackSpinorSite(OutOrder &outOrder, const InOrder &inOrder, Basis &basis, const int *map)
+	: outOrder(outOrder), inOrder(inOrder), basis(basis), map(map) { }
+
+      void operator()(int x) const {
+	typedef typename mapper<FloatIn>::type RegTypeIn;
+	typedef typename mapper<FloatOut>::type RegTypeOut;
+	RegTypeIn in[Ns*Nc*2];
+	RegTypeOut out[Ns*Nc*2];
+	inOrder.load(in, x);
+	basis(out, in);
+	outOrder.save(out, map ? map[x] : x);
+      }
+    };
+
   /** CPU function to reorder spinor fields.  */
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder, typename Basis>
-    void packSpinor(OutOrder &outOrder, const InOrder &inOrder, Basis basis, int volume) {  
-    typedef typename mapper<FloatIn>::type RegTypeIn;
-    typedef typename mapper<FloatOut>::type RegTypeOut;
-    for (int x=0; x<volume; x++) {
-      RegTypeIn in[Ns*Nc*2];
-      RegTypeOut out[Ns*Nc*2];
-      inOrder.load(in, x);
-      basis(out, in);
-      outOrder.save(out, x);
-    }
+    void packSpinor(OutOrder &outOrder, const InOrder &inOrder, Basis basis, int volume, const int *map) {  
+    PackSpinorSite<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder, Basis> site(outOrder, inOrder, basis, map);
+    std::stringstream vol, aux;
+    vol << inOrder.volumeCB; 
+    aux << "out_stride=" << outOrder.stride << ",in_stride=" << inOrder.stride;
+    if (map) aux << ",map";
+    TunableHostLoop<PackSpinorSite<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder, Basis> >
+      pack(site, volume, TuneKey(vol.str(), typeid(site).name(), aux.str()), 0, inOrder.Bytes() + outOrder.Bytes());
+    pack.apply(0);
   }
 
   /** CUDA kernel to reorder spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
@@ -169,11 +194,15 @@ namespace quda {
   /** Decide whether we are changing basis or not */
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder>
     void genericCopyColorSpinor(OutOrder &outOrder, const InOrder &inOrder, int Vh, 
-				QudaGammaBasis dstBasis, QudaGammaBasis srcBasis, QudaFieldLocation location) {
+				QudaGammaBasis dstBasis, QudaGammaBasis srcBasis, QudaFieldLocation location,
+				const int *map) {
+    if (map && location != QUDA_CPU_FIELD_LOCATION)
+      errorQuda("Site reordering is only supported on the host");
+
     if (dstBasis==srcBasis) {
       PreserveBasis<FloatOut, FloatIn, Ns, Nc> basis;
       if (location == QUDA_CPU_FIELD_LOCATION) {
-	packSpinor<FloatOut, FloatIn, Ns, Nc>(outOrder, inOrder, basis, Vh);
+	packSpinor<FloatOut, FloatIn, Ns, Nc>(outOrder, inOrder, basis, Vh, map);
       } else {
 	PackSpinor<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder, PreserveBasis<FloatOut, FloatIn, Ns, Nc> > pack(outOrder, inOrder, basis, Vh);
 	pack.apply(0);
@@ -182,7 +211,7 @@ namespace quda {
       if (Ns != 4) errorQuda("Can only change basis with Nspin = 4, not Nspin = %d", Ns);
       NonRelBasis<FloatOut, FloatIn, Ns, Nc> basis;
       if (location == QUDA_CPU_FIELD_LOCATION) {
-	packSpinor<FloatOut, FloatIn, Ns, Nc>(outOrder, inOrder, basis, Vh);
+	packSpinor<FloatOut, FloatIn, Ns, Nc>(outOrder, inOrder, basis, Vh, map);
       } else {
 	PackSpinor<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder, NonRelBasis<FloatOut, FloatIn, Ns, Nc> > pack(outOrder, inOrder, basis, Vh);
 	pack.apply(0);
@@ -191,7 +220,7 @@ namespace quda {
       if (Ns != 4) errorQuda("Can only change basis with Nspin = 4, not Nspin = %d", Ns);
       RelBasis<FloatOut, FloatIn, Ns, Nc> basis;
       if (location == QUDA_CPU_FIELD_LOCATION) {
-	packSpinor<FloatOut, FloatIn, Ns, Nc>(outOrder, inOrder, basis, Vh);    
+	packSpinor<FloatOut, FloatIn, Ns, Nc>(outOrder, inOrder, basis, Vh, map);    
       } else {
 	PackSpinor<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder, RelBasis<FloatOut, FloatIn, Ns, Nc> > pack(outOrder, inOrder, basis, Vh);
 	pack.apply(0);
@@ -205,29 +234,33 @@ namespace quda {
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename InOrder>
     void genericCopyColorSpinor(InOrder &inOrder, ColorSpinorField &out, 
 				QudaGammaBasis inBasis, QudaFieldLocation location, 
-				FloatOut *Out, float *outNorm) {
+				FloatOut *Out, float *outNorm, const int *map) {
     if (out.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER) {
       FloatNOrder<FloatOut, Ns, Nc, 4> outOrder(out, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
-	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
+	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location, map);
     } else if (out.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
       FloatNOrder<FloatOut, Ns, Nc, 2> outOrder(out, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
-	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
+	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location, map);
     } else if (out.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      SpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, Out);
+      SpaceSpinorColorOrder<FloatOut, Ns, Nc> outOrder(out, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
-	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
+	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location, map);
     } else if (out.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
-      SpaceColorSpinorOrder<FloatOut, Ns, Nc> outOrder(out, Out);
+      SpaceColorSpinorOrder<FloatOut, Ns, Nc> outOrder(out, Out, outNorm);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
-	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
+	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location, map);
+    } else if (out.FieldOrder() == QUDA_AOSOA_FIELD_ORDER) {
+      AoSoAOrder<FloatOut, Ns, Nc> outOrder(out, Out);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
+	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location, map);
     } else if (out.FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
 
 #ifdef BUILD_QDPJIT_INTERFACE
       QDPJITDiracOrder<FloatOut, Ns, Nc> outOrder(out, Out);
       genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>
-	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location);
+	(outOrder, inOrder, out.VolumeCB(), out.GammaBasis(), inBasis, location, map);
 #else
       errorQuda("QDPJIT interface has not been built\n");
 #endif
@@ -238,28 +271,61 @@ namespace quda {
 
   }
 
+  /** Host fast path between space-spin-color and FloatN fields with
+      the same basis, a pure transpose (see host_reorder_quda.h).
+      Returns false if the combination is not covered. */
+  template <typename FloatOut, typename FloatIn, int Ns, int Nc>
+    bool copyColorSpinorFast(ColorSpinorField &out, const ColorSpinorField &in, 
+			     QudaFieldLocation location, FloatOut *Out, FloatIn *In) {
+    if (location != QUDA_CPU_FIELD_LOCATION || out.GammaBasis() != in.GammaBasis()) return false;
+    if (typeid(FloatOut)==typeid(short) || typeid(FloatIn)==typeid(short)) return false;
+
+    const int length = Ns*Nc*2;
+    void *dst = Out ? (void*)Out : out.V();
+    void *src = In ? (void*)In : const_cast<void*>(in.V());
+    if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
+	(out.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER || out.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER)) {
+      const int N = out.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER ? 4 : 2;
+      if (length % N) return false;
+      reorderToFloatN(&dst, &src, 1, out.Precision(), in.Precision(), in.VolumeCB(), length, length, N, out.Stride());
+      return true;
+    } else if (out.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
+	       (in.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER || in.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER)) {
+      const int N = in.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER ? 4 : 2;
+      if (length % N) return false;
+      reorderFromFloatN(&dst, &src, 1, out.Precision(), in.Precision(), in.VolumeCB(), length, length, N, in.Stride());
+      return true;
+    }
+    return false;
+  }
+
   /** Decide on the input order*/
   template <typename FloatOut, typename FloatIn, int Ns, int Nc>
     void genericCopyColorSpinor(ColorSpinorField &out, const ColorSpinorField &in, 
 				QudaFieldLocation location, FloatOut *Out, FloatIn *In, 
-				float *outNorm, float *inNorm) {
+				float *outNorm, float *inNorm, const int *map=0) {
+    if (!map && copyColorSpinorFast<FloatOut,FloatIn,Ns,Nc>(out, in, location, Out, In)) return;
+
     if (in.FieldOrder() == QUDA_FLOAT4_FIELD_ORDER) {
       FloatNOrder<FloatIn, Ns, Nc, 4> inOrder(in, In, inNorm);
-      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm, map);
     } else if (in.FieldOrder() == QUDA_FLOAT2_FIELD_ORDER) {
       FloatNOrder<FloatIn, Ns, Nc, 2> inOrder(in, In, inNorm);
-      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm, map);
     } else if (in.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER) {
-      SpaceSpinorColorOrder<FloatIn, Ns, Nc> inOrder(in, In);
-      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
+      SpaceSpinorColorOrder<FloatIn, Ns, Nc> inOrder(in, In, inNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm, map);
     } else if (in.FieldOrder() == QUDA_SPACE_COLOR_SPIN_FIELD_ORDER) {
-      SpaceColorSpinorOrder<FloatIn, Ns, Nc> inOrder(in, In);
-      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
+      SpaceColorSpinorOrder<FloatIn, Ns, Nc> inOrder(in, In, inNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm, map);
+    } else if (in.FieldOrder() == QUDA_AOSOA_FIELD_ORDER) {
+      AoSoAOrder<FloatIn, Ns, Nc> inOrder(in, In);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm, map);
     } else if (in.FieldOrder() == QUDA_QDPJIT_FIELD_ORDER) {
 
 #ifdef BUILD_QDPJIT_INTERFACE
       QDPJITDiracOrder<FloatIn, Ns, Nc> inOrder(in, In);
-      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm);
+      genericCopyColorSpinor<FloatOut,FloatIn,Ns,Nc>(inOrder, out, in.GammaBasis(), location, Out, outNorm, map);
 #else
       errorQuda("QDPJIT interface has not been built\n");
 #endif
@@ -282,11 +348,12 @@ namespace quda {
     if (dst.Volume() != src.Volume())
       errorQuda("Volumes %d %d don't match", dst.Volume(), src.Volume());
 
-    if (!( dst.SiteOrder() == src.SiteOrder() ||
-	   (dst.SiteOrder() == QUDA_EVEN_ODD_SITE_ORDER && 
-	    src.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER) ||
-	   (dst.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER && 
-	    src.SiteOrder() == QUDA_EVEN_ODD_SITE_ORDER) ) ) {
+    // the even-odd, odd-even and Morton orders can be converted into each other
+    const bool dstParity = dst.SiteOrder() == QUDA_EVEN_ODD_SITE_ORDER || 
+      dst.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER || dst.SiteOrder() == QUDA_MORTON_SITE_ORDER;
+    const bool srcParity = src.SiteOrder() == QUDA_EVEN_ODD_SITE_ORDER || 
+      src.SiteOrder() == QUDA_ODD_EVEN_SITE_ORDER || src.SiteOrder() == QUDA_MORTON_SITE_ORDER;
+    if (!( dst.SiteOrder() == src.SiteOrder() || (dstParity && srcParity) )) {
       errorQuda("Subset orders %d %d don't match", dst.SiteOrder(), src.SiteOrder());
     }
 
@@ -328,10 +395,20 @@ namespace quda {
 	std::swap<float*>(dstNormEven, dstNormOdd);
       }
 
+      // map each checkerboard site to or from its position along the Morton curve
+      const int *mapEven = 0, *mapOdd = 0;
+      if ((dst.SiteOrder() == QUDA_MORTON_SITE_ORDER) != (src.SiteOrder() == QUDA_MORTON_SITE_ORDER)) {
+	if (dst.Ndim() != 4) errorQuda("Morton site order requires a 4-d field");
+	const MortonSiteOrder &morton = mortonSiteOrder(dst.X());
+	const bool toMorton = (dst.SiteOrder() == QUDA_MORTON_SITE_ORDER);
+	mapEven = toMorton ? morton.ToCurve(0) : morton.FromCurve(0);
+	mapOdd = toMorton ? morton.ToCurve(1) : morton.FromCurve(1);
+      }
+
       genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>
-	(dst, src, location, dstEven, srcEven, dstNormEven, srcNormEven);
+	(dst, src, location, dstEven, srcEven, dstNormEven, srcNormEven, mapEven);
       genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>
-	(dst, src, location,  dstOdd,  srcOdd,  dstNormOdd,  srcNormOdd);
+	(dst, src, location,  dstOdd,  srcOdd,  dstNormOdd,  srcNormOdd, mapOdd);
     } else { // parity field
       genericCopyColorSpinor<dstFloat, srcFloat, Ns, Nc>
 	(dst, src, location, Dst, Src, dstNorm, srcNorm);
@@ -1,4 +1,6 @@
 #include <gauge_field_order.h>
+#include <host_thread_quda.h>
+#include <host_reorder_quda.h>
 
 namespace quda {
 
@@ -14,27 +16,46 @@ namespace quda {
   };
 
   /**
-     Generic CPU gauge reordering and packing 
+     Generic CPU gauge reordering and packing of one site, i =
+     parity*volumeCB + x, in all dimensions
   */
   template <typename FloatOut, typename FloatIn, int length, 
 	    int nDim, typename OutOrder, typename InOrder>
-  void copyGauge(CopyGaugeArg<OutOrder,InOrder> arg) {  
-    typedef typename mapper<FloatIn>::type RegTypeIn;
-    typedef typename mapper<FloatOut>::type RegTypeOut;
+  struct CopyGaugeSite {
+    CopyGaugeArg<OutOrder,InOrder> &arg;
+    CopyGaugeSite(CopyGaugeArg<OutOrder,InOrder> &arg) : arg(arg) { }
 
-    for (int parity=0; parity<2; parity++) {
+    void operator()(int i) const {
+      typedef typename mapper<FloatIn>::type RegTypeIn;
+      typedef typename mapper<FloatOut>::type RegTypeOut;
 
+      const int parity = i / arg.in.volumeCB;
+      const int x = i - parity*arg.in.volumeCB;
       for (int d=0; d<nDim; d++) {
-	for (int x=0; x<arg.in.volumeCB; x++) {
-	  RegTypeIn in[length];
-	  RegTypeOut out[length];
-	  arg.in.load(in, x, d, parity);
-	  for (int i=0; i<length; i++) out[i] = in[i];
-	  arg.out.save(out, x, d, parity);
-	}
+	RegTypeIn in[length];
+	RegTypeOut out[length];
+	arg.in.load(in, x, d, parity);
+	for (int j=0; j<length; j++) out[j] = in[j];
+	arg.out.save(out, x, d, parity);
       }
-
     }
+  };
+
+  /**
+     Generic CPU gauge reordering and packing, threaded over sites
+  */
+  template <typename FloatOut, typename FloatIn, int length, 
+	    int nDim, typename OutOrder, typename InOrder>
+  void copyGauge(CopyGaugeArg<OutOrder,InOrder> &arg) {
+    typedef CopyGaugeSite<FloatOut, FloatIn, length, nDim, OutOrder, InOrder> Site;
+    std::stringstream vol, aux;
+    vol << arg.in.volumeCB; 
+    aux << "out_stride=" << arg.out.stride << ",in_stride=" << arg.in.stride;
+
+    Site site(arg);
+    TunableHostLoop<Site> copier(site, 2*arg.in.volumeCB, TuneKey(vol.str(), typeid(site).name(), aux.str()),
+				 0, 2ll*nDim*arg.in.volumeCB*(arg.in.Bytes() + arg.out.Bytes()));
+    copier.apply(0);
   }
 
   /** 
@@ -63,27 +84,54 @@ namespace quda {
   }
 
   /**
-     Generic CPU gauge ghost reordering and packing 
+     Generic CPU gauge ghost reordering and packing of one face site,
+     i = parity*faceMax + x, in all dimensions
   */
   template <typename FloatOut, typename FloatIn, int length, 
 	    int nDim, typename OutOrder, typename InOrder>
-    void copyGhost(CopyGaugeArg<OutOrder,InOrder> arg) {  
-    typedef typename mapper<FloatIn>::type RegTypeIn;
-    typedef typename mapper<FloatOut>::type RegTypeOut;
+  struct CopyGhostSite {
+    CopyGaugeArg<OutOrder,InOrder> &arg;
+    const int faceMax;
+    CopyGhostSite(CopyGaugeArg<OutOrder,InOrder> &arg, int faceMax) : arg(arg), faceMax(faceMax) { }
 
-    for (int parity=0; parity<2; parity++) {
+    void operator()(int i) const {
+      typedef typename mapper<FloatIn>::type RegTypeIn;
+      typedef typename mapper<FloatOut>::type RegTypeOut;
 
+      const int parity = i / faceMax;
+      const int x = i - parity*faceMax;
       for (int d=0; d<nDim; d++) {
-	for (int x=0; x<arg.in.faceVolumeCB[d]; x++) {
+	if (x < arg.in.faceVolumeCB[d]) {
 	  RegTypeIn in[length];
 	  RegTypeOut out[length];
 	  arg.in.loadGhost(in, x, d, parity); // assumes we are loading 
-	  for (int i=0; i<length; i++) out[i] = in[i];
+	  for (int j=0; j<length; j++) out[j] = in[j];
 	  arg.out.saveGhost(out, x, d, parity);
 	}
       }
+    }
+  };
 
+  /**
+     Generic CPU gauge ghost reordering and packing, threaded over face sites
+  */
+  template <typename FloatOut, typename FloatIn, int length, 
+	    int nDim, typename OutOrder, typename InOrder>
+  void copyGhost(CopyGaugeArg<OutOrder,InOrder> &arg) {
+    typedef CopyGhostSite<FloatOut, FloatIn, length, nDim, OutOrder, InOrder> Site;
+    int faceMax = 0, sites = 0;
+    for (int d=0; d<nDim; d++) {
+      faceMax = (arg.in.faceVolumeCB[d] > faceMax) ? arg.in.faceVolumeCB[d] : faceMax;
+      sites += arg.in.faceVolumeCB[d];
     }
+    std::stringstream vol, aux;
+    vol << arg.in.volumeCB; 
+    aux << "out_stride=" << arg.out.stride << ",in_stride=" << arg.in.stride;
+
+    Site site(arg, faceMax);
+    TunableHostLoop<Site> copier(site, 2*faceMax, TuneKey(vol.str(), typeid(site).name(), aux.str()),
+				 0, 2ll*sites*(arg.in.Bytes() + arg.out.Bytes()));
+    copier.apply(0);
   }
 
   /**
@@ -168,12 +216,7 @@ namespace quda {
 	for (int d=0; d<nDim; d++) sites += arg.in.faceVolumeCB[d];
       }
 
-#if __COMPUTE_CAPABILITY__ >= 200
-      return 2 * sites * (  arg.in.Bytes() + arg.in.hasPhase*sizeof(FloatIn) 
-			    + arg.out.Bytes() + arg.out.hasPhase*sizeof(FloatOut) ); 
-#else      
       return 2 * sites * (  arg.in.Bytes() + arg.out.Bytes() );
-#endif
     } 
   };
 
@@ -261,11 +304,36 @@ namespace quda {
       } else {
 	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
       }
+    } else if (out.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length,12>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (AoSoAOrder<FloatOut,length,8>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
+
     } else if (out.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>
-	(QDPOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length,12>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (QDPOrder<FloatOut,length,8>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
@@ -291,8 +359,18 @@ namespace quda {
     } else if (out.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>
-	(MILCOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (MILCOrder<FloatOut,length>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (MILCOrder<FloatOut,length,12>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>
+	  (MILCOrder<FloatOut,length,8>(out, Out, outGhost), inOrder, out.Volume(), faceVolumeCB, out.Ndim(), location, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
 #else
       errorQuda("MILC interface has not been built\n");
 #endif
@@ -312,6 +390,74 @@ namespace quda {
 
   }
 
+  /**
+     Pointers to the start of each (parity, dimension) block of a QDP
+     or MILC ordered field, and the distance between sites in elements.
+     Returns false for other orders.
+  */
+  template <typename Float>
+  bool siteMajorBlocks(const GaugeField &u, Float *U, void *block[8], int &siteStride) {
+    const int length = 18;
+    if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+#ifdef BUILD_QDP_INTERFACE
+      Float **gauge = U ? (Float**)U : (Float**)u.Gauge_p();
+      for (int parity=0; parity<2; parity++)
+	for (int dir=0; dir<4; dir++) block[parity*4+dir] = gauge[dir] + parity*u.VolumeCB()*length;
+      siteStride = length;
+      return true;
+#endif
+    } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
+#ifdef BUILD_MILC_INTERFACE
+      Float *gauge = U ? U : (Float*)u.Gauge_p();
+      for (int parity=0; parity<2; parity++)
+	for (int dir=0; dir<4; dir++) block[parity*4+dir] = gauge + (parity*u.VolumeCB()*4 + dir)*length;
+      siteStride = 4*length;
+      return true;
+#endif
+    }
+    return false;
+  }
+
+  /** Pointers to the start of each (parity, dimension) block of a Float2 ordered field */
+  template <typename Float>
+  void floatNBlocks(const GaugeField &u, Float *U, void *block[8]) {
+    const int length = 18;
+    Float *gauge = U ? U : (Float*)u.Gauge_p();
+    for (int parity=0; parity<2; parity++)
+      for (int dir=0; dir<4; dir++)
+	block[parity*4+dir] = (char*)gauge + parity*(u.Bytes()/2) + dir*u.Stride()*length*sizeof(Float);
+  }
+
+  /**
+     Host fast path between QDP or MILC ordered fields and Float2
+     ordered fields without reconstruction.  Since no reconstruction
+     is involved this is a pure transpose, which is done in cache-sized
+     tiles of sites (see host_reorder_quda.h).  Returns false if the
+     combination is not covered, in which case the generic path is
+     taken.  The ghost zone is left to the generic path.
+  */
+  template <typename FloatOut, typename FloatIn>
+  bool copyGaugeFast(GaugeField &out, const GaugeField &in, QudaFieldLocation location,
+		     FloatOut *Out, FloatIn *In, int type) {
+    if (location != QUDA_CPU_FIELD_LOCATION || type != 0) return false;
+    if (typeid(FloatOut)==typeid(short) || typeid(FloatIn)==typeid(short)) return false;
+    if (out.Reconstruct() != QUDA_RECONSTRUCT_NO || in.Reconstruct() != QUDA_RECONSTRUCT_NO) return false;
+    if (out.Ncolor() != 3 || in.Ncolor() != 3) return false;
+
+    void *outBlock[8], *inBlock[8];
+    int siteStride;
+    if (out.Order() == QUDA_FLOAT2_GAUGE_ORDER && siteMajorBlocks(in, In, inBlock, siteStride)) {
+      floatNBlocks(out, Out, outBlock);
+      reorderToFloatN(outBlock, inBlock, 8, out.Precision(), in.Precision(), in.VolumeCB(), 18, siteStride, 2, out.Stride());
+      return true;
+    } else if (in.Order() == QUDA_FLOAT2_GAUGE_ORDER && siteMajorBlocks(out, Out, outBlock, siteStride)) {
+      floatNBlocks(in, In, inBlock);
+      reorderFromFloatN(outBlock, inBlock, 8, out.Precision(), in.Precision(), in.VolumeCB(), 18, siteStride, 2, in.Stride());
+      return true;
+    }
+    return false;
+  }
+
   template <typename FloatOut, typename FloatIn, int length>
     void copyGauge(GaugeField &out, const GaugeField &in, QudaFieldLocation location, 
 		   FloatOut *Out, FloatIn *In, FloatOut **outGhost, FloatIn **inGhost, 
@@ -319,7 +465,12 @@ namespace quda {
 
     bool doGhost = in.GhostInit() && out.GhostInit();
 
-    // reconstruction only supported on FloatN fields currently
+    if (length == 18 && copyGaugeFast(out, in, location, Out, In, type)) {
+      if (!doGhost) return;
+      type = 1; // the body has been copied, so only the ghost zone remains
+    }
+
+    // reconstruction supported on FloatN, QDP, MILC and AoSoA fields
     if (in.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
       if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
 	if (typeid(FloatIn)==typeid(short) && in.LinkType() == QUDA_ASQTAD_FAT_LINKS) {
@@ -364,11 +515,36 @@ namespace quda {
       } else {
 	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
       }
+    } else if (in.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,12>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,8>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
+
     } else if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
 
 #ifdef BUILD_QDP_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length>(in, In, inGhost), 
-					 out, location, Out, outGhost, type, doGhost);
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,12>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,8>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
@@ -394,8 +570,18 @@ namespace quda {
     } else if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-      copyGauge<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length>(in, In, inGhost), 
-					 out, location, Out, outGhost, type, doGhost);
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGauge<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGauge<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length,12>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGauge<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length,8>(in, In, inGhost), 
+					   out, location, Out, outGhost, type, doGhost);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
 #else
       errorQuda("MILC interface has not been built\n");
 #endif
@@ -484,6 +670,206 @@ namespace quda {
     }
   }
 
+  /**
+     Generic CPU reordering of the sites [offset, offset+volumeCB) of
+     each parity of the input into a buffer holding just those sites,
+     with site i = parity*volumeCB + x of the slab.
+  */
+  template <typename FloatOut, typename FloatIn, int length, typename OutOrder, typename InOrder>
+  struct CopyGaugeSlabSite {
+    OutOrder &out;
+    const InOrder &in;
+    const int offset;
+    const int volumeCB;
+    CopyGaugeSlabSite(OutOrder &out, const InOrder &in, int offset, int volumeCB)
+      : out(out), in(in), offset(offset), volumeCB(volumeCB) { }
+
+    void operator()(int i) const {
+      typedef typename mapper<FloatIn>::type RegTypeIn;
+      typedef typename mapper<FloatOut>::type RegTypeOut;
+
+      const int parity = i / volumeCB;
+      const int x = i - parity*volumeCB;
+      for (int d=0; d<4; d++) {
+	RegTypeIn u[length];
+	RegTypeOut v[length];
+	in.load(u, offset + x, d, parity);
+	for (int j=0; j<length; j++) v[j] = u[j];
+	out.save(v, x, d, parity);
+      }
+    }
+  };
+
+  template <typename FloatOut, typename FloatIn, int length, typename OutOrder, typename InOrder>
+  void copyGaugeSlab(OutOrder outOrder, const InOrder &inOrder, int offset, int volumeCB) {
+    typedef CopyGaugeSlabSite<FloatOut, FloatIn, length, OutOrder, InOrder> Site;
+    std::stringstream vol, aux;
+    vol << volumeCB;
+    aux << "in_stride=" << inOrder.stride;
+
+    Site site(outOrder, inOrder, offset, volumeCB);
+    TunableHostLoop<Site> copier(site, 2*volumeCB, TuneKey(vol.str(), typeid(site).name(), aux.str()),
+				 0, 2ll*4*volumeCB*(inOrder.Bytes() + outOrder.Bytes()));
+    copier.apply(0);
+  }
+
+  template <typename FloatOut, typename FloatIn, int length, typename InOrder>
+  void copyGaugeSlab(const InOrder &inOrder, GaugeField &out, FloatOut *Out, int offset, int volumeCB) {
+    if (out.Order() == QUDA_FLOAT2_GAUGE_ORDER) {
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	if (typeid(FloatOut)==typeid(short) && out.LinkType() == QUDA_ASQTAD_FAT_LINKS) {
+	  copyGaugeSlab<FloatOut,FloatIn,length>
+	    (FloatNOrder<FloatOut,length,2,19>(out, Out, volumeCB, volumeCB), inOrder, offset, volumeCB);
+	} else {
+	  copyGaugeSlab<FloatOut,FloatIn,length>
+	    (FloatNOrder<FloatOut,length,2,18>(out, Out, volumeCB, volumeCB), inOrder, offset, volumeCB);
+	}
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGaugeSlab<FloatOut,FloatIn,length>
+	  (FloatNOrder<FloatOut,length,2,12>(out, Out, volumeCB, volumeCB), inOrder, offset, volumeCB);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGaugeSlab<FloatOut,FloatIn,length>
+	  (FloatNOrder<FloatOut,length,2,8>(out, Out, volumeCB, volumeCB), inOrder, offset, volumeCB);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
+    } else if (out.Order() == QUDA_FLOAT4_GAUGE_ORDER) {
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGaugeSlab<FloatOut,FloatIn,length>
+	  (FloatNOrder<FloatOut,length,4,12>(out, Out, volumeCB, volumeCB), inOrder, offset, volumeCB);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGaugeSlab<FloatOut,FloatIn,length>
+	  (FloatNOrder<FloatOut,length,4,8>(out, Out, volumeCB, volumeCB), inOrder, offset, volumeCB);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", out.Reconstruct(), out.Order());
+      }
+    } else {
+      errorQuda("Gauge field %d order not supported", out.Order());
+    }
+  }
+
+  /**
+     The tiled reorder of copyGaugeFast applied to one slab: the sites
+     [offset, offset+volumeCB) of each (parity, dimension) block of a
+     QDP or MILC ordered field are transposed into the Float2 staging
+     buffer.  Returns false if the combination is not covered.
+  */
+  template <typename FloatOut, typename FloatIn>
+  bool copyGaugeSlabFast(GaugeField &out, const GaugeField &in, FloatOut *Out, FloatIn *In,
+			 int offset, int volumeCB) {
+    if (typeid(FloatOut)==typeid(short) || typeid(FloatIn)==typeid(short)) return false;
+    if (out.Order() != QUDA_FLOAT2_GAUGE_ORDER) return false;
+    if (out.Reconstruct() != QUDA_RECONSTRUCT_NO || in.Reconstruct() != QUDA_RECONSTRUCT_NO) return false;
+    if (out.Ncolor() != 3 || in.Ncolor() != 3) return false;
+
+    const int length = 18;
+    void *outBlock[8], *inBlock[8];
+    int siteStride;
+    if (!siteMajorBlocks(in, In, inBlock, siteStride)) return false;
+    for (int b=0; b<8; b++) {
+      inBlock[b] = (FloatIn*)inBlock[b] + (size_t)offset*siteStride;
+      outBlock[b] = Out + (size_t)b*length*volumeCB;
+    }
+    reorderToFloatN(outBlock, inBlock, 8, out.Precision(), in.Precision(), volumeCB, length, siteStride, 2, volumeCB);
+    return true;
+  }
+
+  template <typename FloatOut, typename FloatIn>
+  void copyGaugeSlab(GaugeField &out, const GaugeField &in, FloatOut *Out, FloatIn *In, int offset, int volumeCB) {
+    const int length = 18;
+    if (copyGaugeSlabFast(out, in, Out, In, offset, volumeCB)) return;
+
+    if (in.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length>(in, In), out, Out, offset, volumeCB);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,12>(in, In), out, Out, offset, volumeCB);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(AoSoAOrder<FloatIn,length,8>(in, In), out, Out, offset, volumeCB);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
+    } else if (in.Order() == QUDA_QDP_GAUGE_ORDER) {
+#ifdef BUILD_QDP_INTERFACE
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length>(in, In), out, Out, offset, volumeCB);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,12>(in, In), out, Out, offset, volumeCB);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(QDPOrder<FloatIn,length,8>(in, In), out, Out, offset, volumeCB);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
+#else
+      errorQuda("QDP interface has not been built\n");
+#endif
+    } else if (in.Order() == QUDA_CPS_WILSON_GAUGE_ORDER) {
+#ifdef BUILD_CPS_INTERFACE
+      copyGaugeSlab<FloatOut,FloatIn,length>(CPSOrder<FloatIn,length>(in, In), out, Out, offset, volumeCB);
+#else
+      errorQuda("CPS interface has not been built\n");
+#endif
+    } else if (in.Order() == QUDA_MILC_GAUGE_ORDER) {
+#ifdef BUILD_MILC_INTERFACE
+      if (in.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length>(in, In), out, Out, offset, volumeCB);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length,12>(in, In), out, Out, offset, volumeCB);
+      } else if (in.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	copyGaugeSlab<FloatOut,FloatIn,length>(MILCOrder<FloatIn,length,8>(in, In), out, Out, offset, volumeCB);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", in.Reconstruct(), in.Order());
+      }
+#else
+      errorQuda("MILC interface has not been built\n");
+#endif
+    } else if (in.Order() == QUDA_BQCD_GAUGE_ORDER) {
+#ifdef BUILD_BQCD_INTERFACE
+      copyGaugeSlab<FloatOut,FloatIn,length>(BQCDOrder<FloatIn,length>(in, In), out, Out, offset, volumeCB);
+#else
+      errorQuda("BQCD interface has not been built\n");
+#endif
+    } else {
+      errorQuda("Gauge field %d order not supported", in.Order());
+    }
+  }
+
+  void copyGenericGaugeSlab(GaugeField &out, const GaugeField &in, void *Out, void *In, int offset, int volumeCB) {
+    if (out.Precision() == QUDA_DOUBLE_PRECISION) {
+      if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+	copyGaugeSlab(out, in, (double*)Out, (double*)In, offset, volumeCB);
+      } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+	copyGaugeSlab(out, in, (double*)Out, (float*)In, offset, volumeCB);
+      } else if (in.Precision() == QUDA_HALF_PRECISION) {
+	copyGaugeSlab(out, in, (double*)Out, (short*)In, offset, volumeCB);
+      } else {
+	errorQuda("Unsupported precision %d", in.Precision());
+      }
+    } else if (out.Precision() == QUDA_SINGLE_PRECISION) {
+      if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+	copyGaugeSlab(out, in, (float*)Out, (double*)In, offset, volumeCB);
+      } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+	copyGaugeSlab(out, in, (float*)Out, (float*)In, offset, volumeCB);
+      } else if (in.Precision() == QUDA_HALF_PRECISION) {
+	copyGaugeSlab(out, in, (float*)Out, (short*)In, offset, volumeCB);
+      } else {
+	errorQuda("Unsupported precision %d", in.Precision());
+      }
+    } else if (out.Precision() == QUDA_HALF_PRECISION) {
+      if (in.Precision() == QUDA_DOUBLE_PRECISION) {
+	copyGaugeSlab(out, in, (short*)Out, (double*)In, offset, volumeCB);
+      } else if (in.Precision() == QUDA_SINGLE_PRECISION) {
+	copyGaugeSlab(out, in, (short*)Out, (float*)In, offset, volumeCB);
+      } else if (in.Precision() == QUDA_HALF_PRECISION) {
+	copyGaugeSlab(out, in, (short*)Out, (short*)In, offset, volumeCB);
+      } else {
+	errorQuda("Unsupported precision %d", in.Precision());
+      }
+    } else {
+      errorQuda("Unsupported precision %d", out.Precision());
+    }
+  }
+
   // this is the function that is actually called, from here on down we instantiate all required templates
   void copyGenericGauge(GaugeField &out, const GaugeField &in, QudaFieldLocation location,
 			void *Out, void *In, void **ghostOut, void **ghostIn, int type) {
@@ -46,7 +46,10 @@ namespace quda {
       zero();
     } else if (param.create == QUDA_REFERENCE_FIELD_CREATE) {
       v = param.v;
+      norm = param.norm;
       reference = true;
+      if (precision == QUDA_HALF_PRECISION && !norm) 
+	errorQuda("Half precision reference field requires a norm field");
     } else {
       errorQuda("Creation type %d not supported", param.create);
     }
@@ -56,6 +59,7 @@ namespace quda {
     ColorSpinorField(src), init(false), reference(false) {
     create(QUDA_COPY_FIELD_CREATE);
     memcpy(v,src.v,bytes);
+    if (precision == QUDA_HALF_PRECISION) memcpy(norm, src.norm, norm_bytes);
   }
 
   cpuColorSpinorField::cpuColorSpinorField(const ColorSpinorField &src) : 
@@ -63,6 +67,8 @@ namespace quda {
     create(QUDA_COPY_FIELD_CREATE);
     if (typeid(src) == typeid(cpuColorSpinorField)) {
       memcpy(v, dynamic_cast<const cpuColorSpinorField&>(src).v, bytes);
+      if (precision == QUDA_HALF_PRECISION) 
+	memcpy(norm, dynamic_cast<const cpuColorSpinorField&>(src).norm, norm_bytes);
     } else if (typeid(src) == typeid(cudaColorSpinorField)) {
       dynamic_cast<const cudaColorSpinorField&>(src).saveSpinorField(*this);
     } else {
@@ -118,18 +124,47 @@ namespace quda {
     total_length = length;
     total_norm_length = (siteSubset == QUDA_FULL_SITE_SUBSET) ? 2*stride : stride;
     bytes = total_length * precision; // includes pads and ghost zones
-    bytes = ALIGNMENT_ADJUST(bytes);
 
-    if (pad != 0) errorQuda("Non-zero pad not supported");  
-    if (precision == QUDA_HALF_PRECISION) errorQuda("Half precision not supported");
+    // fields in the native FloatN order keep the device layout (pad
+    // and aligned parity halves) so they can be transferred without
+    // reordering, while the parity halves of an AoSoA field are left
+    // contiguous so that the host BLAS can stream over the whole field
+    const bool native = (fieldOrder == QUDA_FLOAT2_FIELD_ORDER || fieldOrder == QUDA_FLOAT4_FIELD_ORDER);
+    if (native && siteSubset == QUDA_FULL_SITE_SUBSET) bytes = 2*ALIGNMENT_ADJUST(bytes/2);
+    else if (fieldOrder != QUDA_AOSOA_FIELD_ORDER) bytes = ALIGNMENT_ADJUST(bytes);
+
+    // half precision fields store 16-bit values with one float norm
+    // per site, the block-float format of the device fields; the
+    // norms of the two parities are contiguous unless the field is
+    // native, in which case they are aligned as on the device
+    if (precision == QUDA_HALF_PRECISION) {
+      norm_bytes = total_norm_length * sizeof(float);
+      if (native) norm_bytes = (siteSubset == QUDA_FULL_SITE_SUBSET) ? 
+		    2*ALIGNMENT_ADJUST(norm_bytes/2) : ALIGNMENT_ADJUST(norm_bytes);
+    } else {
+      norm_bytes = 0;
+    }
+
+    if (pad != 0 && !native) errorQuda("Non-zero pad not supported");  
+    if (precision == QUDA_HALF_PRECISION && !native && 
+	fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER && fieldOrder != QUDA_SPACE_COLOR_SPIN_FIELD_ORDER)
+      errorQuda("Half precision not supported for field order %d", fieldOrder);
 
     if (fieldOrder != QUDA_SPACE_COLOR_SPIN_FIELD_ORDER && 
 	fieldOrder != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER &&
 	fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER &&
-	fieldOrder != QUDA_QDPJIT_FIELD_ORDER) {
+	fieldOrder != QUDA_QDPJIT_FIELD_ORDER && 
+	fieldOrder != QUDA_AOSOA_FIELD_ORDER && !native) {
       errorQuda("Field order %d not supported", fieldOrder);
     }
 
+    if (siteOrder == QUDA_MORTON_SITE_ORDER && (siteSubset != QUDA_FULL_SITE_SUBSET || nDim != 4 ||
+					       fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER))
+      errorQuda("Morton site order requires a full 4-d field");
+
+    if (fieldOrder == QUDA_AOSOA_FIELD_ORDER && volumeCB % AOSOA_WIDTH(precision) != 0)
+      errorQuda("Volume %d is not a multiple of the AoSoA block width %d", volumeCB, AOSOA_WIDTH(precision));
+
     if (create != QUDA_REFERENCE_FIELD_CREATE) {
       // array of 4-d fields
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
@@ -139,6 +174,7 @@ namespace quda {
       } else {
 	v = safe_malloc(bytes);
       }
+      if (precision == QUDA_HALF_PRECISION) norm = safe_malloc(norm_bytes);
       init = true;
     }
  
@@ -150,6 +186,7 @@ namespace quda {
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) 
 	for (int i=0; i<x[nDim-1]; i++) host_free(((void**)v)[i]);
       host_free(v);
+      if (precision == QUDA_HALF_PRECISION) host_free(norm);
       init = false;
     }
 
@@ -157,11 +194,12 @@ namespace quda {
 
   void cpuColorSpinorField::copy(const cpuColorSpinorField &src) {
     checkField(*this, src);
-    if (fieldOrder == src.fieldOrder) {
+    if (fieldOrder == src.fieldOrder && precision == src.precision && siteOrder == src.siteOrder) {
       if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) 
 	for (int i=0; i<x[nDim-1]; i++) memcpy(((void**)v)[i], ((void**)src.v)[i], bytes);
       else 
 	memcpy(v, src.v, bytes);
+      if (precision == QUDA_HALF_PRECISION) memcpy(norm, src.norm, norm_bytes);
     } else {
       copyGenericColorSpinor(*this, src, QUDA_CPU_FIELD_LOCATION);
     }
@@ -170,6 +208,7 @@ namespace quda {
   void cpuColorSpinorField::zero() {
     if (fieldOrder != QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) memset(v, '\0', bytes);
     else for (int i=0; i<x[nDim-1]; i++) memset(((void**)v)[i], '\0', bytes/x[nDim-1]);
+    if (precision == QUDA_HALF_PRECISION) memset(norm, '\0', norm_bytes);
   }
 
   void cpuColorSpinorField::Source(QudaSourceType source_type, int x, int s, int c) {
@@ -241,9 +280,11 @@ namespace quda {
       errorQuda("Full spinor is not supported in packGhost for cpu");
     }
   
-    if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER) {
+    if (fieldOrder == QUDA_QOP_DOMAIN_WALL_FIELD_ORDER || fieldOrder == QUDA_AOSOA_FIELD_ORDER ||
+	fieldOrder == QUDA_FLOAT2_FIELD_ORDER || fieldOrder == QUDA_FLOAT4_FIELD_ORDER) {
       errorQuda("Field order %d not supported", fieldOrder);
     }
+    if (precision == QUDA_HALF_PRECISION) errorQuda("Half precision not supported");
 
     int num_faces=1;
     if(this->nSpin == 1){ //staggered
@@ -3,21 +3,32 @@
 #include <face_quda.h>
 #include <assert.h>
 #include <string.h>
+#include <typeinfo>
 
 namespace quda {
 
   cpuGaugeField::cpuGaugeField(const GaugeFieldParam &param) : 
     GaugeField(param), pinned(param.pinned)
   {
-    if (precision == QUDA_HALF_PRECISION) {
-      errorQuda("CPU fields do not support half precision");
+    if (precision == QUDA_HALF_PRECISION && link_type == QUDA_ASQTAD_MOM_LINKS) {
+      errorQuda("CPU momentum fields do not support half precision");
     }
     if (pad != 0) {
       errorQuda("CPU fields do not support non-zero padding");
     }
-    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_10) {
+    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_12 &&
+	reconstruct != QUDA_RECONSTRUCT_8 && reconstruct != QUDA_RECONSTRUCT_10) {
       errorQuda("Reconstruction type %d not supported", reconstruct);
     }
+    if (reconstruct == QUDA_RECONSTRUCT_12 || reconstruct == QUDA_RECONSTRUCT_8) {
+      // the links are recomputed from the stored rows on every access, so they must be SU(3)
+      if (link_type != QUDA_WILSON_LINKS) {
+	errorQuda("%d-reconstruction only supported for Wilson links", reconstruct);
+      }
+      if (order != QUDA_QDP_GAUGE_ORDER && order != QUDA_MILC_GAUGE_ORDER && order != QUDA_AOSOA_GAUGE_ORDER) {
+	errorQuda("%d-reconstruction only supported with QDP, MILC and AoSoA gauge orders", reconstruct);
+      }
+    }
     if (reconstruct == QUDA_RECONSTRUCT_10 && order != QUDA_MILC_GAUGE_ORDER) {
       errorQuda("10-reconstruction only supported with MILC gauge order");
     }
@@ -40,7 +51,8 @@ namespace quda {
 	}
       }
     
-    } else if (order == QUDA_CPS_WILSON_GAUGE_ORDER || order == QUDA_MILC_GAUGE_ORDER || order == QUDA_BQCD_GAUGE_ORDER) {
+    } else if (order == QUDA_CPS_WILSON_GAUGE_ORDER || order == QUDA_MILC_GAUGE_ORDER || 
+	       order == QUDA_BQCD_GAUGE_ORDER || order == QUDA_AOSOA_GAUGE_ORDER) {
 
       if (create == QUDA_NULL_FIELD_CREATE || create == QUDA_ZERO_FIELD_CREATE) {
 	size_t nbytes = nDim * volume * reconstruct * precision;
@@ -70,7 +82,7 @@ namespace quda {
     }
 
     // compute the fat link max now in case it is needed later (i.e., for half precision)
-    if (param.compute_fat_link_max) fat_link_max = maxGauge(*this);
+    if (param.compute_fat_link_max && precision != QUDA_HALF_PRECISION) fat_link_max = maxGauge(*this);
   }
 
 
@@ -118,6 +130,27 @@ namespace quda {
     ghostExchange = true;
   }
 
+  void cpuGaugeField::copy(const GaugeField &src) {
+    if (geometry != QUDA_VECTOR_GEOMETRY) errorQuda("Only vector geometry is supported");
+    checkField(src);
+
+    // half precision fat links are stored relative to the link max
+    if (link_type == QUDA_ASQTAD_FAT_LINKS) {
+      fat_link_max = src.LinkMax();
+      if (precision == QUDA_HALF_PRECISION && fat_link_max == 0.0) 
+        errorQuda("fat_link_max has not been computed");
+    }
+
+    if (typeid(src) == typeid(cpuGaugeField)) {
+      copyGenericGauge(*this, src, QUDA_CPU_FIELD_LOCATION, gauge, 
+		       static_cast<const cpuGaugeField&>(src).gauge);
+    } else if (typeid(src) == typeid(cudaGaugeField)) {
+      static_cast<const cudaGaugeField&>(src).saveCPUField(*this, QUDA_CPU_FIELD_LOCATION);
+    } else {
+      errorQuda("Invalid gauge field type");
+    }
+  }
+
   void cpuGaugeField::setGauge(void **gauge_)
   {
     if(create != QUDA_REFERENCE_FIELD_CREATE) {
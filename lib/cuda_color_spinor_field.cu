@@ -380,10 +380,31 @@ namespace quda {
     }
   } 
 
+  bool cudaColorSpinorField::directCopy(const ColorSpinorField &host) const {
+    if (typeid(host) != typeid(cpuColorSpinorField) || !isNative()) return false;
+    if (host.Precision() != precision) return false;
+    if (host.FieldOrder() != fieldOrder || host.SiteOrder() != siteOrder) return false;
+    if (host.SiteSubset() != siteSubset || host.Stride() != stride) return false;
+    if (host.Nspin() != nSpin || host.Ncolor() != nColor || host.GammaBasis() != gammaBasis) return false;
+    if (host.Ndim() != nDim) return false;
+    for (int d=0; d<nDim; d++) if (host.X(d) != x[d]) return false;
+    return true;
+  }
+
   void cudaColorSpinorField::loadSpinorField(const ColorSpinorField &src) {
 
-    if (REORDER_LOCATION == QUDA_CPU_FIELD_LOCATION && 
-	typeid(src) == typeid(cpuColorSpinorField)) {
+    if (directCopy(src)) {
+      const int nParity = (siteSubset == QUDA_FULL_SITE_SUBSET) ? 2 : 1;
+      const size_t parityBytes = (size_t)stride*nColor*nSpin*2*precision;
+      for (int parity=0; parity<nParity; parity++) {
+	cudaMemcpy((char*)v + parity*(bytes/2), (char*)src.V() + parity*(src.Bytes()/2),
+		   parityBytes, cudaMemcpyHostToDevice);
+	if (precision == QUDA_HALF_PRECISION)
+	  cudaMemcpy((char*)norm + parity*(norm_bytes/2), (char*)src.Norm() + parity*(src.NormBytes()/2),
+		     stride*sizeof(float), cudaMemcpyHostToDevice);
+      }
+    } else if ((REORDER_LOCATION == QUDA_CPU_FIELD_LOCATION || src.SiteOrder() == QUDA_MORTON_SITE_ORDER) &&
+	       typeid(src) == typeid(cpuColorSpinorField)) { // the Morton order is only converted on the host
       resizeBufferPinned(bytes + norm_bytes);
       memset(bufferPinned, 0, bytes+norm_bytes); // FIXME (temporary?) bug fix for padding
 
@@ -422,8 +443,18 @@ namespace quda {
 
   void cudaColorSpinorField::saveSpinorField(ColorSpinorField &dest) const {
 
-    if (REORDER_LOCATION == QUDA_CPU_FIELD_LOCATION && 
-	typeid(dest) == typeid(cpuColorSpinorField)) {
+    if (directCopy(dest)) {
+      const int nParity = (siteSubset == QUDA_FULL_SITE_SUBSET) ? 2 : 1;
+      const size_t parityBytes = (size_t)stride*nColor*nSpin*2*precision;
+      for (int parity=0; parity<nParity; parity++) {
+	cudaMemcpy((char*)dest.V() + parity*(dest.Bytes()/2), (char*)v + parity*(bytes/2),
+		   parityBytes, cudaMemcpyDeviceToHost);
+	if (precision == QUDA_HALF_PRECISION)
+	  cudaMemcpy((char*)dest.Norm() + parity*(dest.NormBytes()/2), (char*)norm + parity*(norm_bytes/2),
+		     stride*sizeof(float), cudaMemcpyDeviceToHost);
+      }
+    } else if ((REORDER_LOCATION == QUDA_CPU_FIELD_LOCATION || dest.SiteOrder() == QUDA_MORTON_SITE_ORDER) &&
+	       typeid(dest) == typeid(cpuColorSpinorField)) {
       resizeBufferPinned(bytes+norm_bytes);
       cudaMemcpy(bufferPinned, v, bytes, cudaMemcpyDeviceToHost);
       cudaMemcpy((char*)bufferPinned+bytes, norm, norm_bytes, cudaMemcpyDeviceToHost);
@@ -1,4 +1,5 @@
 #include <string.h>
+#include <stdlib.h>
 #include <gauge_field.h>
 #include <face_quda.h>
 #include <typeinfo>
@@ -190,14 +191,18 @@ namespace quda {
       copyGenericGauge(*this, src, QUDA_CUDA_FIELD_LOCATION, gauge, 
           static_cast<const cudaGaugeField&>(src).gauge);
     } else if (typeid(src) == typeid(cpuGaugeField)) {
-      LatticeField::resizeBufferPinned(bytes);
+      const cpuGaugeField &cpu = static_cast<const cpuGaugeField&>(src);
+      if (streamable(cpu)) {
+	copySlabs(cpu);
+      } else {
+	LatticeField::resizeBufferPinned(bytes);
 
-      // copy field and ghost zone into bufferPinned
-      copyGenericGauge(*this, src, QUDA_CPU_FIELD_LOCATION, bufferPinned, 
-          static_cast<const cpuGaugeField&>(src).gauge); 
+	// copy field and ghost zone into bufferPinned
+	copyGenericGauge(*this, src, QUDA_CPU_FIELD_LOCATION, bufferPinned, cpu.gauge);
 
-      // this copies over both even and odd
-      cudaMemcpy(gauge, bufferPinned, bytes, cudaMemcpyHostToDevice);
+	// this copies over both even and odd
+	cudaMemcpy(gauge, bufferPinned, bytes, cudaMemcpyHostToDevice);
+      }
     } else {
       errorQuda("Invalid gauge field type");
     }
@@ -205,6 +210,115 @@ namespace quda {
     checkCudaError();
   }
 
+  // size of the buffers used to stream host fields to the device, 0 to stage the whole field
+  static size_t stagingBytes() {
+    static bool init = false;
+    static size_t bytes = (size_t)64 << 20;
+    if (!init) {
+      char *env = getenv("QUDA_GAUGE_STAGING_MB");
+      if (env) bytes = (size_t)atol(env) << 20;
+      init = true;
+    }
+    return bytes;
+  }
+
+  /**
+     Can copy() stream this host field in slabs?  This requires a
+     native order without stored phases and one of the host orders
+     of copyGenericGaugeSlab.
+  */
+  bool cudaGaugeField::streamable(const cpuGaugeField &cpu) const {
+    if (stagingBytes() == 0) return false;
+    if (order != QUDA_FLOAT2_GAUGE_ORDER && order != QUDA_FLOAT4_GAUGE_ORDER) return false;
+    if (reconstruct != QUDA_RECONSTRUCT_NO && reconstruct != QUDA_RECONSTRUCT_12 &&
+	reconstruct != QUDA_RECONSTRUCT_8) return false;
+    if (link_type == QUDA_ASQTAD_MOM_LINKS || cpu.LinkType() == QUDA_ASQTAD_MOM_LINKS) return false;
+    if (cpu.Order() != QUDA_QDP_GAUGE_ORDER && cpu.Order() != QUDA_CPS_WILSON_GAUGE_ORDER &&
+	cpu.Order() != QUDA_MILC_GAUGE_ORDER && cpu.Order() != QUDA_BQCD_GAUGE_ORDER &&
+	cpu.Order() != QUDA_AOSOA_GAUGE_ORDER) return false;
+    return volumeCB % x[3] == 0;
+  }
+
+  /**
+     Copy a host field to the device a slab of t-slices at a time, so
+     that the staging memory is bounded by QUDA_GAUGE_STAGING_MB rather
+     than the size of the field.  Two staging buffers are used so that
+     the host reordering of one slab overlaps the transfer of the
+     previous one.
+  */
+  void cudaGaugeField::copySlabs(const cpuGaugeField &cpu)
+  {
+    const int N = (order == QUDA_FLOAT2_GAUGE_ORDER) ? 2 : 4;
+    const int M = reconstruct / N; // rows per dimension and parity
+    const size_t rowBytes = N*precision; // bytes per site of each row
+
+    const int sliceCB = volumeCB / x[3];
+    int nt = stagingBytes() / (2*4*M*sliceCB*rowBytes);
+    if (nt < 1) nt = 1;
+    if (nt > x[3]) nt = x[3];
+    const size_t slabBytes = 2*4*M*nt*sliceCB*rowBytes;
+    const int nBuffer = (nt < x[3]) ? 2 : 1;
+
+    size_t ghostBytes = 0;
+#ifdef MULTI_GPU
+    const bool doGhost = cpu.GhostInit() && ghostInit;
+    if (doGhost) for (int d=0; d<4; d++) ghostBytes += 2*M*surfaceCB[d]*nFace*rowBytes;
+#endif
+    resizeBufferPinned(nBuffer*slabBytes > ghostBytes ? nBuffer*slabBytes : ghostBytes);
+    char *buffer[2] = { (char*)bufferPinned, (char*)bufferPinned + slabBytes };
+
+    cudaStream_t stream;
+    cudaEvent_t done[2];
+    cudaStreamCreate(&stream);
+    for (int i=0; i<2; i++) cudaEventCreateWithFlags(&done[i], cudaEventDisableTiming);
+
+    for (int k=0, t=0; t<x[3]; k++, t+=nt) {
+      const int offset = t*sliceCB;
+      const int sites = ((t+nt < x[3]) ? nt : x[3]-t) * sliceCB;
+      char *buf = buffer[k%nBuffer];
+
+      // wait for the earlier transfer out of this buffer, then reorder into it
+      cudaEventSynchronize(done[k%nBuffer]);
+      copyGenericGaugeSlab(*this, cpu, buf, 0, offset, sites);
+
+      // each parity of the slab is 4*M rows of sites*rowBytes, strided by stride on the device
+      for (int parity=0; parity<2; parity++) {
+	cudaMemcpy2DAsync((char*)gauge + parity*(bytes/2) + offset*rowBytes, stride*rowBytes,
+			  buf + parity*4*M*sites*rowBytes, sites*rowBytes,
+			  sites*rowBytes, 4*M, cudaMemcpyHostToDevice, stream);
+      }
+      cudaEventRecord(done[k%nBuffer], stream);
+    }
+    cudaStreamSynchronize(stream);
+
+#ifdef MULTI_GPU
+    // stage the ghost zone compactly and copy it into the padded region
+    if (doGhost) {
+      void *ghost[4];
+      char *g = (char*)bufferPinned;
+      for (int d=0; d<4; d++) {
+	ghost[d] = g;
+	g += 2*M*surfaceCB[d]*nFace*rowBytes;
+      }
+      copyGenericGauge(*this, cpu, QUDA_CPU_FIELD_LOCATION, 0, 0, ghost, 0, 1);
+
+      for (int d=0; d<4; d++) {
+	const int faceCB = surfaceCB[d]*nFace;
+	for (int parity=0; parity<2; parity++) {
+	  cudaMemcpy2DAsync((char*)gauge + parity*(bytes/2) + (d*M*stride + volumeCB)*rowBytes, stride*rowBytes,
+			    (char*)ghost[d] + parity*M*faceCB*rowBytes, faceCB*rowBytes,
+			    faceCB*rowBytes, M, cudaMemcpyHostToDevice, stream);
+	}
+      }
+      cudaStreamSynchronize(stream);
+    }
+#endif
+
+    for (int i=0; i<2; i++) cudaEventDestroy(done[i]);
+    cudaStreamDestroy(stream);
+    checkCudaError();
+  }
+
   void cudaGaugeField::loadCPUField(const cpuGaugeField &cpu, const QudaFieldLocation &pack_location)
   {
     if (geometry != QUDA_VECTOR_GEOMETRY) errorQuda("Only vector geometry is supported");
@@ -305,6 +419,7 @@ namespace quda {
       cudaMemcpy(bufferPinned, gauge, bytes, cudaMemcpyDeviceToHost);
       checkCudaError();
 
+      if (link_type == QUDA_ASQTAD_FAT_LINKS) cpu.fat_link_max = fat_link_max;
       copyGenericGauge(cpu, *this, QUDA_CPU_FIELD_LOCATION, cpu.gauge, bufferPinned);
     } else {
       errorQuda("Invalid pack location %d", pack_location);
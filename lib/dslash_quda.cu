@@ -510,7 +510,72 @@ namespace quda {
       ps << "shared=" << param.shared_bytes;
       return ps.str();
     }
-    virtual int Nface() { return 2; }
+    virtual int Nface() const { return 2; }
+
+    /** bytes per site of a spinor field, including the norm in half precision */
+    static long long siteBytes(const cudaColorSpinorField &f, int nspin)
+    {
+      return 2ll*f.Ncolor()*nspin*f.Precision() + (f.Precision() == QUDA_HALF_PRECISION ? sizeof(float) : 0);
+    }
+
+    /** the number of sites on one face of the checkerboarded input field in dimension d */
+    long long faceSites(int d) const
+    {
+      const int X = (d == 0) ? 2*in->X(0) : in->X(d); // full-lattice extent
+      return in->Volume() / X;
+    }
+
+    /**
+     * The number of neighbour contributions that the interior kernel
+     * skips because they come from a ghost zone, given the number of
+     * neighbour hops (depth) on each side of a partitioned dimension.
+     */
+    long long ghostNeighbours(int depth) const
+    {
+      long long n = 0;
+#ifdef MULTI_GPU
+      for (int d=0; d<4; d++) if (dslashParam.commDim[d]) n += 2*depth*faceSites(d);
+#endif
+      return n;
+    }
+
+    /**
+     * Bytes moved by a Wilson-like kernel (one neighbour on each side in
+     * each of four dimensions).  The interior kernel reads a spinor and
+     * a link for every neighbour that is not in a ghost zone, any per-site
+     * terms (site_bytes, e.g., the clover term) and the Xpay spinor, and
+     * writes the output.  The exterior kernel for a dimension reads the
+     * spin-projected ghost spinor and the link of each boundary site and
+     * updates its output.
+     */
+    long long wilsonBytes(long long link_bytes, long long site_bytes) const
+    {
+      const long long in_bytes = siteBytes(*in, in->Nspin());
+      const long long out_bytes = siteBytes(*out, out->Nspin());
+      if (dslashParam.kernel_type == INTERIOR_KERNEL) {
+	const long long V = in->Volume();
+	const long long x_bytes = x ? siteBytes(*x, x->Nspin()) : 0;
+	return (8*V - ghostNeighbours(1))*(in_bytes + link_bytes) + V*(out_bytes + x_bytes + site_bytes);
+      } else {
+	const long long sites = 2*faceSites(dslashParam.kernel_type);
+	const long long ghost_bytes = siteBytes(*in, in->Nspin()/2);
+	return sites*(ghost_bytes + link_bytes + 2*out_bytes);
+      }
+    }
+
+    /**
+     * Flops of a Wilson-like kernel: site_flops per site for the interior
+     * kernel, less nbr_flops for every neighbour in a ghost zone, which
+     * the exterior kernel then contributes.
+     */
+    long long wilsonFlops(long long site_flops, long long nbr_flops) const
+    {
+      if (dslashParam.kernel_type == INTERIOR_KERNEL) {
+	return site_flops*in->Volume() - nbr_flops*ghostNeighbours(1);
+      } else {
+	return nbr_flops*2*faceSites(dslashParam.kernel_type);
+      }
+    }
 
     virtual void preTune()
     {
@@ -736,6 +801,7 @@ namespace quda {
       recon << reconstruct;
       key.aux += ",reconstruct=" + recon.str();
       if (x) key.aux += ",Xpay";
+      key.rehash();
       return key;
     }
 
@@ -751,7 +817,9 @@ namespace quda {
 	     (sFloat*)in->V(), (float*)in->Norm(), (sFloat*)(x ? x->V() : 0), (float*)(x ? x->Norm() : 0), a);
     }
 
-    long long flops() const { return (x ? 1368ll : 1320ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    // projection (12), matrix-vector (132) and accumulation (24) per neighbour
+    long long flops() const { return wilsonFlops(x ? 1368ll : 1320ll, 168ll); }
+    long long bytes() const { return wilsonBytes(reconstruct*sizeof(((gFloat*)0)->x), 0); }
   };
 
   template <typename sFloat, typename gFloat, typename cFloat>
@@ -799,6 +867,7 @@ namespace quda {
       recon << reconstruct;
       key.aux += ",reconstruct=" + recon.str();
       if (x) key.aux += ",Xpay";
+      key.rehash();
       return key;
     }
 
@@ -814,7 +883,11 @@ namespace quda {
 	     (sFloat*)in->V(), (float*)in->Norm(), (sFloat*)(x ? x->V() : 0), (float*)(x ? x->Norm() : 0), a);
     }
 
-    long long flops() const { return (x ? 1872ll : 1824ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long flops() const { return wilsonFlops(x ? 1872ll : 1824ll, 168ll); }
+    long long bytes() const {
+      const size_t clover_bytes = 72*sizeof(((cFloat*)0)->x) + (cloverNorm ? 2*sizeof(float) : 0);
+      return wilsonBytes(reconstruct*sizeof(((gFloat*)0)->x), clover_bytes);
+    }
   };
 
   template <typename sFloat, typename gFloat, typename cFloat>
@@ -863,6 +936,7 @@ namespace quda {
       std::stringstream recon;
       recon << reconstruct;
       key.aux += ",reconstruct=" + recon.str() + ",Xpay";
+      key.rehash();
       return key;
     }
 
@@ -878,7 +952,11 @@ namespace quda {
 		  (sFloat*)in->V(), (float*)in->Norm(), (sFloat*)x, (float*)x->Norm(), a);
     }
 
-    long long flops() const { return 1872ll * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long flops() const { return wilsonFlops(1872ll, 168ll); }
+    long long bytes() const {
+      const size_t clover_bytes = 72*sizeof(((cFloat*)0)->x) + (cloverNorm ? 2*sizeof(float) : 0);
+      return wilsonBytes(reconstruct*sizeof(((gFloat*)0)->x), clover_bytes);
+    }
   };
 
   void setTwistParam(double &a, double &b, const double &kappa, const double &mu, 
@@ -960,6 +1038,7 @@ namespace quda {
         break;
       }
       if (x) key.aux += "Xpay";
+      key.rehash();
       return key;
     }
 
@@ -996,7 +1075,8 @@ namespace quda {
       }
     }
 
-    long long flops() const { return (x ? 1416ll : 1392ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    long long flops() const { return wilsonFlops(x ? 1416ll : 1392ll, 168ll); }
+    long long bytes() const { return wilsonBytes(reconstruct*sizeof(((gFloat*)0)->x), 0); }
   };
 
   template <typename sFloat, typename gFloat>
@@ -1105,6 +1185,7 @@ namespace quda {
       key.volume += "x" + ls.str();
       key.aux += ",reconstruct=" + recon.str();
       if (x) key.aux += ",Xpay";
+      key.rehash();
       return key;
     }
 
@@ -1116,10 +1197,19 @@ namespace quda {
 	     (sFloat*)in->V(), (float*)in->Norm(), mferm, (sFloat*)(x ? x->V() : 0), (float*)(x ? x->Norm() : 0), a);
     }
 
-    long long flops() const { // FIXME for multi-GPU
+    long long flops() const {
+      if (dslashParam.kernel_type != INTERIOR_KERNEL) return wilsonFlops(0, 168ll);
       long long bulk = (dslashConstants.Ls-2)*(dslashConstants.VolumeCB()/dslashConstants.Ls);
       long long wall = 2*dslashConstants.VolumeCB()/dslashConstants.Ls;
-      return (x ? 1368ll : 1320ll)*dslashConstants.VolumeCB()*dslashConstants.Ls + 96ll*bulk + 120ll*wall;
+      return (x ? 1368ll : 1320ll)*dslashConstants.VolumeCB()*dslashConstants.Ls + 96ll*bulk + 120ll*wall
+	- 168ll*ghostNeighbours(1);
+    }
+
+    // the fifth-dimension hops read two more spinors per site
+    long long bytes() const {
+      long long bytes = wilsonBytes(reconstruct*sizeof(((gFloat*)0)->x), 0);
+      if (dslashParam.kernel_type == INTERIOR_KERNEL) bytes += 2ll*in->Volume()*siteBytes(*in, in->Nspin());
+      return bytes;
     }
   };
 
@@ -1172,6 +1262,7 @@ namespace quda {
       recon << reconstruct;
       key.aux += ",reconstruct=" + recon.str();
       if (x) key.aux += ",Axpy";
+      key.rehash();
       return key;
     }
 
@@ -1184,9 +1275,36 @@ namespace quda {
 		       (sFloat*)in->V(), (float*)in->Norm(), (sFloat*)(x ? x->V() : 0), (float*)(x ? x->Norm() : 0), a);
     }
 
-    int Nface() { return 6; }
+    int Nface() const { return 6; }
 
-    long long flops() const { return (x ? 1158ll : 1146ll) * dslashConstants.VolumeCB(); } // FIXME for multi-GPU
+    /**
+     * Matrix-vector (66) and accumulation (6) per fat and long
+     * neighbour.  Ghost contributions come from one site deep for the
+     * fat links and three deep for the long links.
+     */
+    long long flops() const {
+      if (dslashParam.kernel_type == INTERIOR_KERNEL) {
+	return (x ? 1158ll : 1146ll)*in->Volume() - 72ll*(ghostNeighbours(1) + ghostNeighbours(3));
+      } else {
+	return 72ll*(2 + 6)*faceSites(dslashParam.kernel_type);
+      }
+    }
+
+    long long bytes() const {
+      const long long fat_bytes = 18*sizeof(((fatGFloat*)0)->x);
+      const long long long_bytes = reconstruct*sizeof(((longGFloat*)0)->x);
+      const long long in_bytes = siteBytes(*in, 1);
+      const long long out_bytes = siteBytes(*out, 1);
+      if (dslashParam.kernel_type == INTERIOR_KERNEL) {
+	const long long V = in->Volume();
+	const long long x_bytes = x ? siteBytes(*x, 1) : 0;
+	return (8*V - ghostNeighbours(1))*(in_bytes + fat_bytes) +
+	  (8*V - ghostNeighbours(3))*(in_bytes + long_bytes) + V*(out_bytes + x_bytes);
+      } else {
+	const long long face = faceSites(dslashParam.kernel_type);
+	return 6*face*(in_bytes + long_bytes + 2*out_bytes) + 2*face*(in_bytes + fat_bytes);
+      }
+    }
   };
 
   int gatherCompleted[Nstream];
@@ -1234,6 +1352,7 @@ namespace quda {
 
   void dslashCuda(DslashCuda &dslash, const size_t regSize, const int parity, const int dagger, 
 		  const int volume, const int *faceVolumeCB, TimeProfile &profile) {
+    TraceScope scope("dslash");
     profile.Start(QUDA_PROFILE_TOTAL);
 
     dslashParam.parity = parity;
@@ -1361,6 +1480,7 @@ namespace quda {
   */
   void dslashZeroCopyCuda(DslashCuda &dslash, const size_t regSize, const int parity, const int dagger, 
 			  const int volume, const int *faceVolumeCB, TimeProfile &profile) {
+    TraceScope scope("dslash");
     profile.Start(QUDA_PROFILE_TOTAL);
 
     dslashParam.parity = parity;
@@ -1934,6 +2054,10 @@ namespace quda {
     }
 
     long long flops() const { return 504ll * dslashConstants.VolumeCB(); }
+    long long bytes() const {
+      const size_t clover_bytes = 72*sizeof(((cFloat*)0)->x) + (cloverNorm ? 2*sizeof(float) : 0);
+      return in->Bytes() + in->NormBytes() + out->Bytes() + out->NormBytes() + in->Volume()*clover_bytes;
+    }
   };
 
 
@@ -1,4 +1,5 @@
 #include <gauge_field_order.h>
+#include <host_thread_quda.h>
 
 namespace quda {
   template <typename Order, int nDim>
@@ -26,63 +27,19 @@ namespace quda {
   };
 
   /**
-     Generic CPU gauge ghost extraction and packing
-     NB This routines is specialized to four dimensions
-  */
-  template <typename Float, int length, int nDim, typename Order>
-  void extractGhost(ExtractGhostArg<Order,nDim> arg) {  
-    typedef typename mapper<Float>::type RegType;
-
-    for (int parity=0; parity<2; parity++) {
-
-      for (int dim=0; dim<nDim; dim++) {
-
-	// linear index used for writing into ghost buffer
-	int indexDst = 0;
-	// the following 4-way loop means this is specialized for 4 dimensions 
-
-	// FIXME redefine a, b, c, d such that we always optimize for locality
-	for (int d=arg.X[dim]-arg.nFace; d<arg.X[dim]; d++) { // loop over last nFace faces in this dimension
-	  for (int a=0; a<arg.A[dim]; a++) { // loop over the surface elements of this face
-	    for (int b=0; b<arg.B[dim]; b++) { // loop over the surface elements of this face
-	      for (int c=0; c<arg.C[dim]; c++) { // loop over the surface elements of this face
-		// index is a checkboarded spacetime coordinate
-		int indexCB = (a*arg.f[dim][0] + b*arg.f[dim][1] + c*arg.f[dim][2] + d*arg.f[dim][3]) >> 1;
-		// we only do the extraction for parity we are currently working on
-		int oddness = (a+b+c+d) & 1;
-		if (oddness == parity) {
-		  RegType u[length];
-		  arg.order.load(u, indexCB, dim, parity); // load the ghost element from the bulk
-		  arg.order.saveGhost(u, indexDst, dim, (parity+arg.localParity[dim])&1);
-		  indexDst++;
-		} // oddness == parity
-	      } // c
-	    } // b
-	  } // a
-	} // d
-
-	//assert(indexDst == arg.nFace*arg.surfaceCB[dim]);
-	assert(indexDst == arg.order.faceVolumeCB[dim]);
-      } // dim
-
-    } // parity
-
-  }
-
-  /**
-     Generic GPU gauge ghost extraction and packing
+     Generic gauge ghost extraction and packing of face element X,
+     where X = ((d * A + a)*B + b)*C + c, in all dimensions.  Used by
+     both the CPU and GPU versions.
      NB This routines is specialized to four dimensions
      FIXME this implementation will have two-way warp divergence
   */
   template <typename Float, int length, int nDim, typename Order>
-  __global__ void extractGhostKernel(ExtractGhostArg<Order,nDim> arg) {  
+  __device__ __host__ inline void extractGhostCompute(ExtractGhostArg<Order,nDim> &arg, int X) {
     typedef typename mapper<Float>::type RegType;
 
     for (int parity=0; parity<2; parity++) {
       for (int dim=0; dim<nDim; dim++) {
 
-	// linear index used for writing into ghost buffer
-	int X = blockIdx.x * blockDim.x + threadIdx.x; 	
 	//if (X >= 2*arg.nFace*arg.surfaceCB[dim]) continue;
 	if (X >= 2*arg.order.faceVolumeCB[dim]) continue;
 	// X = ((d * A + a)*B + b)*C + c
@@ -97,6 +54,7 @@ namespace quda {
 	// index is a checkboarded spacetime coordinate
 	int indexCB = (a*arg.f[dim][0] + b*arg.f[dim][1] + c*arg.f[dim][2] + d*arg.f[dim][3]) >> 1;
 	// we only do the extraction for parity we are currently working on
+	// (the destination index X>>1 counts the matching elements since C is even)
 	int oddness = (a+b+c+d)&1;
 	if (oddness == parity) {
 	  RegType u[length];
@@ -110,6 +68,25 @@ namespace quda {
 
   }
 
+  /**
+     Generic CPU gauge ghost extraction and packing
+  */
+  template <typename Float, int length, int nDim, typename Order>
+  struct ExtractGhostSite {
+    ExtractGhostArg<Order,nDim> &arg;
+    ExtractGhostSite(ExtractGhostArg<Order,nDim> &arg) : arg(arg) { }
+    void operator()(int X) const { extractGhostCompute<Float,length,nDim,Order>(arg, X); }
+  };
+
+  /**
+     Generic GPU gauge ghost extraction and packing
+  */
+  template <typename Float, int length, int nDim, typename Order>
+  __global__ void extractGhostKernel(ExtractGhostArg<Order,nDim> arg) {  
+    int X = blockIdx.x * blockDim.x + threadIdx.x; 	
+    extractGhostCompute<Float,length,nDim,Order>(arg, X);
+  }
+
   template <typename Float, int length, int nDim, typename Order>
   class ExtractGhost : Tunable {
     ExtractGhostArg<Order,nDim> arg;
@@ -194,7 +171,19 @@ namespace quda {
 
     ExtractGhostArg<Order, nDim> arg(order, nFace, X, A, B, C, f, localParity);
     if (location==QUDA_CPU_FIELD_LOCATION) {
-      extractGhost<Float,length,nDim,Order>(arg);
+      int faceMax = 0, sites = 0;
+      for (int d=0; d<nDim; d++) {
+	faceMax = (arg.order.faceVolumeCB[d] > faceMax) ? arg.order.faceVolumeCB[d] : faceMax;
+	sites += arg.order.faceVolumeCB[d];
+      }
+      std::stringstream vol, aux;
+      vol << arg.order.volumeCB; 
+      aux << "stride=" << arg.order.stride;
+      ExtractGhostSite<Float,length,nDim,Order> site(arg);
+      TunableHostLoop<ExtractGhostSite<Float,length,nDim,Order> >
+	extract(site, 2*faceMax, TuneKey(vol.str(), typeid(site).name(), aux.str()),
+		0, 2 * sites * 2 * arg.order.Bytes());
+      extract.apply(0);
     } else {
       ExtractGhost<Float,length,nDim,Order> extract(arg);
       extract.apply(0);
@@ -255,11 +244,36 @@ namespace quda {
 	extractGhost<Float,length>(FloatNOrder<Float,length,4,9>(u, 0, Ghost),
 				   u.Nface(), u.SurfaceCB(), u.X(), location);
       }
+    } else if (u.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length,12>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	extractGhost<Float,length>(AoSoAOrder<Float,length,8>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", u.Reconstruct(), u.Order());
+      }
+
     } else if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
       
 #ifdef BUILD_QDP_INTERFACE
-      extractGhost<Float,length>(QDPOrder<Float,length>(u, 0, Ghost),
-				 u.Nface(), u.SurfaceCB(), u.X(), location);
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	extractGhost<Float,length>(QDPOrder<Float,length>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	extractGhost<Float,length>(QDPOrder<Float,length,12>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	extractGhost<Float,length>(QDPOrder<Float,length,8>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", u.Reconstruct(), u.Order());
+      }
 #else
       errorQuda("QDP interface has not been built\n");
 #endif
@@ -285,8 +299,18 @@ namespace quda {
     } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
 
 #ifdef BUILD_MILC_INTERFACE
-      extractGhost<Float,length>(MILCOrder<Float,length>(u, 0, Ghost),
-				 u.Nface(), u.SurfaceCB(), u.X(), location);
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	extractGhost<Float,length>(MILCOrder<Float,length>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	extractGhost<Float,length>(MILCOrder<Float,length,12>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	extractGhost<Float,length>(MILCOrder<Float,length,8>(u, 0, Ghost),
+				   u.Nface(), u.SurfaceCB(), u.X(), location);
+      } else {
+	errorQuda("Reconstruction %d and order %d not supported", u.Reconstruct(), u.Order());
+      }
 #else
       errorQuda("MILC interface has not been built\n");
 #endif
@@ -3,6 +3,7 @@
 #include <dslash_quda.h>
 
 #include <string.h>    
+#include <math.h>
 
 using namespace quda;
 
@@ -10,6 +11,82 @@ cudaStream_t *stream;
 
 bool globalReduce = true;
 
+// precision used for halo messages (QUDA_INVALID_PRECISION = native)
+QudaPrecision FaceBuffer::haloPrecision = QUDA_INVALID_PRECISION;
+
+// whether host gauge ghost exchanges are compressed
+bool FaceBuffer::ghostCompression = false;
+
+void FaceBuffer::setHaloPrecision(QudaPrecision precision) { haloPrecision = precision; }
+
+void FaceBuffer::setGhostCompression(bool compress) { ghostCompression = compress; }
+
+bool FaceBuffer::GhostCompression() { return ghostCompression; }
+
+
+/**
+ * Convert a face into a lower precision for sending.  The face is
+ * stored as Nint/Nvec blocks of sites x Nvec reals.  For half
+ * precision, each site is normalized by its maximum absolute value,
+ * and the per-site norms follow the short data.
+ */
+template <typename Float>
+static void packHalo(void *dst, const Float *src, int sites, int Nint, int Nvec, QudaPrecision prec)
+{
+  const int length = sites*Nint;
+  if (prec == QUDA_SINGLE_PRECISION) {
+    float *d = (float*)dst;
+    for (int i=0; i<length; i++) d[i] = src[i];
+  } else if (prec == QUDA_HALF_PRECISION) {
+    short *d = (short*)dst;
+    float *norm = (float*)(d + length);
+    for (int x=0; x<sites; x++) {
+      Float max = 0.0;
+      for (int b=0; b<Nint/Nvec; b++)
+	for (int k=0; k<Nvec; k++) {
+	  Float v = fabs(src[(b*sites+x)*Nvec+k]);
+	  if (v > max) max = v;
+	}
+      norm[x] = max;
+      Float scale = max > 0.0 ? MAX_SHORT/max : 0.0;
+      for (int b=0; b<Nint/Nvec; b++)
+	for (int k=0; k<Nvec; k++) {
+	  int i = (b*sites+x)*Nvec+k;
+	  d[i] = (short)floor(scale*src[i] + 0.5);
+	}
+    }
+  } else {
+    errorQuda("Halo precision %d not supported", prec);
+  }
+}
+
+
+/**
+ * Expand a received lower-precision face back to the native precision.
+ */
+template <typename Float>
+static void unpackHalo(Float *dst, const void *src, int sites, int Nint, int Nvec, QudaPrecision prec)
+{
+  const int length = sites*Nint;
+  if (prec == QUDA_SINGLE_PRECISION) {
+    const float *s = (const float*)src;
+    for (int i=0; i<length; i++) dst[i] = s[i];
+  } else if (prec == QUDA_HALF_PRECISION) {
+    const short *s = (const short*)src;
+    const float *norm = (const float*)(s + length);
+    for (int x=0; x<sites; x++) {
+      Float scale = norm[x] / MAX_SHORT;
+      for (int b=0; b<Nint/Nvec; b++)
+	for (int k=0; k<Nvec; k++) {
+	  int i = (b*sites+x)*Nvec+k;
+	  dst[i] = scale*s[i];
+	}
+    }
+  } else {
+    errorQuda("Halo precision %d not supported", prec);
+  }
+}
+
 
 FaceBuffer::FaceBuffer(const int *X, const int nDim, const int Ninternal, 
 		       const int nFace, const QudaPrecision precision, const int Ls) :
@@ -25,12 +102,29 @@ FaceBuffer::FaceBuffer(const int *X, const int nDim, const int Ninternal,
   recFwdStrmIdx = sendBackStrmIdx;
   recBackStrmIdx = sendFwdStrmIdx;
 
+  // the precision halos are sent in can only be lower than the native one
+  commsPrecision = (haloPrecision != QUDA_INVALID_PRECISION && haloPrecision < precision) ?
+    haloPrecision : precision;
+#ifdef QUDA_CALLBACK
+  commsPrecision = precision; // the comms callback can only do a straight copy
+#endif
+
+  // separate network buffers are needed if we are not using GPUDirect
+  // or if the halo is converted to a different precision
+#ifdef GPU_DIRECT
+  staging = (commsPrecision != precision);
+#else
+  staging = true;
+#endif
+
   // allocate a single contiguous buffer for the buffers
   size_t faceBytes = 0;
   for (int i=0; i<nDimComms; i++) {
     nbytes[i] = nFace*faceVolumeCB[i]*Ninternal*precision;
+    commsBytes[i] = nFace*faceVolumeCB[i]*Ninternal*commsPrecision;
     // add extra space for the norms for half precision
     if (precision == QUDA_HALF_PRECISION) nbytes[i] += nFace*faceVolumeCB[i]*sizeof(float);
+    if (commsPrecision == QUDA_HALF_PRECISION) commsBytes[i] += nFace*faceVolumeCB[i]*sizeof(float);
     if(!commDimPartitioned(i)) continue;
     faceBytes += 2*nbytes[i];
   }
@@ -40,38 +134,80 @@ FaceBuffer::FaceBuffer(const int *X, const int nDim, const int Ninternal,
     from_face = allocatePinned(faceBytes);
   }
 
+  // Determine which dimensions can use a single aggregated message:
+  // if both neighbours are the same rank, the forwards and backwards
+  // faces can be sent together.  This is the only case in which two
+  // faces of a nearest-neighbour exchange go to the same rank, except
+  // for degenerate grids where neighbours in different dimensions
+  // coincide.  Faces of different dimensions are not aggregated, since
+  // the dslash packs, sends and consumes each dimension separately to
+  // overlap the exchange with the interior and the other dimensions.
+  for (int i=0; i<nDimComms; i++) {
+    aggregate[i] = false;
+    facesReady[i] = 0;
+    aggregateDone[i] = false;
+#ifndef QUDA_CALLBACK
+    if (!commDimPartitioned(i)) continue;
+    int disp[QUDA_MAX_DIM] = {0};
+    disp[i] = +1;
+    int fwd_rank = comm_rank_displaced(comm_default_topology(), disp);
+    disp[i] = -1;
+    int back_rank = comm_rank_displaced(comm_default_topology(), disp);
+    aggregate[i] = (fwd_rank == back_rank);
+#endif
+  }
+
   // assign Buffers hold half spinors
   size_t offset = 0;
   for (int i=0; i<nDimComms; i++) {
     if (!commDimPartitioned(i)) continue;
 
+    // The send buffers are ordered (back, fwd).  The neighbour's
+    // backwards face arrives as our forwards ghost, so for aggregated
+    // dimensions the receive buffers are ordered (fwd, back) to match.
     my_back_face[i] = (char*)my_face + offset;
-    from_back_face[i] = (char*)from_face + offset;
-    offset += nbytes[i];
-
-    my_fwd_face[i] = (char*)my_face + offset;
-    from_fwd_face[i] = (char*)from_face + offset;
-    offset += nbytes[i];
-
-#ifdef GPU_DIRECT //  just alias the pointer
-    ib_my_fwd_face[i] = my_fwd_face[i];
-    ib_my_back_face[i] = my_back_face[i];
-    ib_from_fwd_face[i] = from_fwd_face[i];
-    ib_from_back_face[i] = from_back_face[i];
-#else // if no GPUDirect so need separate IB and GPU host buffers
-    ib_my_fwd_face[i] = safe_malloc(nbytes[i]);
-    ib_my_back_face[i] = safe_malloc(nbytes[i]);
-    ib_from_fwd_face[i] = safe_malloc(nbytes[i]);
-    ib_from_back_face[i] = safe_malloc(nbytes[i]);
-#endif
+    my_fwd_face[i] = (char*)my_face + offset + nbytes[i];
+    if (aggregate[i]) {
+      from_fwd_face[i] = (char*)from_face + offset;
+      from_back_face[i] = (char*)from_face + offset + nbytes[i];
+    } else {
+      from_back_face[i] = (char*)from_face + offset;
+      from_fwd_face[i] = (char*)from_face + offset + nbytes[i];
+    }
+    offset += 2*nbytes[i];
+
+    if (!staging) { //  just alias the pointer
+      ib_my_fwd_face[i] = my_fwd_face[i];
+      ib_my_back_face[i] = my_back_face[i];
+      ib_from_fwd_face[i] = from_fwd_face[i];
+      ib_from_back_face[i] = from_back_face[i];
+    } else if (aggregate[i]) { // need separate IB and GPU host buffers
+      ib_my_back_face[i] = safe_malloc(2*commsBytes[i]);
+      ib_my_fwd_face[i] = (char*)ib_my_back_face[i] + commsBytes[i];
+      ib_from_fwd_face[i] = safe_malloc(2*commsBytes[i]);
+      ib_from_back_face[i] = (char*)ib_from_fwd_face[i] + commsBytes[i];
+    } else {
+      ib_my_fwd_face[i] = safe_malloc(commsBytes[i]);
+      ib_my_back_face[i] = safe_malloc(commsBytes[i]);
+      ib_from_fwd_face[i] = safe_malloc(commsBytes[i]);
+      ib_from_back_face[i] = safe_malloc(commsBytes[i]);
+    }
   }
 
   for (int i=0; i<nDimComms; i++) {
     if (!commDimPartitioned(i)) continue;
-    mh_send_fwd[i] = comm_declare_send_relative(ib_my_fwd_face[i], i, 1, nbytes[i]);
-    mh_send_back[i] = comm_declare_send_relative(ib_my_back_face[i], i, -1, nbytes[i]);
-    mh_recv_fwd[i] = comm_declare_receive_relative(ib_from_fwd_face[i], i, +1, nbytes[i]);
-    mh_recv_back[i] = comm_declare_receive_relative(ib_from_back_face[i], i, -1, nbytes[i]);
+    if (aggregate[i]) {
+      // a single message in each direction carrying both faces
+      mh_send_back[i] = comm_declare_send_relative(ib_my_back_face[i], i, -1, 2*commsBytes[i]);
+      mh_recv_fwd[i] = comm_declare_receive_relative(ib_from_fwd_face[i], i, +1, 2*commsBytes[i]);
+      mh_send_fwd[i] = NULL;
+      mh_recv_back[i] = NULL;
+    } else {
+      mh_send_fwd[i] = comm_declare_send_relative(ib_my_fwd_face[i], i, 1, commsBytes[i]);
+      mh_send_back[i] = comm_declare_send_relative(ib_my_back_face[i], i, -1, commsBytes[i]);
+      mh_recv_fwd[i] = comm_declare_receive_relative(ib_from_fwd_face[i], i, +1, commsBytes[i]);
+      mh_recv_back[i] = comm_declare_receive_relative(ib_from_back_face[i], i, -1, commsBytes[i]);
+    }
   }
 
   checkCudaError();
@@ -87,16 +223,20 @@ FaceBuffer::~FaceBuffer()
 {  
   for (int i=0; i<nDimComms; i++) {
     if (commDimPartitioned(i)) {
-#ifndef GPU_DIRECT
-      host_free(ib_my_fwd_face[i]);
-      host_free(ib_my_back_face[i]);
-      host_free(ib_from_fwd_face[i]);
-      host_free(ib_from_back_face[i]);
-#endif
-      comm_free(mh_send_fwd[i]);
+      if (staging) {
+	host_free(ib_my_back_face[i]);
+	host_free(ib_from_fwd_face[i]);
+	if (!aggregate[i]) {
+	  host_free(ib_my_fwd_face[i]);
+	  host_free(ib_from_back_face[i]);
+	}
+      }
       comm_free(mh_send_back[i]);
       comm_free(mh_recv_fwd[i]);
-      comm_free(mh_recv_back[i]);
+      if (!aggregate[i]) {
+	comm_free(mh_send_fwd[i]);
+	comm_free(mh_recv_back[i]);
+      }
     }
 
   }
@@ -150,6 +290,51 @@ void FaceBuffer::setupDims(const int* X, int Ls)
 }
 
 
+/**
+ * Copy a gathered face into its network buffer, converting to the
+ * halo precision if needed.
+ */
+void FaceBuffer::packComms(void *ib_buffer, const void *face, int dim)
+{
+  if (!staging) return;
+  if (commsPrecision == precision) {
+    memcpy(ib_buffer, face, nbytes[dim]);
+    return;
+  }
+
+  int sites = nFace*faceVolumeCB[dim];
+  int Nvec = (Ninternal == 6 || precision == QUDA_DOUBLE_PRECISION) ? 2 : 4;
+  if (precision == QUDA_DOUBLE_PRECISION) {
+    packHalo(ib_buffer, (const double*)face, sites, Ninternal, Nvec, commsPrecision);
+  } else {
+    packHalo(ib_buffer, (const float*)face, sites, Ninternal, Nvec, commsPrecision);
+  }
+}
+
+
+/**
+ * Copy a received face out of its network buffer, expanding to the
+ * native precision if needed.
+ */
+void FaceBuffer::unpackComms(void *face, const void *ib_buffer, int dim)
+{
+  if (!staging) return;
+  TraceScope scope("unpackComms");
+  if (commsPrecision == precision) {
+    memcpy(face, ib_buffer, nbytes[dim]);
+    return;
+  }
+
+  int sites = nFace*faceVolumeCB[dim];
+  int Nvec = (Ninternal == 6 || precision == QUDA_DOUBLE_PRECISION) ? 2 : 4;
+  if (precision == QUDA_DOUBLE_PRECISION) {
+    unpackHalo((double*)face, ib_buffer, sites, Ninternal, Nvec, commsPrecision);
+  } else {
+    unpackHalo((float*)face, ib_buffer, sites, Ninternal, Nvec, commsPrecision);
+  }
+}
+
+
 // cache of inactive allocations
 std::multimap<size_t, void *> FaceBuffer::pinnedCache;
 
@@ -280,6 +465,7 @@ void CUDART_CB commCallback(cudaStream_t stream, cudaError_t status, void *data)
 void FaceBuffer::commsStart(int dir) {
   int dim = dir / 2;
   if(!commDimPartitioned(dim)) return;
+  TraceScope scope("commsStart");
 
   if (dir%2 == 0) { // sending backwards
     commCB[dir].mh_recv = mh_recv_fwd[dim]; 
@@ -303,21 +489,30 @@ void FaceBuffer::commsStart(int dir) {
 void FaceBuffer::commsStart(int dir) {
   int dim = dir / 2;
   if(!commDimPartitioned(dim)) return;
+  TraceScope scope("commsStart");
+
+  if (aggregate[dim]) {
+    // wait until both faces have been gathered, then send them together
+    if (++facesReady[dim] < 2) return;
+    facesReady[dim] = 0;
+    aggregateDone[dim] = false;
+    comm_start(mh_recv_fwd[dim]);
+    packComms(ib_my_back_face[dim], my_back_face[dim], dim);
+    packComms(ib_my_fwd_face[dim], my_fwd_face[dim], dim);
+    comm_start(mh_send_back[dim]);
+    return;
+  }
 
   if (dir%2 == 0) { // sending backwards
     // Prepost receive
     comm_start(mh_recv_fwd[dim]);
-#ifndef GPU_DIRECT
-    memcpy(ib_my_back_face[dim], my_back_face[dim], nbytes[dim]);
-#endif
+    packComms(ib_my_back_face[dim], my_back_face[dim], dim);
     comm_start(mh_send_back[dim]);
   } else { //sending forwards
     // Prepost receive
     comm_start(mh_recv_back[dim]);
     // Begin forward send
-#ifndef GPU_DIRECT
-    memcpy(ib_my_fwd_face[dim], my_fwd_face[dim], nbytes[dim]);
-#endif
+    packComms(ib_my_fwd_face[dim], my_fwd_face[dim], dim);
     comm_start(mh_send_fwd[dim]);
   }
 }
@@ -330,18 +525,25 @@ int FaceBuffer::commsQuery(int dir)
   int dim = dir / 2;
   if(!commDimPartitioned(dim)) return 0;
 
+  if (aggregate[dim]) {
+    if (facesReady[dim] != 0) return 0; // aggregated message not yet started
+    if (!aggregateDone[dim]) {
+      if (!(comm_query(mh_recv_fwd[dim]) && comm_query(mh_send_back[dim]))) return 0;
+      unpackComms(from_fwd_face[dim], ib_from_fwd_face[dim], dim);
+      unpackComms(from_back_face[dim], ib_from_back_face[dim], dim);
+      aggregateDone[dim] = true;
+    }
+    return 1;
+  }
+
   if(dir%2==0) {
     if (comm_query(mh_recv_fwd[dim]) && comm_query(mh_send_back[dim])) {
-#ifndef GPU_DIRECT
-      memcpy(from_fwd_face[dim], ib_from_fwd_face[dim], nbytes[dim]);		
-#endif
+      unpackComms(from_fwd_face[dim], ib_from_fwd_face[dim], dim);
       return 1;
     }
   } else {
     if (comm_query(mh_recv_back[dim]) && comm_query(mh_send_fwd[dim])) {
-#ifndef GPU_DIRECT
-      memcpy(from_back_face[dim], ib_from_back_face[dim], nbytes[dim]);		
-#endif
+      unpackComms(from_back_face[dim], ib_from_back_face[dim], dim);
       return 1;
     }
   }
@@ -367,6 +569,8 @@ void FaceBuffer::scatter(cudaColorSpinorField &out, int dagger, int dir)
 // This is just an initial hack for CPU comms - should be creating the message handlers at instantiation
 void FaceBuffer::exchangeCpuSpinor(cpuColorSpinorField &spinor, int oddBit, int dagger)
 {
+  TraceScope scope("exchangeCpuSpinor");
+
   // allocate the ghost buffer if not yet allocated
   spinor.allocateGhostBuffer();
 
@@ -422,6 +626,8 @@ void FaceBuffer::exchangeCpuSpinor(cpuColorSpinorField &spinor, int oddBit, int
 
 void FaceBuffer::exchangeLink(void** ghost_link, void** link_sendbuf, QudaFieldLocation location)
 {
+  TraceScope scope("exchangeLink");
+
   MsgHandle *mh_from_back[4];
   MsgHandle *mh_send_fwd[4];
 
@@ -439,6 +645,14 @@ void FaceBuffer::exchangeLink(void** ghost_link, void** link_sendbuf, QudaFieldL
 	memcpy(ghost_link[i], link_sendbuf[i], bytes[i]);
       }
     }
+
+    if (ghostCompression) {
+      for (int i=0; i<nDimComms; i++) {
+	if (!commDimPartitioned(i)) continue;
+	exchangeCompressed(receive[i], send[i], i, +1, bytes[i], precision);
+      }
+      return;
+    }
   } else { // FIXME for CUDA field copy back to the CPU
     for (int i=0; i<nDimComms; i++) {
       if (commDimPartitioned(i)) {
@@ -486,12 +700,168 @@ void FaceBuffer::exchangeLink(void** ghost_link, void** link_sendbuf, QudaFieldL
 }
 
 
+/**
+ * Run-length encode n bytes read with the given stride (PackBits
+ * format): a control byte c < 128 is followed by c+1 literal bytes,
+ * while c >= 128 means the next byte is repeated 257-c times.
+ * @return Number of bytes written to dst
+ */
+static size_t packBits(unsigned char *dst, const unsigned char *src, size_t n, size_t stride)
+{
+  size_t out = 0, i = 0;
+  while (i < n) {
+    size_t run = 1;
+    while (i+run < n && run < 128 && src[(i+run)*stride] == src[i*stride]) run++;
+
+    if (run >= 3) {
+      dst[out++] = (unsigned char)(257 - run);
+      dst[out++] = src[i*stride];
+      i += run;
+    } else { // gather literals until the next run of three or more
+      size_t lit = 0;
+      while (i+lit < n && lit < 128) {
+	if (i+lit+2 < n && src[(i+lit)*stride] == src[(i+lit+1)*stride] &&
+	    src[(i+lit)*stride] == src[(i+lit+2)*stride]) break;
+	lit++;
+      }
+      dst[out++] = (unsigned char)(lit - 1);
+      for (size_t j=0; j<lit; j++) dst[out++] = src[(i+j)*stride];
+      i += lit;
+    }
+  }
+  return out;
+}
+
+
+/**
+ * Inverse of packBits: decode n bytes into dst with the given stride.
+ * @return Number of bytes consumed from src
+ */
+static size_t unpackBits(unsigned char *dst, const unsigned char *src, size_t n, size_t stride)
+{
+  size_t in = 0, i = 0;
+  while (i < n) {
+    unsigned char c = src[in++];
+    if (c < 128) {
+      for (size_t j=0; j<(size_t)c+1; j++) dst[(i++)*stride] = src[in++];
+    } else {
+      unsigned char v = src[in++];
+      for (size_t j=0; j<(size_t)(257-c); j++) dst[(i++)*stride] = v;
+    }
+  }
+  return in;
+}
+
+
+// upper bound on the size of a compressed buffer, including the mode byte
+static inline size_t compressBound(size_t bytes) { return 1 + bytes + bytes/128 + 64; }
+
+
+/**
+ * Lossless byte-plane compression: byte k of every word is gathered
+ * into plane k and each plane is run-length encoded.  The sign and
+ * exponent planes of gauge links are highly repetitive, as are the
+ * low mantissa planes of fields that were promoted from a lower
+ * precision.  Falls back to a raw copy if nothing is gained.
+ */
+static size_t compressGhost(void *dst, const void *src, size_t bytes, size_t word)
+{
+  unsigned char *d = (unsigned char*)dst;
+  const unsigned char *s = (const unsigned char*)src;
+  size_t n = bytes / word;
+
+  size_t out = 1;
+  bool complete = (n * word == bytes);
+  for (size_t k=0; k<word && complete; k++) {
+    if (out >= bytes) complete = false; // no gain, so stop early
+    else out += packBits(d+out, s+k, n, word);
+  }
+
+  if (!complete || out >= bytes + 1) {
+    d[0] = 0; // raw
+    memcpy(d+1, s, bytes);
+    return bytes + 1;
+  }
+
+  d[0] = 1; // byte-plane compressed
+  return out;
+}
+
+
+static void decompressGhost(void *dst, const void *src, size_t bytes, size_t word)
+{
+  unsigned char *d = (unsigned char*)dst;
+  const unsigned char *s = (const unsigned char*)src;
+
+  if (s[0] == 0) {
+    memcpy(d, s+1, bytes);
+    return;
+  }
+
+  size_t n = bytes / word;
+  size_t in = 1;
+  for (size_t k=0; k<word; k++) in += unpackBits(d+k, s+in, n, word);
+}
+
+
+/**
+ * Send "send" to the neighbour in direction dir of dimension dim and
+ * receive the matching message from the opposite neighbour into recv,
+ * using byte-plane compression.  Since the compressed length varies,
+ * the lengths are exchanged first so that both ends declare messages
+ * of identical size.
+ */
+void FaceBuffer::exchangeCompressed(void *recv, void *send, int dim, int dir, size_t bytes, size_t word)
+{
+  TraceScope scope("exchangeCompressed");
+  void *send_buf = safe_malloc(compressBound(bytes));
+  void *recv_buf = safe_malloc(compressBound(bytes));
+
+  size_t send_bytes = compressGhost(send_buf, send, bytes, word);
+  size_t recv_bytes = 0;
+
+  MsgHandle *mh_recv = comm_declare_receive_relative(&recv_bytes, dim, -dir, sizeof(size_t));
+  MsgHandle *mh_send = comm_declare_send_relative(&send_bytes, dim, dir, sizeof(size_t));
+  comm_start(mh_recv);
+  comm_start(mh_send);
+  comm_wait(mh_send);
+  comm_wait(mh_recv);
+  comm_free(mh_send);
+  comm_free(mh_recv);
+
+  if (recv_bytes > compressBound(bytes)) errorQuda("Invalid compressed ghost length %lu", (unsigned long)recv_bytes);
+
+  mh_recv = comm_declare_receive_relative(recv_buf, dim, -dir, recv_bytes);
+  mh_send = comm_declare_send_relative(send_buf, dim, dir, send_bytes);
+  comm_start(mh_recv);
+  comm_start(mh_send);
+  comm_wait(mh_send);
+  comm_wait(mh_recv);
+  comm_free(mh_send);
+  comm_free(mh_recv);
+
+  decompressGhost(recv, recv_buf, bytes, word);
+
+  host_free(recv_buf);
+  host_free(send_buf);
+}
+
+
 void reduceMaxDouble(double &max) { comm_allreduce_max(&max); }
 
-void reduceDouble(double &sum) { if (globalReduce) comm_allreduce(&sum); }
+void reduceDouble(double &sum)
+{
+  if (!globalReduce) return;
+  TraceScope scope("allreduce");
+  comm_allreduce(&sum);
+}
 
 void reduceDoubleArray(double *sum, const int len) 
-{ if (globalReduce) comm_allreduce_array(sum, len); }
+{
+  if (!globalReduce) return;
+  TraceScope scope("allreduce");
+  comm_allreduce_array(sum, len);
+}
 
 int commDim(int dir) { return comm_dim(dir); }
 
@@ -11,6 +11,8 @@
 using namespace quda;
 
 extern cudaStream_t *stream;
+
+#define gaugeSiteSize 18
   
 /**************************************************************
  * Staple exchange routine
@@ -29,8 +31,6 @@ enum {
   XDOWN = 7
 };
 
-#define gaugeSiteSize 18
-
 #ifndef GPU_DIRECT
 static void* fwd_nbr_staple_cpu[4];
 static void* back_nbr_staple_cpu[4];
@@ -311,6 +311,12 @@ void exchange_cpu_sitelink(int* X,
   }
 }
 
+#endif
+
+// The extended site link exchange only needs the communicator, so it
+// is also available to the host gauge observables without the link
+// fattening and force builds.
+#ifdef MULTI_GPU
 
 #define MEMCOPY_GAUGE_FIELDS_GRID_TO_BUF(ghost_buf, dst_idx, sitelink, src_idx, num, dir) \
   if(src_oddness){							\
@@ -552,30 +558,35 @@ void exchange_cpu_sitelink_ex(int* X, int *R, void** sitelink, QudaGaugeFieldOrd
 	}
       }
       
-      MsgHandle *mh_recv_back;
-      MsgHandle *mh_recv_fwd;
-      MsgHandle *mh_send_fwd;
-      MsgHandle *mh_send_back;
+      if (FaceBuffer::GhostCompression()) {
+	FaceBuffer::exchangeCompressed(ghost_sitelink_back[dir], ghost_sitelink_fwd_sendbuf[dir], dir, +1, len[dir], gPrecision);
+	FaceBuffer::exchangeCompressed(ghost_sitelink_fwd[dir], ghost_sitelink_back_sendbuf[dir], dir, -1, len[dir], gPrecision);
+      } else {
+	MsgHandle *mh_recv_back;
+	MsgHandle *mh_recv_fwd;
+	MsgHandle *mh_send_fwd;
+	MsgHandle *mh_send_back;
   
-      mh_recv_back = comm_declare_receive_relative(ghost_sitelink_back[dir], dir, -1, len[dir]);
-      mh_recv_fwd = comm_declare_receive_relative(ghost_sitelink_fwd[dir], dir, +1, len[dir]);
-      mh_send_fwd = comm_declare_send_relative(ghost_sitelink_fwd_sendbuf[dir], dir, +1, len[dir]);
-      mh_send_back = comm_declare_send_relative(ghost_sitelink_back_sendbuf[dir], dir, -1, len[dir]);
-
-      comm_start(mh_recv_back);
-      comm_start(mh_recv_fwd);
-      comm_start(mh_send_fwd);
-      comm_start(mh_send_back);
-
-      comm_wait(mh_send_fwd);
-      comm_wait(mh_send_back);
-      comm_wait(mh_recv_back);
-      comm_wait(mh_recv_fwd);
-
-      comm_free(mh_send_fwd);
-      comm_free(mh_send_back);
-      comm_free(mh_recv_back);
-      comm_free(mh_recv_fwd);
+	mh_recv_back = comm_declare_receive_relative(ghost_sitelink_back[dir], dir, -1, len[dir]);
+	mh_recv_fwd = comm_declare_receive_relative(ghost_sitelink_fwd[dir], dir, +1, len[dir]);
+	mh_send_fwd = comm_declare_send_relative(ghost_sitelink_fwd_sendbuf[dir], dir, +1, len[dir]);
+	mh_send_back = comm_declare_send_relative(ghost_sitelink_back_sendbuf[dir], dir, -1, len[dir]);
+
+	comm_start(mh_recv_back);
+	comm_start(mh_recv_fwd);
+	comm_start(mh_send_fwd);
+	comm_start(mh_send_back);
+
+	comm_wait(mh_send_fwd);
+	comm_wait(mh_send_back);
+	comm_wait(mh_recv_back);
+	comm_wait(mh_recv_fwd);
+
+	comm_free(mh_send_fwd);
+	comm_free(mh_send_back);
+	comm_free(mh_recv_back);
+	comm_free(mh_recv_fwd);
+      }
       
     }//if
 
@@ -697,6 +708,9 @@ void exchange_cpu_sitelink_ex(int* X, int *R, void** sitelink, QudaGaugeFieldOrd
     
 }
 
+#endif
+
+#if defined(MULTI_GPU) && (defined(GPU_FATLINK) || defined(GPU_GAUGE_FORCE)|| defined(GPU_FERMION_FORCE) || defined(GPU_HISQ_FORCE))
 
 
 template<typename Float>
@@ -136,6 +136,7 @@ namespace quda {
     const int *length;
     const void *path_coeff;
     const int num_paths;
+    const int total_length; // the sum of the path lengths
     const kernel_param_t &kparam;
 
     unsigned int sharedBytesPerThread() const { return 0; }
@@ -148,9 +149,9 @@ namespace quda {
   public:
     GaugeForceCuda(cudaGaugeField &mom, const int dir, const double &eb3, const cudaGaugeField &link,
 		   const int *input_path, const int *length, const void *path_coeff, 
-		   const int num_paths, const kernel_param_t &kparam) :
+		   const int num_paths, const int total_length, const kernel_param_t &kparam) :
       mom(mom), dir(dir), eb3(eb3), link(link), input_path(input_path), length(length), 
-      path_coeff(path_coeff), num_paths(num_paths), kparam(kparam) { 
+      path_coeff(path_coeff), num_paths(num_paths), total_length(total_length), kparam(kparam) { 
 
       if(link.Precision() == QUDA_DOUBLE_PRECISION){
 	cudaBindTexture(0, siteLink0TexDouble, link.Even_p(), link.Bytes()/2);
@@ -244,7 +245,18 @@ namespace quda {
     void preTune() { mom.backup(); }
     void postTune() { mom.restore(); } 
   
-    long long flops() const { return 0; } // FIXME: add flops counter
+    /**
+       Per site, each path loads its links and multiplies them together
+       (198 flops per SU(3) product) before being scaled and summed (36
+       flops).  The staple sum is then multiplied by the site link and
+       its traceless anti-Hermitian part (10 reals) updates the momentum.
+    */
+    long long flops() const {
+      return 2ll*kparam.threads*((total_length - num_paths)*198ll + num_paths*36ll + 198ll + 20ll);
+    }
+    long long bytes() const {
+      return 2ll*kparam.threads*((total_length + 1ll)*link.Reconstruct()*link.Precision() + 2*10ll*mom.Precision());
+    }
   
     TuneKey tuneKey() const {
       std::stringstream vol, aux;
@@ -303,8 +315,11 @@ namespace quda {
 #endif
     kparam.threads = volume/2;
 
+    int total_length = 0;
+    for(int i=0; i < num_paths; i++) total_length += length[i];
+
     GaugeForceCuda gaugeForce(cudaMom, dir, eb3, cudaSiteLink, input_path_d, 
-			      length_d, path_coeff_d, num_paths, kparam);
+			      length_d, path_coeff_d, num_paths, total_length, kparam);
     gaugeForce.apply(0);
     checkCudaError();
     
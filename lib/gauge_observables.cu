@@ -0,0 +1,310 @@
+#include <math.h>
+#include <vector>
+#include <typeinfo>
+
+#include <extended_links_quda.h>
+#include <comm_quda.h>
+
+/**
+   Host gauge observables: the average plaquette, the 2x1 rectangle,
+   the Polyakov loop and the clover-leaf topological charge.  The
+   links are first copied into a local field padded by a halo of depth
+   two (see extended_links_quda.h).  The loops are then evaluated in
+   double precision by the host threads over (z,t) planes, with one
+   partial sum per plane that is combined in a fixed order, so the
+   result is independent of the number of threads.
+ */
+
+namespace quda {
+
+  namespace {
+
+    typedef std::complex<double> Complex;
+    typedef Link<double> Matrix;
+
+    /** The link of ext at extended site s, promoted to double precision */
+    template <typename Float>
+      inline Matrix matrix(const ExtendedLinks<Float> &ext, int s, int dir) {
+      const Link<Float> &u = ext.link(s, dir);
+      Matrix U;
+      for (int i=0; i<18; i++) U.v[i] = u.v[i];
+      return U;
+    }
+
+    /**
+       The hermitian, traceless clover-leaf field strength
+       F = (Q - Q^dag)/(8i), where Q is the sum of the four leaves.
+    */
+    inline Matrix fieldStrength(const Matrix &Q) {
+      Matrix F;
+      for (int i=0; i<3; i++) {
+	for (int j=0; j<3; j++) {
+	  const double re = Q.v[2*(3*i+j)+0] - Q.v[2*(3*j+i)+0];
+	  const double im = Q.v[2*(3*i+j)+1] + Q.v[2*(3*j+i)+1];
+	  F.v[2*(3*i+j)+0] = 0.125*im;
+	  F.v[2*(3*i+j)+1] = -0.125*re;
+	}
+      }
+      const Complex tr = trace(F) / 3.0;
+      for (int i=0; i<3; i++) {
+	F.v[8*i+0] -= real(tr);
+	F.v[8*i+1] -= imag(tr);
+      }
+      return F;
+    }
+
+    // partial sums kept per (z,t) plane
+    enum { PLAQ_SPATIAL, PLAQ_TEMPORAL, RECTANGLE, QCHARGE, N_PARTIAL };
+
+    /**
+       Plaquettes, rectangles and the topological charge density.
+       Each (z,t) plane writes its own partial sums, so the work can be
+       split between any number of threads without changing the result.
+    */
+    template <typename Float>
+      class MeasureLoops : public TunableCPU {
+      const ExtendedLinks<Float> &ext;
+      double *partial;
+      double *density;
+      int planes;
+
+    protected:
+      int maxThreads() const { return planes < hostThreadCount() ? planes : hostThreadCount(); }
+
+      long long flops() const {
+	// 72 products for the clover leaves, 60 for the rectangles and 3 for the charge
+	return (long long)ext.X[0]*ext.X[1]*ext.X[2]*ext.X[3] * 135 * 198;
+      }
+
+      long long bytes() const {
+	long long volume = (long long)ext.X[0]*ext.X[1]*ext.X[2]*ext.X[3];
+	return volume * (4*sizeof(Link<Float>) + (density ? sizeof(double) : 0));
+      }
+
+    public:
+      MeasureLoops(const ExtendedLinks<Float> &ext, double *partial, double *density)
+	: ext(ext), partial(partial), density(density), planes(ext.X[2]*ext.X[3]) { }
+      virtual ~MeasureLoops() { }
+
+      void apply(const cudaStream_t &stream) {
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	HostKernelScope scope(*this);
+	hostParallelFor(planes, *this, tp.threads);
+      }
+
+      TuneKey tuneKey() const {
+	std::stringstream vol, aux;
+	vol << ext.X[0] << "x" << ext.X[1] << "x" << ext.X[2] << "x" << ext.X[3];
+	aux << "prec=" << sizeof(Float) << ",density=" << (density ? 1 : 0);
+	return TuneKey(vol.str(), typeid(*this).name(), aux.str());
+      }
+
+      void operator()(int zt) const {
+	const int *X = ext.X;
+	double sum[N_PARTIAL] = { };
+	const int z = zt % X[2], t = zt / X[2];
+	for (int y=0; y<X[1]; y++) {
+	  for (int x=0; x<X[0]; x++) {
+	    const int s = ext.index(x, y, z, t);
+	    double q = site(s, sum);
+	    if (density) density[((t*X[2] + z)*X[1] + y)*X[0] + x] = q;
+	    sum[QCHARGE] += q;
+	  }
+	}
+	for (int i=0; i<N_PARTIAL; i++) partial[zt*N_PARTIAL + i] = sum[i];
+      }
+
+      /** accumulate the plaquettes and rectangles at s, and return the charge density */
+      double site(int s, double sum[N_PARTIAL]) const {
+	const int *st = ext.stride;
+	Matrix F[6];
+
+	for (int mu=0, p=0; mu<4; mu++) {
+	  for (int nu=mu+1; nu<4; nu++, p++) {
+	    const Matrix Umu = matrix(ext, s, mu);
+	    const Matrix Unu = matrix(ext, s, nu);
+	    const Matrix Umu_m = matrix(ext, s-st[mu], mu);
+	    const Matrix Unu_n = matrix(ext, s-st[nu], nu);
+
+	    Matrix Q = Umu * matrix(ext, s+st[mu], nu) * dagger(matrix(ext, s+st[nu], mu)) * dagger(Unu);
+	    sum[nu == 3 ? PLAQ_TEMPORAL : PLAQ_SPATIAL] += real(trace(Q)) / 3.0;
+
+	    Q = Q + Unu * dagger(matrix(ext, s-st[mu]+st[nu], mu)) * dagger(matrix(ext, s-st[mu], nu)) * Umu_m;
+	    Q = Q + dagger(Umu_m) * dagger(matrix(ext, s-st[mu]-st[nu], nu)) * matrix(ext, s-st[mu]-st[nu], mu) * Unu_n;
+	    Q = Q + dagger(Unu_n) * matrix(ext, s-st[nu], mu) * matrix(ext, s-st[nu]+st[mu], nu) * dagger(Umu);
+	    F[p] = fieldStrength(Q);
+	  }
+	}
+
+	// 2x1 rectangles with the long side along mu
+	for (int mu=0; mu<4; mu++) {
+	  for (int nu=0; nu<4; nu++) {
+	    if (nu == mu) continue;
+	    const Matrix forward = matrix(ext, s, mu) * matrix(ext, s+st[mu], mu) * matrix(ext, s+2*st[mu], nu);
+	    const Matrix back = matrix(ext, s, nu) * matrix(ext, s+st[nu], mu) * matrix(ext, s+st[nu]+st[mu], mu);
+	    sum[RECTANGLE] += reTraceProduct(forward, dagger(back)) / 3.0;
+	  }
+	}
+
+	// planes are ordered 01, 02, 03, 12, 13, 23
+	return (reTraceProduct(F[0], F[5]) - reTraceProduct(F[1], F[4]) + reTraceProduct(F[2], F[3]))
+	  / (4.0*M_PI*M_PI);
+      }
+    };
+
+    /** the product of the local temporal links at each spatial site */
+    template <typename Float>
+      struct LocalPolyakov {
+	const ExtendedLinks<Float> &ext;
+	Matrix *P;
+
+	LocalPolyakov(const ExtendedLinks<Float> &ext, Matrix *P) : ext(ext), P(P) { }
+
+	void operator()(int z) const {
+	  const int *X = ext.X;
+	  for (int y=0; y<X[1]; y++) {
+	    for (int x=0; x<X[0]; x++) {
+	      Matrix L = matrix(ext, ext.index(x, y, z, 0), 3);
+	      for (int t=1; t<X[3]; t++) L = L * matrix(ext, ext.index(x, y, z, t), 3);
+	      P[(z*X[1] + y)*X[0] + x] = L;
+	    }
+	  }
+	}
+      };
+
+    /**
+       Complete the Polyakov loops across the ranks in the time
+       direction: after n-1 steps of multiplying by the partial product
+       received from the forward neighbour, each rank holds the full
+       loop starting at its own time slices.  Only the ranks with time
+       coordinate zero contribute, so the sum has a fixed order.
+    */
+    template <typename Float>
+      void polyakovLoop(double loop[3], const ExtendedLinks<Float> &ext, int nthreads) {
+      const int *X = ext.X;
+      const int spatial = X[0]*X[1]*X[2];
+      std::vector<Matrix> P(spatial);
+
+      LocalPolyakov<Float> local(ext, &P[0]);
+      hostParallelFor(X[2], local, nthreads);
+
+      bool contribute = true;
+#ifdef MULTI_GPU
+      const int nt = comm_dim(3);
+      if (nt > 1) {
+	const size_t bytes = spatial*sizeof(Matrix);
+	std::vector<Matrix> L(P), send(P), recv(spatial);
+	for (int step=1; step<nt; step++) {
+	  send = P;
+	  MsgHandle *mh_recv = comm_declare_receive_relative(&recv[0], 3, +1, bytes);
+	  MsgHandle *mh_send = comm_declare_send_relative(&send[0], 3, -1, bytes);
+	  comm_start(mh_recv);
+	  comm_start(mh_send);
+	  comm_wait(mh_send);
+	  comm_wait(mh_recv);
+	  comm_free(mh_send);
+	  comm_free(mh_recv);
+	  for (int i=0; i<spatial; i++) P[i] = L[i] * recv[i];
+	}
+	contribute = (comm_coord(3) == 0);
+      }
+#endif
+
+      loop[0] = loop[1] = loop[2] = 0.0;
+      if (!contribute) return;
+      for (int i=0; i<spatial; i++) {
+	Complex tr = trace(P[i]);
+	loop[0] += real(tr) / 3.0;
+	loop[1] += imag(tr) / 3.0;
+      }
+      loop[2] = spatial;
+    }
+
+    template <typename Float, typename Order>
+      void gaugeObservables(QudaGaugeObservableParam &obs, const Order &order, const GaugeField &u) {
+      const int nthreads = hostThreadCount();
+      ExtendedLinks<Float> ext(u.X());
+      loadExtended(ext, u, order, false);
+
+      const int planes = ext.X[2]*ext.X[3];
+      std::vector<double> partial(planes*N_PARTIAL);
+      MeasureLoops<Float> measure(ext, &partial[0], obs.qcharge_density);
+      measure.apply(0);
+
+      // sums, local site count, Polyakov loop and its site count
+      double sum[N_PARTIAL + 4] = { };
+      for (int zt=0; zt<planes; zt++) {
+	for (int i=0; i<N_PARTIAL; i++) sum[i] += partial[zt*N_PARTIAL + i];
+      }
+      sum[N_PARTIAL] = (double)ext.X[0]*ext.X[1]*ext.X[2]*ext.X[3];
+      polyakovLoop(sum + N_PARTIAL + 1, ext, nthreads);
+
+      reduceDoubleArray(sum, N_PARTIAL + 4);
+
+      const double volume = sum[N_PARTIAL];
+      obs.plaquette[1] = sum[PLAQ_SPATIAL] / (3.0*volume);
+      obs.plaquette[2] = sum[PLAQ_TEMPORAL] / (3.0*volume);
+      obs.plaquette[0] = 0.5*(obs.plaquette[1] + obs.plaquette[2]);
+      obs.rectangle = sum[RECTANGLE] / (12.0*volume);
+      obs.polyakov_loop[0] = sum[N_PARTIAL+1] / sum[N_PARTIAL+3];
+      obs.polyakov_loop[1] = sum[N_PARTIAL+2] / sum[N_PARTIAL+3];
+      obs.qcharge = sum[QCHARGE];
+    }
+
+    // the links are stored as Storage and measured in Float
+    template <typename Float, typename Storage>
+      void gaugeObservables(QudaGaugeObservableParam &obs, const GaugeField &u) {
+      const int length = 18;
+      if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+	if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	  gaugeObservables<Float>(obs, QDPOrder<Storage,length,12>(u, (Storage*)u.Gauge_p()), u);
+	} else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	  gaugeObservables<Float>(obs, QDPOrder<Storage,length,8>(u, (Storage*)u.Gauge_p()), u);
+	} else {
+	  gaugeObservables<Float>(obs, QDPOrder<Storage,length>(u, (Storage*)u.Gauge_p()), u);
+	}
+      } else if (u.Order() == QUDA_CPS_WILSON_GAUGE_ORDER) {
+	gaugeObservables<Float>(obs, CPSOrder<Storage,length>(u, (Storage*)u.Gauge_p()), u);
+      } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
+	if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	  gaugeObservables<Float>(obs, MILCOrder<Storage,length,12>(u, (Storage*)u.Gauge_p()), u);
+	} else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	  gaugeObservables<Float>(obs, MILCOrder<Storage,length,8>(u, (Storage*)u.Gauge_p()), u);
+	} else {
+	  gaugeObservables<Float>(obs, MILCOrder<Storage,length>(u, (Storage*)u.Gauge_p()), u);
+	}
+      } else if (u.Order() == QUDA_BQCD_GAUGE_ORDER) {
+	gaugeObservables<Float>(obs, BQCDOrder<Storage,length>(u, (Storage*)u.Gauge_p()), u);
+      } else if (u.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+	if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	  gaugeObservables<Float>(obs, AoSoAOrder<Storage,length,12>(u, (Storage*)u.Gauge_p()), u);
+	} else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	  gaugeObservables<Float>(obs, AoSoAOrder<Storage,length,8>(u, (Storage*)u.Gauge_p()), u);
+	} else {
+	  gaugeObservables<Float>(obs, AoSoAOrder<Storage,length>(u, (Storage*)u.Gauge_p()), u);
+	}
+      } else {
+	errorQuda("Gauge field %d order not supported", u.Order());
+      }
+    }
+
+  } // anonymous namespace
+
+  void gaugeObservables(QudaGaugeObservableParam &obs, const cpuGaugeField &u) {
+    if (u.Ncolor() != 3) errorQuda("Unsupported number of colors; Nc=%d", u.Ncolor());
+    if (u.Reconstruct() != QUDA_RECONSTRUCT_NO && u.Reconstruct() != QUDA_RECONSTRUCT_12 &&
+	u.Reconstruct() != QUDA_RECONSTRUCT_8) errorQuda("Reconstruct type %d not supported", u.Reconstruct());
+    if (u.LinkType() == QUDA_ASQTAD_MOM_LINKS) errorQuda("Momentum fields have no gauge observables");
+
+    if (u.Precision() == QUDA_DOUBLE_PRECISION) {
+      gaugeObservables<double,double>(obs, u);
+    } else if (u.Precision() == QUDA_SINGLE_PRECISION) {
+      gaugeObservables<float,float>(obs, u);
+    } else if (u.Precision() == QUDA_HALF_PRECISION) {
+      gaugeObservables<float,short>(obs, u);
+    } else {
+      errorQuda("Precision %d undefined", u.Precision());
+    }
+  }
+
+} // namespace quda
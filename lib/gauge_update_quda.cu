@@ -3,6 +3,7 @@
 #include <cuda.h>
 #include <quda_internal.h>
 #include <tune_quda.h>
+#include <host_thread_quda.h>
 #include <gauge_field.h>
 #include <gauge_field_order.h>
 #include <quda_matrix.h>
@@ -60,16 +61,18 @@ namespace quda {
 
   }
 
+  /** CPU functor to update the links of site idx = parity*volumeCB + x */
   template<typename Cmplx, typename Gauge, typename Mom, int N>
-  void updateGaugeField(UpdateGaugeArg<Cmplx,Gauge,Mom> arg) {
-
-    for (unsigned int parity=0; parity<2; parity++) {
-      for (unsigned int x=0; x<arg.out.volumeCB; x++) {
-	updateGaugeFieldCompute<Cmplx,Gauge,Mom,N>(arg, x, parity);
-      }
+  struct UpdateGaugeFieldSite {
+    UpdateGaugeArg<Cmplx,Gauge,Mom> &arg;
+    UpdateGaugeFieldSite(UpdateGaugeArg<Cmplx,Gauge,Mom> &arg) : arg(arg) { }
+
+    void operator()(int idx) const {
+      int parity = (idx >= arg.out.volumeCB) ? 1 : 0;
+      idx -= parity*arg.out.volumeCB;
+      updateGaugeFieldCompute<Cmplx,Gauge,Mom,N>(arg, idx, parity);
     }
-
-  }
+  };
 
   template<typename Cmplx, typename Gauge, typename Mom, int N>
   __global__ void updateGaugeFieldKernel(UpdateGaugeArg<Cmplx,Gauge,Mom> arg) { 
@@ -109,7 +112,10 @@ namespace quda {
 	errorQuda("Not supported on pre-Fermi architecture");
 #endif
       } else { // run the CPU code
-	updateGaugeField<Complex,Gauge,Mom,N>(arg);
+	UpdateGaugeFieldSite<Complex,Gauge,Mom,N> site(arg);
+	TunableHostLoop<UpdateGaugeFieldSite<Complex,Gauge,Mom,N> >
+	  update(site, 2*arg.in.volumeCB, tuneKey(), flops(), bytes());
+	update.apply(0);
       }
     } // apply
     
@@ -197,9 +203,21 @@ namespace quda {
 	errorQuda("Reconstruction type %d not supported", out.Order());
       }
     } else if (out.Order() == QUDA_MILC_GAUGE_ORDER) {
-      updateGaugeField<Float>(MILCOrder<Float, Nc*Nc*2>(out),
-			      MILCOrder<Float, Nc*Nc*2>(in), 
-			      mom, dt, location);
+      if (out.Reconstruct() == QUDA_RECONSTRUCT_NO) {
+	updateGaugeField<Float>(MILCOrder<Float, Nc*Nc*2>(out),
+				MILCOrder<Float, Nc*Nc*2>(in),
+				mom, dt, location);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	updateGaugeField<Float>(MILCOrder<Float, Nc*Nc*2, 12>(out),
+				MILCOrder<Float, Nc*Nc*2, 12>(in),
+				mom, dt, location);
+      } else if (out.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	updateGaugeField<Float>(MILCOrder<Float, Nc*Nc*2, 8>(out),
+				MILCOrder<Float, Nc*Nc*2, 8>(in),
+				mom, dt, location);
+      } else {
+	errorQuda("Reconstruction type %d not supported", out.Reconstruct());
+      }
     } else {
       errorQuda("Gauge Field order %d not supported", out.Order());
     }
@@ -602,6 +602,20 @@ namespace quda {
 #undef LOAD_TEX_ENTRY
 
 
+    /**
+       Cost model shared by the force kernels below: per site, each
+       kernel loads a number of (possibly reconstructed) links, reads
+       or writes a number of full color matrices, and does a number of
+       SU(3) matrix products (198 flops) and scaled matrix additions (36
+       flops).  A read-modify-write of a matrix counts as two transfers.
+    */
+    static const long long matrix_product_flops = 198ll;
+    static const long long matrix_axpy_flops = 36ll;
+
+    static long long forceSiteBytes(const cudaGaugeField &link, int links, int matrices)
+    {
+      return (links*(long long)link.Reconstruct() + 18ll*matrices)*link.Precision();
+    }
 
 
     template<class RealA, class RealB>
@@ -759,7 +773,17 @@ namespace quda {
 	newOprod.restore();
       }
 
-      long long flops() const { return 0; }
+      // both parities are updated, each with kparam.threads sites
+      long long flops() const {
+	const bool qprev = (&Qprev != &link), qmu = (Qmu.Even_p() != NULL), sigp = GOES_FORWARDS(sig);
+	const int products = 2 + ((qprev && (qmu || sigp)) ? 1 : 0) + (sigp ? 1 : 0);
+	return 2ll*kparam.threads*(products*matrix_product_flops + (sigp ? matrix_axpy_flops : 0));
+      }
+      long long bytes() const {
+	const bool qprev = (&Qprev != &link), qmu = (Qmu.Even_p() != NULL), sigp = GOES_FORWARDS(sig);
+	const int matrices = 2 + ((qprev && (qmu || sigp)) ? 1 : 0) + (Pmu.Even_p() ? 1 : 0) + (qmu ? 1 : 0) + (sigp ? 2 : 0);
+	return 2ll*kparam.threads*forceSiteBytes(link, 3, matrices);
+      }
     };
 
 
@@ -888,7 +912,14 @@ namespace quda {
 	newOprod.restore();
       }
 
-      long long flops() const { return 0; }
+      long long flops() const {
+	const bool sigp = GOES_FORWARDS(sig);
+	return 2ll*kparam.threads*((2 + (sigp ? 2 : 0))*matrix_product_flops + (sigp ? matrix_axpy_flops : 0));
+      }
+      long long bytes() const {
+	const bool sigp = GOES_FORWARDS(sig);
+	return 2ll*kparam.threads*forceSiteBytes(link, 3, 2 + (sigp ? 3 : 0));
+      }
     };
     
     template<class RealA, class RealB>
@@ -1020,7 +1051,8 @@ namespace quda {
 	newOprod.restore();
       }
 
-      long long flops() const { return 0; }
+      long long flops() const { return 2ll*kparam.threads*(2*matrix_product_flops + 2*matrix_axpy_flops); }
+      long long bytes() const { return 2ll*kparam.threads*forceSiteBytes(link, 1, 2 + 2 + 2); }
     };
 
 
@@ -1138,7 +1170,8 @@ namespace quda {
 	newOprod.restore();
       }
 
-      long long flops() const { return 0; }
+      long long flops() const { return 2ll*kparam.threads*matrix_axpy_flops; }
+      long long bytes() const { return 2ll*kparam.threads*forceSiteBytes(link, 0, 1 + 2); }
     };
 
     template<class RealA, class RealB>
@@ -1281,7 +1314,14 @@ namespace quda {
 	param.grid = dim3((kparam.threads+param.block.x-1)/param.block.x, 1, 1);
       }
 
-      long long flops() const { return 0; }
+      long long flops() const {
+	const bool sigp = GOES_FORWARDS(sig);
+	return 2ll*kparam.threads*((4 + (sigp ? 2 : 0))*matrix_product_flops + (2 + (sigp ? 1 : 0))*matrix_axpy_flops);
+      }
+      long long bytes() const {
+	const bool sigp = GOES_FORWARDS(sig);
+	return 2ll*kparam.threads*forceSiteBytes(link, 3, 2 + 2 + 2 + (sigp ? 2 : 0));
+      }
     };
 
 
@@ -1353,7 +1393,12 @@ namespace quda {
 	ForceMatrix.restore();
       }
 
-      long long flops() const { return 0; }
+      long long flops() const {
+	return GOES_FORWARDS(sig) ? (long long)X[0]*X[1]*X[2]*X[3]*matrix_axpy_flops : 0;
+      }
+      long long bytes() const {
+	return GOES_FORWARDS(sig) ? (long long)X[0]*X[1]*X[2]*X[3]*3*18*oprod.Precision() : 0;
+      }
     };
     
 
@@ -1439,7 +1484,10 @@ namespace quda {
 	output.restore();
       }
 
-      long long flops() const { return 0; }
+      long long flops() const {
+	return (long long)X[0]*X[1]*X[2]*X[3]*(6*matrix_product_flops + 2*18 + matrix_axpy_flops);
+      }
+      long long bytes() const { return (long long)X[0]*X[1]*X[2]*X[3]*forceSiteBytes(link, 4, 3 + 2); }
     };
 
 
@@ -1521,7 +1569,10 @@ namespace quda {
 	mom.restore();
       }
 
-      long long flops() const { return 0; }
+      long long flops() const { return (long long)X[0]*X[1]*X[2]*X[3]*(matrix_product_flops + 18); }
+      long long bytes() const {
+	return (long long)X[0]*X[1]*X[2]*X[3]*(forceSiteBytes(link, 1, 1) + 10ll*mom.Precision());
+      }
     };
 
 
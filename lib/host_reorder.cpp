@@ -0,0 +1,191 @@
+#include <string.h>
+#include <vector>
+#include <typeinfo>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <quda_internal.h>
+#include <tune_quda.h>
+#include <host_thread_quda.h>
+#include <host_reorder_quda.h>
+
+namespace quda {
+
+  namespace {
+
+    /**
+       Copy n elements from the (cache resident) buffer into dst, with
+       non-temporal stores if stream is set so that the destination does
+       not displace the source from the cache
+    */
+    template <typename Float>
+    inline void storeRow(Float *dst, const Float *buf, int n, bool stream) {
+#ifdef __SSE2__
+      if (stream) {
+	const int vec = 16 / sizeof(Float);
+	int i = 0;
+	for ( ; i<n && ((size_t)(dst+i) & 15); i++) dst[i] = buf[i];
+	for ( ; i+vec<=n; i+=vec)
+	  _mm_stream_si128((__m128i*)(dst+i), _mm_loadu_si128((const __m128i*)(buf+i)));
+	for ( ; i<n; i++) dst[i] = buf[i];
+	return;
+      }
+#endif
+      memcpy(dst, buf, n*sizeof(Float));
+    }
+
+    inline void storeFence(bool stream) {
+#ifdef __SSE2__
+      if (stream) _mm_sfence();
+#endif
+    }
+
+    template <typename FloatOut, typename FloatIn, int N, bool toFloatN>
+    class Reorder : public TunableCPU {
+      struct Body;
+      friend struct Body;
+
+      FloatOut **out;
+      FloatIn **in;
+      const int nBlock;
+      const int volume;
+      const int length;
+      const int siteStride;
+      const int stride;
+
+      struct Body : public HostLoop {
+	const Reorder &r;
+	const int tile;
+	const int nTile;
+	const bool stream;
+	Body(const Reorder &r, int tile, bool stream)
+	  : r(r), tile(tile), nTile((r.volume + tile - 1) / tile), stream(stream) { }
+
+	void operator()(int begin, int end, int thread) const {
+	  std::vector<FloatOut> buf(toFloatN ? tile*N : tile*r.length);
+	  for (int item=begin; item<end; item++) {
+	    const int b = item / nTile;
+	    const int x0 = (item - b*nTile) * tile;
+	    const int x1 = (x0 + tile < r.volume) ? x0 + tile : r.volume;
+	    if (toFloatN) gather(r.out[b], r.in[b], x0, x1, &buf[0]);
+	    else scatter(r.out[b], r.in[b], x0, x1, &buf[0]);
+	  }
+	  storeFence(stream);
+	}
+
+	// site-major tile -> one contiguous FloatN row per group of N elements
+	void gather(FloatOut *out, const FloatIn *in, int x0, int x1, FloatOut *buf) const {
+	  for (int g=0; g<r.length/N; g++) {
+	    const FloatIn *site = in + x0*r.siteStride + g*N;
+	    for (int x=0; x<x1-x0; x++)
+	      for (int j=0; j<N; j++) buf[x*N + j] = site[x*r.siteStride + j];
+	    storeRow(out + (g*r.stride + x0)*N, buf, (x1-x0)*N, stream);
+	  }
+	}
+
+	// FloatN rows -> site-major tile
+	void scatter(FloatOut *out, const FloatIn *in, int x0, int x1, FloatOut *buf) const {
+	  for (int g=0; g<r.length/N; g++) {
+	    const FloatIn *row = in + (g*r.stride + x0)*N;
+	    for (int x=0; x<x1-x0; x++)
+	      for (int j=0; j<N; j++) buf[x*r.length + g*N + j] = row[x*N + j];
+	  }
+	  if (r.siteStride == r.length) {
+	    storeRow(out + x0*r.length, buf, (x1-x0)*r.length, stream);
+	  } else {
+	    for (int x=x0; x<x1; x++)
+	      for (int i=0; i<r.length; i++) out[x*r.siteStride + i] = buf[(x-x0)*r.length + i];
+	  }
+	}
+      };
+
+    protected:
+      int maxThreads() const {
+	const int items = nBlock * volume;
+	return items < hostThreadCount() ? items : hostThreadCount();
+      }
+      dim3 tileExtent() const { return dim3(volume < 512 ? volume : 512, 1, 1); }
+#ifdef __SSE2__
+      int simdVariants() const { return 2; } // 0: non-temporal stores, 1: regular stores
+#endif
+      long long flops() const { return 0; }
+      long long bytes() const { return (long long)nBlock*volume*length*(sizeof(FloatOut) + sizeof(FloatIn)); }
+
+    public:
+      Reorder(FloatOut **out, FloatIn **in, int nBlock, int volume, int length, int siteStride, int stride)
+	: out(out), in(in), nBlock(nBlock), volume(volume), length(length), siteStride(siteStride), stride(stride)
+      { if (length % N != 0) errorQuda("Length %d is not a multiple of N=%d", length, N); }
+      virtual ~Reorder() { }
+
+      void apply(const cudaStream_t &stream) {
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	HostKernelScope scope(*this);
+	const int tile = tp.tile.x > 0 ? tp.tile.x : 1;
+	Body body(*this, tile, tp.simd == 0 && simdVariants() > 1);
+	hostParallelFor(body, nBlock*body.nTile, tp.threads);
+      }
+
+      TuneKey tuneKey() const {
+	std::stringstream vol, aux;
+	vol << volume;
+	aux << "blocks=" << nBlock << ",length=" << length << ",site_stride=" << siteStride
+	    << ",N=" << N << ",stride=" << stride;
+	return TuneKey(vol.str(), typeid(*this).name(), aux.str());
+      }
+    };
+
+    template <bool toFloatN, typename FloatOut, typename FloatIn>
+    void reorder(void **out, void **in, int nBlock, int volume, int length, int siteStride, int N, int stride) {
+      if (N == 2) {
+	Reorder<FloatOut,FloatIn,2,toFloatN> r((FloatOut**)out, (FloatIn**)in, nBlock, volume, length, siteStride, stride);
+	r.apply(0);
+      } else if (N == 4) {
+	Reorder<FloatOut,FloatIn,4,toFloatN> r((FloatOut**)out, (FloatIn**)in, nBlock, volume, length, siteStride, stride);
+	r.apply(0);
+      } else {
+	errorQuda("N=%d not supported", N);
+      }
+    }
+
+    template <bool toFloatN>
+    void reorder(void **out, void **in, int nBlock, QudaPrecision outPrec, QudaPrecision inPrec,
+		 int volume, int length, int siteStride, int N, int stride) {
+      if (outPrec == QUDA_DOUBLE_PRECISION) {
+	if (inPrec == QUDA_DOUBLE_PRECISION) {
+	  reorder<toFloatN,double,double>(out, in, nBlock, volume, length, siteStride, N, stride);
+	} else if (inPrec == QUDA_SINGLE_PRECISION) {
+	  reorder<toFloatN,double,float>(out, in, nBlock, volume, length, siteStride, N, stride);
+	} else {
+	  errorQuda("Unsupported precision %d", inPrec);
+	}
+      } else if (outPrec == QUDA_SINGLE_PRECISION) {
+	if (inPrec == QUDA_DOUBLE_PRECISION) {
+	  reorder<toFloatN,float,double>(out, in, nBlock, volume, length, siteStride, N, stride);
+	} else if (inPrec == QUDA_SINGLE_PRECISION) {
+	  reorder<toFloatN,float,float>(out, in, nBlock, volume, length, siteStride, N, stride);
+	} else {
+	  errorQuda("Unsupported precision %d", inPrec);
+	}
+      } else {
+	errorQuda("Unsupported precision %d", outPrec);
+      }
+    }
+
+  } // anonymous namespace
+
+
+  void reorderToFloatN(void **out, void **in, int nBlock, QudaPrecision outPrec, QudaPrecision inPrec,
+		       int volume, int length, int siteStride, int N, int stride)
+  {
+    reorder<true>(out, in, nBlock, outPrec, inPrec, volume, length, siteStride, N, stride);
+  }
+
+  void reorderFromFloatN(void **out, void **in, int nBlock, QudaPrecision outPrec, QudaPrecision inPrec,
+			 int volume, int length, int siteStride, int N, int stride)
+  {
+    reorder<false>(out, in, nBlock, outPrec, inPrec, volume, length, siteStride, N, stride);
+  }
+
+} // namespace quda
@@ -0,0 +1,269 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <vector>
+#include <string>
+
+#include <quda_internal.h>
+#include <host_thread_quda.h>
+
+namespace quda {
+
+  namespace {
+
+    struct Job {
+      const HostLoop *loop;
+      int n;
+      int nthreads;
+      HostSchedule schedule;
+      int chunk;
+    };
+
+    // the remaining work of one thread under the work-stealing schedule
+    struct Range {
+      pthread_mutex_t lock;
+      int begin;
+      int end;
+      char pad[64]; // keep the ranges of different threads on different cache lines
+    };
+
+    struct WorkerArg {
+      int id;
+      unsigned long generation;
+    };
+
+    pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER; // held by the thread issuing a parallel loop
+    pthread_mutex_t state_lock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t start_cond = PTHREAD_COND_INITIALIZER;
+    pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+
+    std::vector<pthread_t> workers;
+    std::vector<WorkerArg*> worker_args;
+    Range *ranges = 0;
+    int nranges = 0;
+
+    Job job;
+    unsigned long generation = 0;
+    int pending = 0;
+    bool shutdown = false;
+
+    pthread_key_t worker_key;
+    pthread_once_t key_once = PTHREAD_ONCE_INIT;
+
+    std::vector<int> affinity;
+    bool affinity_init = false;
+
+    void createKey() { pthread_key_create(&worker_key, 0); }
+
+    bool isWorker() {
+      pthread_once(&key_once, createKey);
+      return pthread_getspecific(worker_key) != 0;
+    }
+
+    // parse "0-7,16-23" into a list of cores
+    void parseAffinity() {
+      affinity_init = true;
+      char *env = getenv("QUDA_HOST_AFFINITY");
+      if (!env) return;
+      std::string list(env);
+      size_t start = 0;
+      while (start < list.size()) {
+	size_t end = list.find(',', start);
+	if (end == std::string::npos) end = list.size();
+	std::string item = list.substr(start, end - start);
+	char *rest;
+	long first = strtol(item.c_str(), &rest, 10);
+	long last = (*rest == '-') ? strtol(rest+1, &rest, 10) : first;
+	if (rest == item.c_str() || *rest != '\0' || first < 0 || last < first) {
+	  warningQuda("Ignoring malformed entry \"%s\" in QUDA_HOST_AFFINITY", item.c_str());
+	} else {
+	  for (long c=first; c<=last; c++) affinity.push_back(c);
+	}
+	start = end + 1;
+      }
+    }
+
+    void setAffinity(int id) {
+#ifdef __linux__
+      if (affinity.empty()) return;
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(affinity[id % affinity.size()], &set);
+      if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set))
+	warningQuda("Unable to bind host thread %d to core %d", id, affinity[id % affinity.size()]);
+#endif
+    }
+
+    // take the next chunk from the front of our own range
+    bool takeChunk(Range &r, int chunk, int &begin, int &end) {
+      pthread_mutex_lock(&r.lock);
+      begin = r.begin;
+      end = (r.end - r.begin > chunk) ? r.begin + chunk : r.end;
+      r.begin = end;
+      pthread_mutex_unlock(&r.lock);
+      return begin < end;
+    }
+
+    // move the back half of another thread's remaining range into ours
+    bool steal(int id, int nthreads) {
+      for (int i=1; i<nthreads; i++) {
+	Range &victim = ranges[(id + i) % nthreads];
+	pthread_mutex_lock(&victim.lock);
+	const int remaining = victim.end - victim.begin;
+	if (remaining > 0) {
+	  const int mid = victim.end - (remaining + 1) / 2;
+	  const int end = victim.end;
+	  victim.end = mid;
+	  pthread_mutex_unlock(&victim.lock);
+
+	  Range &own = ranges[id];
+	  pthread_mutex_lock(&own.lock);
+	  own.begin = mid;
+	  own.end = end;
+	  pthread_mutex_unlock(&own.lock);
+	  return true;
+	}
+	pthread_mutex_unlock(&victim.lock);
+      }
+      return false;
+    }
+
+    void execute(const Job &j, int id) {
+      if (j.schedule == HOST_SCHEDULE_STATIC) {
+	const int begin = (int)((long long)j.n * id / j.nthreads);
+	const int end = (int)((long long)j.n * (id+1) / j.nthreads);
+	if (begin < end) (*j.loop)(begin, end, id);
+      } else {
+	int begin, end;
+	do {
+	  while (takeChunk(ranges[id], j.chunk, begin, end)) (*j.loop)(begin, end, id);
+	} while (steal(id, j.nthreads));
+      }
+    }
+
+    void *workerMain(void *ptr) {
+      WorkerArg *arg = static_cast<WorkerArg*>(ptr);
+      const int id = arg->id;
+      unsigned long seen = arg->generation;
+      pthread_setspecific(worker_key, arg);
+      setAffinity(id);
+
+      while (true) {
+	pthread_mutex_lock(&state_lock);
+	while (generation == seen && !shutdown) pthread_cond_wait(&start_cond, &state_lock);
+	if (shutdown) {
+	  pthread_mutex_unlock(&state_lock);
+	  break;
+	}
+	seen = generation;
+	const Job j = job;
+	pthread_mutex_unlock(&state_lock);
+
+	if (id >= j.nthreads) continue;
+	perfCountersAttachWorker();
+	execute(j, id);
+
+	pthread_mutex_lock(&state_lock);
+	if (--pending == 0) pthread_cond_signal(&done_cond);
+	pthread_mutex_unlock(&state_lock);
+      }
+      return 0;
+    }
+
+    // make sure there are at least nthreads-1 workers and nthreads ranges
+    void growPool(int nthreads) {
+      pthread_once(&key_once, createKey);
+      if (!affinity_init) parseAffinity();
+
+      while ((int)workers.size() < nthreads-1) {
+	WorkerArg *arg = new WorkerArg;
+	arg->id = workers.size() + 1;
+	arg->generation = generation;
+	pthread_t thread;
+	if (pthread_create(&thread, 0, workerMain, arg))
+	  errorQuda("Failed to create host worker thread %d", arg->id);
+	workers.push_back(thread);
+	worker_args.push_back(arg);
+      }
+
+      if (nranges < nthreads) {
+	for (int i=0; i<nranges; i++) pthread_mutex_destroy(&ranges[i].lock);
+	delete []ranges;
+	ranges = new Range[nthreads];
+	for (int i=0; i<nthreads; i++) pthread_mutex_init(&ranges[i].lock, 0);
+	nranges = nthreads;
+      }
+    }
+
+  } // anonymous namespace
+
+
+  void hostParallelFor(const HostLoop &loop, int n, int nthreads, HostSchedule schedule, int chunk)
+  {
+    if (n <= 0) return;
+    if (nthreads > n) nthreads = n;
+    if (nthreads <= 1 || isWorker() || pthread_mutex_trylock(&pool_lock)) {
+      loop(0, n, 0);
+      return;
+    }
+
+    growPool(nthreads);
+
+    Job j;
+    j.loop = &loop;
+    j.n = n;
+    j.nthreads = nthreads;
+    j.schedule = schedule;
+    j.chunk = chunk > 0 ? chunk : (n / (16*nthreads) > 0 ? n / (16*nthreads) : 1);
+
+    if (schedule == HOST_SCHEDULE_STEAL) {
+      for (int i=0; i<nthreads; i++) {
+	ranges[i].begin = (int)((long long)n * i / nthreads);
+	ranges[i].end = (int)((long long)n * (i+1) / nthreads);
+      }
+    }
+
+    pthread_mutex_lock(&state_lock);
+    job = j;
+    pending = nthreads - 1;
+    generation++;
+    pthread_cond_broadcast(&start_cond);
+    pthread_mutex_unlock(&state_lock);
+
+    execute(j, 0);
+
+    pthread_mutex_lock(&state_lock);
+    while (pending > 0) pthread_cond_wait(&done_cond, &state_lock);
+    pthread_mutex_unlock(&state_lock);
+
+    pthread_mutex_unlock(&pool_lock);
+  }
+
+
+  void hostThreadsEnd()
+  {
+    pthread_mutex_lock(&pool_lock);
+
+    pthread_mutex_lock(&state_lock);
+    shutdown = true;
+    pthread_cond_broadcast(&start_cond);
+    pthread_mutex_unlock(&state_lock);
+
+    for (size_t i=0; i<workers.size(); i++) {
+      pthread_join(workers[i], 0);
+      delete worker_args[i];
+    }
+    workers.clear();
+    worker_args.clear();
+
+    for (int i=0; i<nranges; i++) pthread_mutex_destroy(&ranges[i].lock);
+    delete []ranges;
+    ranges = 0;
+    nranges = 0;
+
+    shutdown = false;
+    pthread_mutex_unlock(&pool_lock);
+  }
+
+} // namespace quda
@@ -9,6 +9,8 @@
 #include <quda_internal.h>
 #include <comm_quda.h>
 #include <tune_quda.h>
+#include <host_thread_quda.h>
+#include <site_order_quda.h>
 #include <blas_quda.h>
 #include <gauge_field.h>
 #include <dirac_quda.h>
@@ -114,6 +116,9 @@ static TimeProfile profileGaugeForce("computeGaugeForceQuda");
 //!<Profiler for updateGaugeFieldQuda 
 static TimeProfile profileGaugeUpdate("updateGaugeFieldQuda");
 
+//!< Profiler for gaugeObservablesQuda
+static TimeProfile profileGaugeObs("gaugeObservablesQuda");
+
 //!< Profiler for endQuda
 static TimeProfile profileEnd("endQuda");
 
@@ -125,6 +130,18 @@ void setVerbosityQuda(QudaVerbosity verbosity, const char prefix[], FILE *outfil
 }
 
 
+void setHaloPrecisionQuda(QudaPrecision precision)
+{
+  FaceBuffer::setHaloPrecision(precision);
+}
+
+
+void setGaugeGhostCompressionQuda(int enable)
+{
+  FaceBuffer::setGhostCompression(enable ? true : false);
+}
+
+
 typedef struct {
   int ndim;
   int dims[QUDA_MAX_DIM];
@@ -200,6 +217,89 @@ void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata
 }
 
 
+typedef struct {
+  int ndim;
+  int dims[QUDA_MAX_DIM];   // process grid
+  int block[QUDA_MAX_DIM];  // block of the process grid held by each node
+  int ranks_per_node;
+  int *node_ranks;          // ranks on each node, ordered by node then rank
+} NodeMapData;
+
+/**
+ * Node-aware mapping: the process grid is tiled by blocks of
+ * ranks_per_node processes, and each block is assigned to the ranks
+ * of a single node.
+ */
+static int node_rank_from_coords(const int *coords, void *fdata)
+{
+  NodeMapData *md = static_cast<NodeMapData *>(fdata);
+
+  int node = 0, local = 0;
+  for (int i = 0; i < md->ndim; i++) {
+    node = (md->dims[i] / md->block[i]) * node + coords[i] / md->block[i];
+    local = md->block[i] * local + coords[i] % md->block[i];
+  }
+  return md->node_ranks[node * md->ranks_per_node + local];
+}
+
+
+void initCommsGridAutoQuda(int nDim, const int *X, int *dims)
+{
+  if (nDim != 4) {
+    errorQuda("Number of communication grid dimensions must be 4");
+  }
+
+  int size = comm_world_size();
+  int *node_id = (int *)safe_malloc(size*sizeof(int));
+  comm_world_nodes(node_id);
+
+  // count the ranks on each node; node blocking requires that they all agree
+  int nodes = 0;
+  for (int i = 0; i < size; i++) if (node_id[i] + 1 > nodes) nodes = node_id[i] + 1;
+  int ranks_per_node = size / nodes;
+  for (int n = 0; n < nodes; n++) {
+    int count = 0;
+    for (int i = 0; i < size; i++) if (node_id[i] == n) count++;
+    if (count != ranks_per_node) ranks_per_node = 0;
+  }
+  if (ranks_per_node == 0) {
+    warningQuda("Nodes have differing numbers of processes; ignoring node layout");
+    ranks_per_node = 1;
+    nodes = size;
+    for (int i = 0; i < size; i++) node_id[i] = i;
+  }
+
+  NodeMapData map_data;
+  map_data.ndim = nDim;
+  map_data.ranks_per_node = ranks_per_node;
+  if (comm_auto_grid(nDim, X, size, ranks_per_node, map_data.dims, map_data.block) < 0.0) {
+    errorQuda("No process grid of %d processes evenly divides the %dx%dx%dx%d lattice",
+	      size, X[0], X[1], X[2], X[3]);
+  }
+
+  map_data.node_ranks = (int *)safe_malloc(size*sizeof(int));
+  int k = 0;
+  for (int n = 0; n < nodes; n++) {
+    for (int i = 0; i < size; i++) if (node_id[i] == n) map_data.node_ranks[k++] = i;
+  }
+  host_free(node_id);
+
+  for (int i = 0; i < nDim; i++) dims[i] = map_data.dims[i];
+
+  // the map is only used during comm_init(), so map_data may live on the stack
+  initCommsGridQuda(nDim, dims, node_rank_from_coords, &map_data);
+
+  // printfQuda() only prints once comm_init() has assigned the ranks
+  if (getVerbosity() >= QUDA_SUMMARIZE) {
+    printfQuda("Automatic process grid %dx%dx%dx%d on %d nodes with %dx%dx%dx%d ranks per node\n",
+	       dims[0], dims[1], dims[2], dims[3], nodes, map_data.block[0], map_data.block[1],
+	       map_data.block[2], map_data.block[3]);
+  }
+
+  host_free(map_data.node_ranks);
+}
+
+
 static void init_default_comms()
 {
 #if defined(QMP_COMMS)
@@ -334,6 +434,10 @@ void initQudaMemory()
 
 void initQuda(int dev)
 {
+  // enable hierarchical tracing and hardware counters if requested
+  traceInit();
+  perfCountersInit();
+
   profileInit.Start(QUDA_PROFILE_TOTAL);
 
   // initialize communications topology, if not already done explicitly via initCommsGridQuda()
@@ -361,6 +465,7 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   profileGauge.Start(QUDA_PROFILE_INIT);  
   // Set the specific input parameters and create the cpu gauge field
   GaugeFieldParam gauge_param(h_gauge, *param);
+  if (param->location == QUDA_CPU_FIELD_LOCATION) gauge_param.reconstruct = param->cpu_reconstruct;
 
   // if we are using half precision then we need to compute the fat
   // link maximum while still on the cpu
@@ -475,6 +580,7 @@ void saveGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 
   // Set the specific cpu parameters and create the cpu gauge field
   GaugeFieldParam gauge_param(h_gauge, *param);
+  gauge_param.reconstruct = param->cpu_reconstruct;
   cpuGaugeField cpuGauge(gauge_param);
   cudaGaugeField *cudaGauge = NULL;
   switch (param->type) {
@@ -679,6 +785,7 @@ void endQuda(void)
   FaceBuffer::flushPinnedCache();
   freeGaugeQuda();
   freeCloverQuda();
+  freeSiteOrderTables();
 
   endBlas();
 
@@ -698,6 +805,12 @@ void endQuda(void)
 
   initialized = false;
 
+  printHostKernelProfile();
+  printRooflineProfile();
+  closeSolverTelemetry();
+  hostThreadsEnd();
+  traceFinalize();
+  comm_profile_print();
   comm_finalize();
   comms_initialized = false;
 
@@ -714,6 +827,7 @@ void endQuda(void)
     profileFatLink.Print();
     profileGaugeForce.Print();
     profileGaugeUpdate.Print();
+    profileGaugeObs.Print();
     profileEnd.Print();
 
     printfQuda("\n");
@@ -1284,6 +1398,7 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   param->secs = 0;
   param->gflops = 0;
   param->iter = 0;
+  param->telemetry_count = 0;
 
   Dirac *d = NULL;
   Dirac *dSloppy = NULL;
@@ -1528,6 +1643,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
   param->secs = 0;
   param->gflops = 0;
   param->iter = 0;
+  param->telemetry_count = 0;
 
   for (int i=0; i<param->num_offset-1; i++) {
     for (int j=i+1; j<param->num_offset; j++) {
@@ -1886,6 +2002,8 @@ computeKSLinkQuda(void* fatlink, void* longlink, void** sitelink, double* act_pa
   static cpuGaugeField* cpuFatLink=NULL, *cpuSiteLink=NULL, *cpuLongLink=NULL;
   static cudaGaugeField* cudaFatLink=NULL, *cudaSiteLink=NULL, *cudaLongLink=NULL;
   int flag = qudaGaugeParam->preserve_gauge;
+  // fatten on the host, without creating any device fields
+  const bool hostFat = (qudaGaugeParam->fat_link_location == QUDA_CPU_FIELD_LOCATION);
 
   QudaGaugeParam qudaGaugeParam_ex_buf;
   QudaGaugeParam* qudaGaugeParam_ex = &qudaGaugeParam_ex_buf;
@@ -1919,7 +2037,7 @@ computeKSLinkQuda(void* fatlink, void* longlink, void** sitelink, double* act_pa
   }
 
   // create the device fatlink
-  if(cudaFatLink == NULL){
+  if(cudaFatLink == NULL && !hostFat){
     gParam.pad    = qudaGaugeParam->llfat_ga_pad;
     gParam.create = QUDA_ZERO_FIELD_CREATE;
     gParam.link_type = QUDA_ASQTAD_FAT_LINKS;
@@ -1945,7 +2063,7 @@ computeKSLinkQuda(void* fatlink, void* longlink, void** sitelink, double* act_pa
 
   if(longlink){
     // create the device longlink
-    if(cudaLongLink == NULL){
+    if(cudaLongLink == NULL && !hostFat){
       gParam.pad = qudaGaugeParam->llfat_ga_pad; // same padding as for the fatlink - for the time being
       gParam.create = QUDA_ZERO_FIELD_CREATE;
       gParam.link_type = QUDA_ASQTAD_LONG_LINKS;
@@ -1971,7 +2089,7 @@ computeKSLinkQuda(void* fatlink, void* longlink, void** sitelink, double* act_pa
     cpuSiteLink->setGauge(sitelink);
   }
 
-  if(cudaSiteLink == NULL){
+  if(cudaSiteLink == NULL && !hostFat){
     gParam.pad         = qudaGaugeParam->site_ga_pad;
     gParam.create      = QUDA_NULL_FIELD_CREATE;
     gParam.link_type   = qudaGaugeParam->type;
@@ -1983,45 +2101,52 @@ computeKSLinkQuda(void* fatlink, void* longlink, void** sitelink, double* act_pa
 
   profileFatLink.Stop(QUDA_PROFILE_INIT);
 
-  initLatticeConstants(*cudaFatLink, profileFatLink);  
+  if (hostFat) {
+    // the halo exchange of the site links is done inside
+    profileFatLink.Start(QUDA_PROFILE_COMPUTE);
+    computeKSLinkCPU(*cpuFatLink, longlink ? cpuLongLink : NULL, *cpuSiteLink, act_path_coeff, method);
+    profileFatLink.Stop(QUDA_PROFILE_COMPUTE);
+  } else {
+    initLatticeConstants(*cudaFatLink, profileFatLink);  
 
-  if (method == QUDA_COMPUTE_FAT_STANDARD) {
-    llfat_init_cuda(qudaGaugeParam);
+    if (method == QUDA_COMPUTE_FAT_STANDARD) {
+      llfat_init_cuda(qudaGaugeParam);
 
 #ifdef MULTI_GPU
-    if(qudaGaugeParam->gauge_order == QUDA_MILC_GAUGE_ORDER){
-      errorQuda("Only QDP-ordered site links are supported in the multi-gpu standard fattening code\n");
-    }
+      if(qudaGaugeParam->gauge_order == QUDA_MILC_GAUGE_ORDER){
+        errorQuda("Only QDP-ordered site links are supported in the multi-gpu standard fattening code\n");
+      }
 #endif
-    profileFatLink.Start(QUDA_PROFILE_H2D);
-    loadLinkToGPU(cudaSiteLink, cpuSiteLink, qudaGaugeParam);
-    profileFatLink.Stop(QUDA_PROFILE_H2D);
+      profileFatLink.Start(QUDA_PROFILE_H2D);
+      loadLinkToGPU(cudaSiteLink, cpuSiteLink, qudaGaugeParam);
+      profileFatLink.Stop(QUDA_PROFILE_H2D);
 
-  } else {
-    llfat_init_cuda_ex(qudaGaugeParam_ex);
+    } else {
+      llfat_init_cuda_ex(qudaGaugeParam_ex);
 
 #ifdef MULTI_GPU
-    profileFatLink.Start(QUDA_PROFILE_COMMS);
-    int R[4] = {2, 2, 2, 2}; // radius of the extended region in each dimension / direction
-    exchange_cpu_sitelink_ex(qudaGaugeParam->X, R, (void**)cpuSiteLink->Gauge_p(), 
-        cpuSiteLink->Order(),qudaGaugeParam->cpu_prec, 0);
-    profileFatLink.Stop(QUDA_PROFILE_COMMS);
+      profileFatLink.Start(QUDA_PROFILE_COMMS);
+      int R[4] = {2, 2, 2, 2}; // radius of the extended region in each dimension / direction
+      exchange_cpu_sitelink_ex(qudaGaugeParam->X, R, (void**)cpuSiteLink->Gauge_p(), 
+          cpuSiteLink->Order(),qudaGaugeParam->cpu_prec, 0);
+      profileFatLink.Stop(QUDA_PROFILE_COMMS);
 #endif
 
-    profileFatLink.Start(QUDA_PROFILE_H2D);
-    loadLinkToGPU_ex(cudaSiteLink, cpuSiteLink);
-    profileFatLink.Stop(QUDA_PROFILE_H2D);
-  }
+      profileFatLink.Start(QUDA_PROFILE_H2D);
+      loadLinkToGPU_ex(cudaSiteLink, cpuSiteLink);
+      profileFatLink.Stop(QUDA_PROFILE_H2D);
+    }
 
-  // Actually do the fattening
-  computeFatLinkCore(cudaSiteLink, act_path_coeff, qudaGaugeParam, method, 
-		     cudaFatLink, cudaLongLink, profileFatLink);
+    // Actually do the fattening
+    computeFatLinkCore(cudaSiteLink, act_path_coeff, qudaGaugeParam, method, 
+		       cudaFatLink, cudaLongLink, profileFatLink);
 
-  // Transfer back to the host
-  profileFatLink.Start(QUDA_PROFILE_D2H);
-  storeLinkToCPU(cpuFatLink, cudaFatLink, qudaGaugeParam);
-  if(longlink) storeLinkToCPU(cpuLongLink, cudaLongLink, qudaGaugeParam);
-  profileFatLink.Stop(QUDA_PROFILE_D2H);
+    // Transfer back to the host
+    profileFatLink.Start(QUDA_PROFILE_D2H);
+    storeLinkToCPU(cpuFatLink, cudaFatLink, qudaGaugeParam);
+    if(longlink) storeLinkToCPU(cpuLongLink, cudaLongLink, qudaGaugeParam);
+    profileFatLink.Stop(QUDA_PROFILE_D2H);
+  }
 
   profileFatLink.Start(QUDA_PROFILE_FREE);
   if (!(flag & QUDA_FAT_PRESERVE_CPU_GAUGE) ){
@@ -2242,6 +2367,35 @@ void updateGaugeFieldQuda(void* gauge,
 }
 
 
+void gaugeObservablesQuda(void *h_gauge, QudaGaugeParam *param, QudaGaugeObservableParam *obs)
+{
+  profileGaugeObs.Start(QUDA_PROFILE_TOTAL);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+  if (param->location != QUDA_CPU_FIELD_LOCATION) 
+    errorQuda("Non-cpu input location not yet supported");
+
+  profileGaugeObs.Start(QUDA_PROFILE_INIT);
+  GaugeFieldParam gauge_param(h_gauge, *param);
+  gauge_param.reconstruct = param->cpu_reconstruct;
+  cpuGaugeField cpuGauge(gauge_param);
+  profileGaugeObs.Stop(QUDA_PROFILE_INIT);
+
+  profileGaugeObs.Start(QUDA_PROFILE_COMPUTE);
+  gaugeObservables(*obs, cpuGauge);
+  profileGaugeObs.Stop(QUDA_PROFILE_COMPUTE);
+
+  if (getVerbosity() >= QUDA_VERBOSE) {
+    printfQuda("Plaquette = %.12e (spatial %.12e, temporal %.12e), rectangle = %.12e\n",
+	       obs->plaquette[0], obs->plaquette[1], obs->plaquette[2], obs->rectangle);
+    printfQuda("Polyakov loop = (%.12e, %.12e), topological charge = %.12e\n",
+	       obs->polyakov_loop[0], obs->polyakov_loop[1], obs->qcharge);
+  }
+
+  profileGaugeObs.Stop(QUDA_PROFILE_TOTAL);
+}
+
+
 
 
 /*
@@ -60,6 +60,7 @@ namespace quda {
 
   void BiCGstab::operator()(cudaColorSpinorField &x, cudaColorSpinorField &b) 
   {
+    TraceScope scope("BiCGstab");
     profile.Start(QUDA_PROFILE_PREAMBLE);
 
     if (!init) {
@@ -170,14 +171,19 @@ namespace quda {
     rho = r2; // cDotProductCuda(r0, r_sloppy); // BiCRstab
     copyCuda(p, rSloppy);
 
+    SolverTelemetry telemetry(param, "BiCGstab");
+
     if (getVerbosity() >= QUDA_DEBUG_VERBOSE) 
       printfQuda("BiCGstab debug: x2=%e, r2=%e, v2=%e, p2=%e, tmp2=%e r0=%e t2=%e\n", 
 		 norm2(x), norm2(rSloppy), norm2(v), norm2(p), norm2(tmp), norm2(r0), norm2(t));
 
     while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && 
 	    k < param.maxiter) {
+      TraceScope iteration("iteration");
     
+      telemetry.MatvecStart();
       matSloppy(v, p, tmp);
+      telemetry.MatvecStop();
 
       Complex r0v;
       if (param.pipeline) {
@@ -192,7 +198,9 @@ namespace quda {
       // r -= alpha*v
       caxpyCuda(-alpha, v, rSloppy);
 
+      telemetry.MatvecStart();
       matSloppy(t, rSloppy, tmp);
+      telemetry.MatvecStop();
     
       int updateR = 0;
       if (param.pipeline) {
@@ -240,7 +248,9 @@ namespace quda {
       
 	xpyCuda(x, y); // swap these around?
 
+	telemetry.MatvecStart();
 	mat(r, y, x);
+	telemetry.MatvecStop();
 	r2 = xmyNormCuda(b, r);
 
 	if (x.Precision() != rSloppy.Precision()) copyCuda(rSloppy, r);            
@@ -256,6 +266,8 @@ namespace quda {
       k++;
 
       PrintStats("BiCGstab", k, r2, b2, heavy_quark_res);
+      // the residual of a reliable update is computed in full precision
+      telemetry.Record(k, r2, b2, heavy_quark_res, updateR, updateR ? param.precision : param.precision_sloppy);
       if (getVerbosity() >= QUDA_DEBUG_VERBOSE) 
 	printfQuda("BiCGstab debug: x2=%e, r2=%e, v2=%e, p2=%e, tmp2=%e r0=%e t2=%e\n", 
 		   norm2(x), norm2(rSloppy), norm2(v), norm2(p), norm2(tmp), norm2(r0), norm2(t));
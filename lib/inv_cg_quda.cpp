@@ -28,6 +28,7 @@ namespace quda {
 
   void CG::operator()(cudaColorSpinorField &x, cudaColorSpinorField &b) 
   {
+    TraceScope scope("CG");
     profile.Start(QUDA_PROFILE_INIT);
 
     // Check to see that we're not trying to invert on a zero-field source    
@@ -123,11 +124,15 @@ namespace quda {
     
     PrintStats("CG", k, r2, b2, heavy_quark_res);
 
+    SolverTelemetry telemetry(param, "CG");
     int steps_since_reliable = 1;
 
     while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && 
 	    k < param.maxiter) {
+      TraceScope iteration("iteration");
+      telemetry.MatvecStart();
       matSloppy(Ap, p, tmp, tmp2); // tmp as tmp
+      telemetry.MatvecStop();
     
       double sigma;
 
@@ -186,7 +191,9 @@ namespace quda {
 	if (x.Precision() != xSloppy.Precision()) copyCuda(x, xSloppy);
       
 	xpyCuda(x, y); // swap these around?
+	telemetry.MatvecStart();
 	mat(r, y, x); // here we can use x as tmp
+	telemetry.MatvecStop();
 	r2 = xmyNormCuda(b, r);
 
 	if (x.Precision() != rSloppy.Precision()) copyCuda(rSloppy, r);            
@@ -225,6 +232,9 @@ namespace quda {
       k++;
 
       PrintStats("CG", k, r2, b2, heavy_quark_res);
+      // the residual of a reliable update is computed in full precision
+      telemetry.Record(k, r2, b2, heavy_quark_res, updateR || updateX,
+		       (updateR || updateX) ? param.precision : param.precision_sloppy);
     }
 
     if (x.Precision() != xSloppy.Precision()) copyCuda(x, xSloppy);
@@ -163,6 +163,7 @@ namespace quda {
 
   void GCR::operator()(cudaColorSpinorField &x, cudaColorSpinorField &b)
   {
+    TraceScope scope("GCR");
     profile.Start(QUDA_PROFILE_INIT);
 
     int Nkrylov = param.Nkrylov; // size of Krylov space
@@ -270,8 +271,10 @@ namespace quda {
 
     int k = 0;
     PrintStats("GCR", total_iter+k, r2, b2, heavy_quark_res);
+    SolverTelemetry telemetry(param, "GCR");
     while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && 
 	    total_iter < param.maxiter) {
+      TraceScope iteration("iteration");
     
       for (int m=0; m<param.precondition_cycle; m++) {
 	if (param.inv_type_precondition != QUDA_INVALID_INVERTER) {
@@ -298,7 +301,9 @@ namespace quda {
 	  *p[k] = rSloppy;
 	} 
       
+	telemetry.MatvecStart();
 	matSloppy(*Ap[k], *p[k], tmp);
+	telemetry.MatvecStop();
 	if (getVerbosity()>= QUDA_DEBUG_VERBOSE)
 	  printfQuda("GCR debug iter=%d: Ap2=%e, p2=%e, rPre2=%e\n", total_iter, norm2(*Ap[k]), norm2(*p[k]), norm2(rPre));
       }
@@ -329,7 +334,8 @@ namespace quda {
    
       // update since Nkrylov or maxiter reached, converged or reliable update required
       // note that the heavy quark residual will by definition only be checked every Nkrylov steps
-      if (k==Nkrylov || total_iter==param.maxiter || (r2 < stop && !l2_converge) || r2/r2_old < param.delta) { 
+      const bool update = (k==Nkrylov || total_iter==param.maxiter || (r2 < stop && !l2_converge) || r2/r2_old < param.delta);
+      if (update) { 
 
 	// update the solution vector
 	updateSolution(xSloppy, alpha, beta, gamma, k, p);
@@ -337,7 +343,9 @@ namespace quda {
 	// recalculate residual in high precision
 	copyCuda(x, xSloppy);
 	xpyCuda(x, y);
+	telemetry.MatvecStart();
 	mat(r, y, x);
+	telemetry.MatvecStop();
 	r2 = xmyNormCuda(b, r);  
 
 	if (use_heavy_quark_res) heavy_quark_res = sqrt(HeavyQuarkResidualNormCuda(y, r).z);
@@ -359,6 +367,8 @@ namespace quda {
 
       }
 
+      // the residual of an update is recomputed in full precision
+      telemetry.Record(total_iter, r2, b2, heavy_quark_res, update, update ? param.precision : param.precision_sloppy);
     }
 
     if (total_iter > 0) copyCuda(x, y);
@@ -34,6 +34,7 @@ namespace quda {
 
   void MR::operator()(cudaColorSpinorField &x, cudaColorSpinorField &b)
   {
+    TraceScope scope("MR");
 
     globalReduce = false; // use local reductions for DD solver
 
@@ -82,6 +83,7 @@ namespace quda {
     }
 
     while (k < param.maxiter && r2 > 0.0) {
+      TraceScope iteration("iteration");
     
       mat(Ar, r, tmp);
 
@@ -56,6 +56,7 @@ namespace quda {
 
   void MultiShiftCG::operator()(cudaColorSpinorField **x, cudaColorSpinorField &b)
   {
+    TraceScope scope("MultiShiftCG");
     profile.Start(QUDA_PROFILE_INIT);
 
     int num_offset = param.num_offset;
@@ -172,8 +173,12 @@ namespace quda {
     if (getVerbosity() >= QUDA_VERBOSE) 
       printfQuda("MultiShift CG: %d iterations, <r,r> = %e, |r|/|b| = %e\n", k, r2[0], sqrt(r2[0]/b2));
     
+    SolverTelemetry telemetry(param, "MultiShiftCG");
     while (r2[0] > stop[0] &&  k < param.maxiter) {
+      TraceScope iteration("iteration");
+      telemetry.MatvecStart();
       matSloppy(*Ap, *p[0], tmp1, tmp2);
+      telemetry.MatvecStop();
       // FIXME - this should be curried into the Dirac operator
       if (r->Nspin()==4) axpyCuda(offset[0], *p[0], *Ap); 
 
@@ -219,7 +224,9 @@ namespace quda {
 	  xpyCuda(*x[j], *y[j]);
 	}
 
+	telemetry.MatvecStart();
 	mat(*r, *y[0], *x[0]); // here we can use x as tmp
+	telemetry.MatvecStop();
 	if (r->Nspin()==4) axpyCuda(offset[0], *y[0], *r);
 
 	r2[0] = xmyNormCuda(b, *r);
@@ -268,6 +275,9 @@ namespace quda {
       
       if (getVerbosity() >= QUDA_VERBOSE) 
 	printfQuda("MultiShift CG: %d iterations, <r,r> = %e, |r|/|b| = %e\n", k, r2[0], sqrt(r2[0]/b2));
+      // the residual is that of the smallest shift
+      const bool updated = reliable && (updateR || updateX); // residual recomputed in full precision
+      telemetry.Record(k, r2[0], b2, 0.0, updated, updated ? param.precision : param.precision_sloppy);
     }
     
     
@@ -0,0 +1,287 @@
+#include <vector>
+#include <typeinfo>
+
+#include <extended_links_quda.h>
+#include <llfat_quda.h>
+
+/**
+   Host asqtad/HISQ link fattening.  The site links are copied into a
+   local field padded by a halo of depth two (see
+   extended_links_quda.h).  The fat link is then built from the
+   one-link, 3-, 5- and 7-link staple and Lepage terms, and the long
+   link from the Naik term, with the same path coefficients as the
+   device code: the 3-link staple of each (mu,nu) is stored and reused
+   by the Lepage term and the 5-link staples, and each 5-link staple by
+   the 7-link staple, so every staple is computed once.  Staples are
+   only evaluated on the part of the halo from which later terms read
+   them.  Each pass is split over (z,t) planes between the host
+   threads, and the thread count is tuned as a TunableCPU.
+ */
+
+#ifdef GPU_FATLINK
+
+namespace quda {
+
+  namespace {
+
+    /** Write the interior results into the output field */
+    template <typename Float, typename Order>
+      struct StoreLinks {
+	Order &order;
+	const Link<Float> *links;
+	const int *X;
+
+	StoreLinks(Order &order, const Link<Float> *links, const int *X) : order(order), links(links), X(X) { }
+
+	void operator()(int zt) const {
+	  const int z = zt % X[2], t = zt / X[2];
+	  for (int y=0; y<X[1]; y++) {
+	    for (int x=0; x<X[0]; x++) {
+	      const int idx = ((t*X[2] + z)*X[1] + y)*X[0] + x;
+	      const int parity = (x + y + z + t) & 1;
+	      for (int dir=0; dir<4; dir++) order.save(links[4*(size_t)idx + dir].v, idx >> 1, dir, parity);
+	    }
+	  }
+	}
+      };
+
+    enum FatPass { ONE_LINK, STAPLE3, LEPAGE, STAPLE5, STAPLE7, NAIK };
+
+    template <typename Float>
+      class ComputeKSLink : public TunableCPU {
+      const ExtendedLinks<Float> &ext;
+      Link<Float> *fat;  // interior fat links, four per site
+      Link<Float> *lng;  // interior long links, or NULL
+      Float coeff[6];
+      std::vector<Link<Float> > staple3; // 3-link staple of the current (mu,nu)
+      std::vector<Link<Float> > staple5; // 5-link staple of the current (mu,nu,rho)
+      Link<Float> *S3, *S5;
+      int volume;
+
+      struct Pass {
+	FatPass type;
+	int mu, nu;
+	int lo[4], hi[4]; // extended coordinates of the sites to update
+      };
+
+      struct Body {
+	const ComputeKSLink &k;
+	const Pass &p;
+	Body(const ComputeKSLink &k, const Pass &p) : k(k), p(p) { }
+	void operator()(int plane) const {
+	  const int nz = p.hi[2] - p.lo[2];
+	  int c[4];
+	  c[2] = p.lo[2] + plane % nz;
+	  c[3] = p.lo[3] + plane / nz;
+	  for (c[1]=p.lo[1]; c[1]<p.hi[1]; c[1]++)
+	    for (c[0]=p.lo[0]; c[0]<p.hi[0]; c[0]++) k.site(p, c);
+	}
+      };
+
+      /**
+	 The staple of M in the (mu,nu) plane at extended site s:
+	 U_nu(s) M(s+nu) U_nu(s+mu)^dag + U_nu(s-nu)^dag M(s-nu) U_nu(s-nu+mu),
+	 where M is the link U_mu if M is NULL, or the given field
+      */
+      void staple(Link<Float> &out, int s, int mu, int nu, const Link<Float> *M) const {
+	const int *st = ext.stride;
+	const Link<Float> &Mf = M ? M[s+st[nu]] : ext.link(s+st[nu], mu);
+	const Link<Float> &Mb = M ? M[s-st[nu]] : ext.link(s-st[nu], mu);
+	Link<Float> tmp, lower;
+	mult_nn(tmp, ext.link(s, nu), Mf);
+	mult_na(out, tmp, ext.link(s+st[mu], nu));
+	mult_an(tmp, ext.link(s-st[nu], nu), Mb);
+	mult_nn(lower, tmp, ext.link(s-st[nu]+st[mu], nu));
+	axpy(out, (Float)1.0, lower);
+      }
+
+      void site(const Pass &p, const int c[4]) const {
+	const int *E = ext.E, *X = ext.X, R = ext.R;
+	const int s = ((c[3]*E[2] + c[2])*E[1] + c[1])*E[0] + c[0];
+	bool interior = true;
+	for (int d=0; d<4; d++) interior = interior && c[d] >= R && c[d] < R + X[d];
+	const int idx = interior ? (((c[3]-R)*X[2] + c[2]-R)*X[1] + c[1]-R)*X[0] + c[0]-R : -1;
+	Link<Float> tmp;
+
+	switch (p.type) {
+	case ONE_LINK: // the Lepage correction to the one-link term is included here
+	  for (int mu=0; mu<4; mu++) {
+	    Link<Float> &f = fat[4*idx + mu];
+	    for (int i=0; i<18; i++) f.v[i] = (coeff[0] - 6.0*coeff[5]) * ext.link(s, mu).v[i];
+	  }
+	  break;
+	case STAPLE3:
+	  staple(S3[s], s, p.mu, p.nu, 0);
+	  if (interior) axpy(fat[4*idx + p.mu], coeff[2], S3[s]);
+	  break;
+	case LEPAGE:
+	  staple(tmp, s, p.mu, p.nu, S3);
+	  axpy(fat[4*idx + p.mu], coeff[5], tmp);
+	  break;
+	case STAPLE5:
+	  staple(S5[s], s, p.mu, p.nu, S3);
+	  if (interior) axpy(fat[4*idx + p.mu], coeff[3], S5[s]);
+	  break;
+	case STAPLE7:
+	  staple(tmp, s, p.mu, p.nu, S5);
+	  axpy(fat[4*idx + p.mu], coeff[4], tmp);
+	  break;
+	case NAIK:
+	  for (int mu=0; mu<4; mu++) {
+	    mult_nn(tmp, ext.link(s, mu), ext.link(s+ext.stride[mu], mu));
+	    mult_nn(lng[4*idx + mu], tmp, ext.link(s+2*ext.stride[mu], mu));
+	    for (int i=0; i<18; i++) lng[4*idx + mu].v[i] *= coeff[1];
+	  }
+	  break;
+	}
+      }
+
+      /** the interior, widened by one site in the dimensions set in wide */
+      Pass box(FatPass type, int mu, int nu, const bool wide[4]) const {
+	Pass p;
+	p.type = type;
+	p.mu = mu;
+	p.nu = nu;
+	for (int d=0; d<4; d++) {
+	  p.lo[d] = ext.R - (wide[d] ? 1 : 0);
+	  p.hi[d] = ext.R + ext.X[d] + (wide[d] ? 1 : 0);
+	}
+	return p;
+      }
+
+      void run(const Pass &p, int nthreads) const {
+	Body body(*this, p);
+	hostParallelFor((p.hi[2] - p.lo[2])*(p.hi[3] - p.lo[3]), body, nthreads);
+      }
+
+    protected:
+      int maxThreads() const {
+	const int planes = ext.X[2]*ext.X[3];
+	return planes < hostThreadCount() ? planes : hostThreadCount();
+      }
+
+      long long flops() const {
+	// 288 products of the 72 staple passes per site, and 8 for the long links
+	return (long long)volume * (288 + (lng ? 8 : 0)) * 198;
+      }
+
+      long long bytes() const {
+	// each staple pass reads six links or staples and updates a fat link
+	return (long long)volume * (72*8 + 4 + (lng ? 12 : 0)) * sizeof(Link<Float>);
+      }
+
+    public:
+      ComputeKSLink(const ExtendedLinks<Float> &ext, Link<Float> *fat, Link<Float> *lng, const double *act_path_coeff)
+	: ext(ext), fat(fat), lng(lng), staple3(ext.volume), staple5(ext.volume),
+	  S3(&staple3[0]), S5(&staple5[0]), volume(ext.X[0]*ext.X[1]*ext.X[2]*ext.X[3]) {
+	for (int i=0; i<6; i++) coeff[i] = act_path_coeff[i];
+      }
+      virtual ~ComputeKSLink() { }
+
+      void apply(const cudaStream_t &stream) {
+	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+	HostKernelScope scope(*this);
+	const int n = tp.threads;
+	const bool none[4] = { false, false, false, false };
+
+	run(box(ONE_LINK, 0, 0, none), n);
+	for (int mu=0; mu<4; mu++) {
+	  for (int nu=0; nu<4; nu++) {
+	    if (nu == mu) continue;
+	    // the 3-link staple is read one site away in every dimension but mu
+	    bool wide[4] = { true, true, true, true };
+	    wide[mu] = false;
+	    run(box(STAPLE3, mu, nu, wide), n);
+	    run(box(LEPAGE, mu, nu, none), n);
+	    for (int rho=0; rho<4; rho++) {
+	      if (rho == mu || rho == nu) continue;
+	      // the 5-link staple is only read one site away along sigma
+	      const int sig = 6 - mu - nu - rho;
+	      bool wide5[4] = { false, false, false, false };
+	      wide5[sig] = true;
+	      run(box(STAPLE5, mu, rho, wide5), n);
+	      run(box(STAPLE7, mu, sig, none), n);
+	    }
+	  }
+	}
+	if (lng) run(box(NAIK, 0, 0, none), n);
+      }
+
+      TuneKey tuneKey() const {
+	std::stringstream vol, aux;
+	vol << ext.X[0] << "x" << ext.X[1] << "x" << ext.X[2] << "x" << ext.X[3];
+	aux << "prec=" << sizeof(Float) << ",long=" << (lng ? 1 : 0);
+	return TuneKey(vol.str(), typeid(*this).name(), aux.str());
+      }
+    };
+
+    template <typename Float, typename Order>
+      void storeOrdered(Order order, const std::vector<Link<Float> > &links, const int *X) {
+      StoreLinks<Float,Order> store(order, &links[0], X);
+      hostParallelFor(X[2]*X[3], store, hostThreadCount());
+    }
+
+    template <typename Float>
+      void storeLinks(GaugeField &u, const std::vector<Link<Float> > &links, const int *X) {
+      if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+	storeOrdered(QDPOrder<Float,18>(u, (Float*)u.Gauge_p()), links, X);
+      } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
+	storeOrdered(MILCOrder<Float,18>(u, (Float*)u.Gauge_p()), links, X);
+      } else {
+	errorQuda("Gauge field order %d not supported", u.Order());
+      }
+    }
+
+    template <typename Float>
+      void computeKSLink(cpuGaugeField &fat, cpuGaugeField *lng, cpuGaugeField &u,
+			 const double *act_path_coeff, bool extended) {
+      const int *X = fat.X();
+      ExtendedLinks<Float> ext(X);
+
+      if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
+	loadExtended(ext, u, QDPOrder<Float,18>(u, (Float*)u.Gauge_p()), extended);
+      } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
+	loadExtended(ext, u, MILCOrder<Float,18>(u, (Float*)u.Gauge_p()), extended);
+      } else {
+	errorQuda("Gauge field order %d not supported", u.Order());
+      }
+
+      const size_t volume = (size_t)X[0]*X[1]*X[2]*X[3];
+      std::vector<Link<Float> > fatLinks(4*volume), longLinks(lng ? 4*volume : 0);
+      ComputeKSLink<Float> compute(ext, &fatLinks[0], lng ? &longLinks[0] : 0, act_path_coeff);
+      compute.apply(0);
+
+      storeLinks(fat, fatLinks, X);
+      if (lng) storeLinks(*lng, longLinks, X);
+    }
+
+  } // anonymous namespace
+
+  void computeKSLinkCPU(cpuGaugeField &fat, cpuGaugeField *lng, cpuGaugeField &u,
+			const double *act_path_coeff, QudaComputeFatMethod method) {
+    if (u.Ncolor() != 3) errorQuda("Unsupported number of colors; Nc=%d", u.Ncolor());
+    if (u.Reconstruct() != QUDA_RECONSTRUCT_NO || fat.Reconstruct() != QUDA_RECONSTRUCT_NO ||
+	(lng && lng->Reconstruct() != QUDA_RECONSTRUCT_NO))
+      errorQuda("Host link fattening requires uncompressed links");
+    if (u.Precision() != fat.Precision() || (lng && lng->Precision() != fat.Precision()))
+      errorQuda("Site, fat and long link precisions must match");
+
+    const bool extended = (method == QUDA_COMPUTE_FAT_EXTENDED_VOLUME);
+    for (int d=0; d<4; d++) {
+      if (u.X()[d] != fat.X()[d] + (extended ? 4 : 0))
+	errorQuda("Site link dimension %d = %d does not match the fat link dimension %d",
+		  d, u.X()[d], fat.X()[d]);
+    }
+
+    if (fat.Precision() == QUDA_DOUBLE_PRECISION) {
+      computeKSLink<double>(fat, lng, u, act_path_coeff, extended);
+    } else if (fat.Precision() == QUDA_SINGLE_PRECISION) {
+      computeKSLink<float>(fat, lng, u, act_path_coeff, extended);
+    } else {
+      errorQuda("Precision %d not supported", fat.Precision());
+    }
+  }
+
+} // namespace quda
+
+#endif // GPU_FATLINK
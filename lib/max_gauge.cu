@@ -1,28 +1,44 @@
 #include <gauge_field_order.h>
+#include <host_thread_quda.h>
 
 namespace quda {
 
   /**
-     Generic CPU function find the gauge maximum
+     Generic CPU functor to find the gauge maximum at site i =
+     parity*volumeCB + x
   */
   template <typename Float, int Nc, typename Order>
-    double maxGauge(const Order order, int volume, int nDim) {  
-    typedef typename mapper<Float>::type RegType;
-    RegType max = 0.0;
-
-    for (int parity=0; parity<2; parity++) {
+    struct MaxGaugeSite {
+      const Order &order;
+      const int volumeCB;
+      const int nDim;
+      MaxGaugeSite(const Order &order, int volume, int nDim) : order(order), volumeCB(volume/2), nDim(nDim) { }
 
-      for (int d=0; d<nDim; d++) {
-	for (int x=0; x<volume/2; x++) {
+      double operator()(int i) const {
+	typedef typename mapper<Float>::type RegType;
+	const int parity = i / volumeCB;
+	const int x = i - parity*volumeCB;
+	double max = 0.0;
+	for (int d=0; d<nDim; d++) {
 	  RegType v[Nc*Nc*2];
 	  order.load(v, x, d, parity);
-	  for (int i=0; i<Nc*Nc*2; i++) if (abs(v[i]) > max) { max = v[i]; }
+	  for (int j=0; j<Nc*Nc*2; j++) if (fabs(v[j]) > max) max = fabs(v[j]);
 	}
+	return max;
       }
+    };
 
-    }
-
-    return max;
+  template <typename Float, int Nc, typename Order>
+    double maxGauge(const Order order, int volume, int nDim) {  
+    MaxGaugeSite<Float,Nc,Order> site(order, volume, nDim);
+    std::stringstream vol, aux;
+    vol << volume/2;
+    aux << "prec=" << sizeof(Float);
+    TunableHostReduce<double, MaxGaugeSite<Float,Nc,Order>, HostMax>
+      max(site, volume, 0.0, TuneKey(vol.str(), typeid(site).name(), aux.str()),
+	  0, (long long)volume*nDim*order.Bytes());
+    max.apply(0);
+    return max.result;
   }
 
   template <typename Float>
@@ -36,13 +52,33 @@ namespace quda {
     double max;
     // max only supported on external fields currently
     if (u.Order() == QUDA_QDP_GAUGE_ORDER) {
-      max = maxGauge<Float,Nc>(QDPOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	max = maxGauge<Float,Nc>(QDPOrder<Float,2*Nc*Nc,12>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	max = maxGauge<Float,Nc>(QDPOrder<Float,2*Nc*Nc,8>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      } else {
+	max = maxGauge<Float,Nc>(QDPOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      }
     } else if (u.Order() == QUDA_CPS_WILSON_GAUGE_ORDER) {
       max = maxGauge<Float,Nc>(CPSOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
     } else if (u.Order() == QUDA_MILC_GAUGE_ORDER) {
-      max = maxGauge<Float,Nc>(MILCOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	max = maxGauge<Float,Nc>(MILCOrder<Float,2*Nc*Nc,12>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	max = maxGauge<Float,Nc>(MILCOrder<Float,2*Nc*Nc,8>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      } else {
+	max = maxGauge<Float,Nc>(MILCOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      }
     } else if (u.Order() == QUDA_BQCD_GAUGE_ORDER) {
       max = maxGauge<Float,Nc>(BQCDOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+    } else if (u.Order() == QUDA_AOSOA_GAUGE_ORDER) {
+      if (u.Reconstruct() == QUDA_RECONSTRUCT_12) {
+	max = maxGauge<Float,Nc>(AoSoAOrder<Float,2*Nc*Nc,12>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      } else if (u.Reconstruct() == QUDA_RECONSTRUCT_8) {
+	max = maxGauge<Float,Nc>(AoSoAOrder<Float,2*Nc*Nc,8>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      } else {
+	max = maxGauge<Float,Nc>(AoSoAOrder<Float,2*Nc*Nc>(u, (Float*)u.Gauge_p()),u.Volume(),4);
+      }
     } else {
       errorQuda("Gauge field %d order not supported", u.Order());
     }
@@ -57,6 +93,8 @@ namespace quda {
       max = maxGauge<double>(u);
     } else if (u.Precision() == QUDA_SINGLE_PRECISION) {
       max = maxGauge<float>(u);
+    } else if (u.Precision() == QUDA_HALF_PRECISION) {
+      max = maxGauge<short>(u);
     } else {
       errorQuda("Precision %d undefined", u.Precision());
     }
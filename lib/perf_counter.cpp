@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/perf_event.h>
+#endif
+
+#include <quda_internal.h>
+#include <perf_counter_quda.h>
+
+namespace quda {
+
+  bool perfEnabled = false;
+
+  namespace {
+
+    struct PerfEvent {
+      unsigned int type;
+      unsigned long long config;
+      QudaPerfCounter counter;
+      double weight; // counter increment per event count (flops per FP instruction)
+      const char *name;
+    };
+
+    std::vector<PerfEvent> events;
+    double line_size = 64.0;
+    bool warned = false;
+
+    // each thread owns one file descriptor per event, -1 if unavailable
+    struct PerfThread {
+      std::vector<int> fd;
+      bool worker;
+    };
+
+    pthread_key_t thread_key;
+    pthread_once_t key_once = PTHREAD_ONCE_INIT;
+
+    // the host pool workers with open counters; the descriptors are
+    // process-wide, so the caller of a parallel loop can read them
+    std::vector<PerfThread*> workers;
+    pthread_mutex_t worker_lock = PTHREAD_MUTEX_INITIALIZER;
+
+    void closeThread(void *ptr)
+    {
+      PerfThread *t = static_cast<PerfThread*>(ptr);
+      if (t->worker) {
+	pthread_mutex_lock(&worker_lock);
+	for (size_t i=0; i<workers.size(); i++) {
+	  if (workers[i] == t) { workers.erase(workers.begin() + i); break; }
+	}
+	pthread_mutex_unlock(&worker_lock);
+      }
+      for (size_t i=0; i<t->fd.size(); i++) if (t->fd[i] >= 0) close(t->fd[i]);
+      delete t;
+    }
+
+    void createKey() { pthread_key_create(&thread_key, closeThread); }
+
+    void addEvent(unsigned int type, unsigned long long config, QudaPerfCounter counter,
+		  double weight, const char *name)
+    {
+      PerfEvent e;
+      e.type = type;
+      e.config = config;
+      e.counter = counter;
+      e.weight = weight;
+      e.name = name;
+      events.push_back(e);
+    }
+
+#ifdef __linux__
+    int openEvent(const PerfEvent &e)
+    {
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = e.type;
+      attr.config = e.config;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.exclude_kernel = 1; // permitted with perf_event_paranoid <= 2
+      attr.exclude_hv = 1;
+      // pid = 0, cpu = -1: count the calling thread on any processor
+      return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+
+    PerfThread &thread()
+    {
+      pthread_once(&key_once, createKey);
+      PerfThread *t = static_cast<PerfThread*>(pthread_getspecific(thread_key));
+      if (t) return *t;
+
+      t = new PerfThread;
+      t->fd.assign(events.size(), -1);
+      t->worker = false;
+#ifdef __linux__
+      for (size_t i=0; i<events.size(); i++) {
+	t->fd[i] = openEvent(events[i]);
+	if (t->fd[i] < 0 && !warned) {
+	  warningQuda("Performance counter %s is unavailable (%s)%s", events[i].name, strerror(errno),
+		      errno == EACCES || errno == EPERM ? "; check /proc/sys/kernel/perf_event_paranoid" : "");
+	}
+      }
+#else
+      if (!warned) warningQuda("Performance counters are only supported on Linux");
+#endif
+      warned = true;
+      pthread_setspecific(thread_key, t);
+      return *t;
+    }
+
+    // parse "config[:weight],..." into raw floating-point events
+    void parseFpEvents(const char *list)
+    {
+      std::string s(list);
+      size_t start = 0;
+      while (start < s.size()) {
+	size_t end = s.find(',', start);
+	if (end == std::string::npos) end = s.size();
+	std::string item = s.substr(start, end - start);
+	char *rest;
+	unsigned long long config = strtoull(item.c_str(), &rest, 0);
+	double weight = (*rest == ':') ? atof(rest+1) : 1.0;
+	if (rest == item.c_str() || weight <= 0.0) {
+	  warningQuda("Ignoring malformed entry \"%s\" in QUDA_PERF_FP_EVENTS", item.c_str());
+	} else {
+#ifdef __linux__
+	  addEvent(PERF_TYPE_RAW, config, QUDA_PERF_FLOPS, weight, "fp (raw)");
+#endif
+	}
+	start = end + 1;
+      }
+    }
+
+  } // anonymous namespace
+
+
+  void perfCountersInit()
+  {
+    char *enable = getenv("QUDA_PERF_COUNTERS");
+    if (!enable || !strcmp(enable, "0") || perfEnabled) return;
+
+#ifdef __linux__
+    const unsigned long long llc_read = PERF_COUNT_HW_CACHE_LL |
+      (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const unsigned long long llc_write = PERF_COUNT_HW_CACHE_LL |
+      (PERF_COUNT_HW_CACHE_OP_WRITE << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    events.clear();
+    addEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, QUDA_PERF_CYCLES, 1.0, "cycles");
+    addEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, QUDA_PERF_INSTRUCTIONS, 1.0, "instructions");
+    addEvent(PERF_TYPE_HW_CACHE, llc_read, QUDA_PERF_LLC_READ_MISSES, 1.0, "LLC read misses");
+    addEvent(PERF_TYPE_HW_CACHE, llc_write, QUDA_PERF_LLC_WRITE_MISSES, 1.0, "LLC write misses");
+
+    char *fp = getenv("QUDA_PERF_FP_EVENTS");
+    if (fp) parseFpEvents(fp);
+
+#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+    long line = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+    if (line > 0) line_size = line;
+#endif
+#endif
+
+    perfEnabled = true;
+  }
+
+
+  static void readThread(PerfSample &sample, const PerfThread &t)
+  {
+#ifdef __linux__
+    for (size_t i=0; i<events.size(); i++) {
+      if (t.fd[i] < 0) continue;
+      unsigned long long buf[3]; // value, time enabled, time running
+      if (read(t.fd[i], buf, sizeof(buf)) != sizeof(buf)) continue;
+      // scale up if the event was multiplexed with others
+      double value = (buf[2] > 0 && buf[2] < buf[1]) ? (double)buf[0] * buf[1] / buf[2] : (double)buf[0];
+      sample.value[events[i].counter] += events[i].weight * value;
+    }
+#endif
+  }
+
+
+  void perfCountersRead(PerfSample &sample)
+  {
+    perfClear(sample);
+    if (!perfEnabled) return;
+    readThread(sample, thread());
+  }
+
+
+  void perfCountersReadPool(PerfSample &sample)
+  {
+    perfClear(sample);
+    if (!perfEnabled) return;
+    PerfThread &t = thread();
+    readThread(sample, t);
+    if (t.worker) return; // loops issued by a worker run serially on it
+
+    pthread_mutex_lock(&worker_lock);
+    for (size_t i=0; i<workers.size(); i++) readThread(sample, *workers[i]);
+    pthread_mutex_unlock(&worker_lock);
+  }
+
+
+  void perfCountersAttachWorker()
+  {
+    if (!perfEnabled) return;
+    PerfThread &t = thread();
+    if (t.worker) return;
+    t.worker = true;
+    pthread_mutex_lock(&worker_lock);
+    workers.push_back(&t);
+    pthread_mutex_unlock(&worker_lock);
+  }
+
+
+  bool perfCounterAvailable(QudaPerfCounter counter)
+  {
+    if (!perfEnabled) return false;
+    PerfThread &t = thread();
+    for (size_t i=0; i<events.size(); i++) {
+      if (events[i].counter == counter && t.fd[i] >= 0) return true;
+    }
+    return false;
+  }
+
+
+  double perfMemoryBytes(const PerfSample &delta)
+  {
+    return line_size * (delta.value[QUDA_PERF_LLC_READ_MISSES] + delta.value[QUDA_PERF_LLC_WRITE_MISSES]);
+  }
+
+
+  void perfAccumulate(PerfSample &sum, const PerfSample &start, const PerfSample &end)
+  {
+    for (int i=0; i<QUDA_PERF_COUNTER_COUNT; i++) sum.value[i] += end.value[i] - start.value[i];
+  }
+
+
+  void perfClear(PerfSample &sample)
+  {
+    for (int i=0; i<QUDA_PERF_COUNTER_COUNT; i++) sample.value[i] = 0.0;
+  }
+
+} // namespace quda
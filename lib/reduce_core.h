@@ -446,13 +446,9 @@ public:
   virtual ~ReduceCuda() { }
 
   TuneKey tuneKey() const {
-    std::stringstream vol, aux;
-    vol << blasConstants.x[0] << "x";
-    vol << blasConstants.x[1] << "x";
-    vol << blasConstants.x[2] << "x";
-    vol << blasConstants.x[3];    
-    aux << "stride=" << blasConstants.stride << ",prec=" << arg.X.Precision();
-    return TuneKey(vol.str(), typeid(arg.r).name(), aux.str());
+    char aux[64];
+    snprintf(aux, sizeof(aux), "%s%d", blasConstants.aux, arg.X.Precision());
+    return TuneKey(blasConstants.vol, typeid(arg.r).name(), aux);
   }  
 
   void apply(const cudaStream_t &stream) {
@@ -500,6 +496,20 @@ public:
   half   short2  M = 3/3
  */
 
+/**
+   Adds the lifetime of a single-parity reduction, which ends when its
+   result has been summed over all processes, to blas_reduce_secs.
+ */
+struct ReduceTimer {
+  timeval start;
+  ReduceTimer() { gettimeofday(&start, NULL); }
+  ~ReduceTimer() {
+    timeval stop;
+    gettimeofday(&stop, NULL);
+    blas_reduce_secs += (stop.tv_sec - start.tv_sec) + 1e-6*(stop.tv_usec - start.tv_usec);
+  }
+};
+
 /**
    Driver for generic reduction routine with two loads.
    @param ReduceType 
@@ -523,6 +533,8 @@ doubleN reduceCuda(const double2 &a, const double2 &b, cudaColorSpinorField &x,
     return even + odd;
   }
 
+  ReduceTimer timer;
+
   checkSpinor(x, y);
   checkSpinor(x, z);
   checkSpinor(x, w);
@@ -535,8 +547,7 @@ doubleN reduceCuda(const double2 &a, const double2 &b, cudaColorSpinorField &x,
     return value;
   }
 
-  for (int d=0; d<QUDA_MAX_DIM; d++) blasConstants.x[d] = x.X()[d];
-  blasConstants.stride = x.Stride();
+  setBlasConstants(x);
 
   int reduce_length = siteUnroll ? x.RealLength() : x.Length();
   doubleN value;
@@ -28,8 +28,28 @@
 static struct {
   int x[QUDA_MAX_DIM];
   int stride;
+  char vol[64]; // tuneKey() strings
+  char aux[64];
 } blasConstants;
 
+/**
+   Record the field geometry used by the kernels.  The volume and aux
+   strings used by tuneKey() are only rebuilt when the geometry
+   changes, rather than on every launch.
+*/
+static void setBlasConstants(const cudaColorSpinorField &x)
+{
+  bool changed = (blasConstants.stride != x.Stride());
+  for (int d=0; d<QUDA_MAX_DIM; d++) changed = changed || (blasConstants.x[d] != x.X()[d]);
+  if (!changed) return;
+
+  for (int d=0; d<QUDA_MAX_DIM; d++) blasConstants.x[d] = x.X()[d];
+  blasConstants.stride = x.Stride();
+  snprintf(blasConstants.vol, sizeof(blasConstants.vol), "%dx%dx%dx%d",
+	   blasConstants.x[0], blasConstants.x[1], blasConstants.x[2], blasConstants.x[3]);
+  snprintf(blasConstants.aux, sizeof(blasConstants.aux), "stride=%d,prec=", blasConstants.stride);
+}
+
 // These are used for reduction kernels
 static QudaSumFloat *d_reduce=0;
 static QudaSumFloat *h_reduce=0;
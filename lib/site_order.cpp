@@ -0,0 +1,107 @@
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+
+#include <quda_internal.h>
+#include <site_order_quda.h>
+
+namespace quda {
+
+  namespace {
+
+    // interleave the low 16 bits of the four coordinates, x in the lowest bit
+    inline unsigned long long mortonKey(const int x[4]) {
+      unsigned long long key = 0;
+      for (int b=0; b<16; b++)
+	for (int d=0; d<4; d++)
+	  key |= (unsigned long long)((x[d] >> b) & 1) << (4*b + d);
+      return key;
+    }
+
+    // coordinates of checkerboard index cb of the given parity
+    inline void coords(int x[4], int cb, int parity, const int X[4]) {
+      int za = cb / (X[0]/2);
+      int x0h = cb - za*(X[0]/2);
+      int zb = za / X[1];
+      x[1] = za - zb*X[1];
+      x[3] = zb / X[2];
+      x[2] = zb - x[3]*X[2];
+      x[0] = 2*x0h + ((x[1] + x[2] + x[3] + parity) & 1);
+    }
+
+    inline int checkerboardIndex(const int x[4], const int X[4]) {
+      return (((x[3]*X[2] + x[2])*X[1] + x[1])*X[0] + x[0]) >> 1;
+    }
+
+    std::vector<MortonSiteOrder*> tables;
+    pthread_mutex_t table_lock = PTHREAD_MUTEX_INITIALIZER;
+
+  } // anonymous namespace
+
+  MortonSiteOrder::MortonSiteOrder(const int *X_) {
+    // with an odd extent the neighbour across the boundary would have
+    // the same parity, so the neighbour tables require even extents
+    for (int d=0; d<4; d++) {
+      X[d] = X_[d];
+      if (X[d] <= 0 || X[d] > 65536) errorQuda("Dimension %d = %d not supported", d, X[d]);
+      if (X[d] % 2) errorQuda("Dimension %d = %d must be even", d, X[d]);
+    }
+    volumeCB = X[0]*X[1]*X[2]*X[3]/2;
+
+    for (int parity=0; parity<2; parity++) {
+      std::vector<std::pair<unsigned long long,int> > key(volumeCB);
+      for (int cb=0; cb<volumeCB; cb++) {
+	int x[4];
+	coords(x, cb, parity, X);
+	key[cb] = std::make_pair(mortonKey(x), cb);
+      }
+      std::sort(key.begin(), key.end());
+
+      toCurve[parity].resize(volumeCB);
+      fromCurve[parity].resize(volumeCB);
+      for (int i=0; i<volumeCB; i++) {
+	fromCurve[parity][i] = key[i].second;
+	toCurve[parity][key[i].second] = i;
+      }
+    }
+
+    for (int parity=0; parity<2; parity++) {
+      neighbour[parity].resize(8*volumeCB);
+      const int *to = &toCurve[1-parity][0];
+      for (int i=0; i<volumeCB; i++) {
+	int x[4];
+	coords(x, fromCurve[parity][i], parity, X);
+	for (int mu=0; mu<4; mu++) {
+	  int y[4] = { x[0], x[1], x[2], x[3] };
+	  y[mu] = (x[mu] + 1) % X[mu];
+	  neighbour[parity][8*i + 2*mu + 0] = to[checkerboardIndex(y, X)];
+	  y[mu] = (x[mu] - 1 + X[mu]) % X[mu];
+	  neighbour[parity][8*i + 2*mu + 1] = to[checkerboardIndex(y, X)];
+	}
+      }
+    }
+  }
+
+  const MortonSiteOrder& mortonSiteOrder(const int *X) {
+    pthread_mutex_lock(&table_lock);
+    MortonSiteOrder *table = 0;
+    for (unsigned int i=0; i<tables.size() && !table; i++) {
+      const int *Y = tables[i]->Dims();
+      if (X[0] == Y[0] && X[1] == Y[1] && X[2] == Y[2] && X[3] == Y[3]) table = tables[i];
+    }
+    if (!table) {
+      table = new MortonSiteOrder(X);
+      tables.push_back(table);
+    }
+    pthread_mutex_unlock(&table_lock);
+    return *table;
+  }
+
+  void freeSiteOrderTables() {
+    pthread_mutex_lock(&table_lock);
+    for (unsigned int i=0; i<tables.size(); i++) delete tables[i];
+    tables.clear();
+    pthread_mutex_unlock(&table_lock);
+  }
+
+} // namespace quda
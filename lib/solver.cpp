@@ -1,6 +1,10 @@
 #include <quda_internal.h>
 #include <invert_quda.h>
+#include <blas_quda.h>
+#include <comm_quda.h>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 namespace quda {
 
@@ -80,4 +84,112 @@ namespace quda {
     }
   }
 
+  static FILE *telemetry_stream = NULL;
+  static bool telemetry_stream_init = false;
+  static int telemetry_solves = 0;
+
+  static double wallTime()
+  {
+    timeval t;
+    gettimeofday(&t, NULL);
+    return t.tv_sec + 1e-6*t.tv_usec;
+  }
+
+  // open the QUDA_SOLVER_TELEMETRY file on the first solve (rank 0 only)
+  static FILE *telemetryStream()
+  {
+    if (!telemetry_stream_init) {
+      telemetry_stream_init = true;
+      char *path = getenv("QUDA_SOLVER_TELEMETRY");
+      if (path && comm_rank() == 0) {
+	telemetry_stream = fopen(path, "w");
+	if (!telemetry_stream) {
+	  warningQuda("Unable to open solver telemetry file %s", path);
+	} else {
+	  fprintf(telemetry_stream, "# solve\tsolver\titer\tresidual\tresidual_hq\treliable\tprecision"
+		  "\tprecision_switch\tsecs\tmatvec_secs\treduction_secs\n");
+	}
+      }
+    }
+    return telemetry_stream;
+  }
+
+  // every rank records when streaming, so that the synchronization is the same everywhere
+  static bool telemetryRequested()
+  {
+    telemetryStream();
+    return getenv("QUDA_SOLVER_TELEMETRY") != NULL;
+  }
+
+  SolverTelemetry::SolverTelemetry(SolverParam &param, const char *name)
+    : param(param), name(name),
+      active(param.inv_type_precondition != QUDA_GCR_INVERTER && // not an inner solve
+	     ((param.telemetry && param.telemetry_size > 0) || telemetryRequested())),
+      solve(0), last_precision(QUDA_INVALID_PRECISION), iteration_start(0.0), matvec_start(0.0),
+      matvec_secs(0.0), reduce_start(0.0)
+  {
+    if (!active) return;
+    solve = telemetry_solves++;
+    iteration_start = wallTime();
+    reduce_start = blas_reduce_secs;
+  }
+
+  SolverTelemetry::~SolverTelemetry()
+  {
+    if (active && telemetry_stream) fflush(telemetry_stream);
+  }
+
+  // synchronize so that the operator time is not charged to the next reduction
+  void SolverTelemetry::StartMatvec()
+  {
+    cudaDeviceSynchronize();
+    matvec_start = wallTime();
+  }
+
+  void SolverTelemetry::StopMatvec()
+  {
+    cudaDeviceSynchronize();
+    matvec_secs += wallTime() - matvec_start;
+  }
+
+  void SolverTelemetry::RecordIteration(int k, double r2, double b2, double hq, bool reliable,
+					QudaPrecision precision)
+  {
+    const double now = wallTime();
+
+    QudaSolverTelemetry record;
+    record.iter = k;
+    record.residual = b2 > 0.0 ? sqrt(r2/b2) : 0.0;
+    record.residual_hq = hq;
+    record.reliable_update = reliable ? 1 : 0;
+    record.precision_switch = (last_precision != QUDA_INVALID_PRECISION && precision != last_precision) ? 1 : 0;
+    record.precision = precision;
+    record.secs = now - iteration_start;
+    record.matvec_secs = matvec_secs;
+    record.reduction_secs = blas_reduce_secs - reduce_start;
+
+    if (param.telemetry && param.telemetry_count < param.telemetry_size) {
+      param.telemetry[param.telemetry_count] = record;
+    }
+    param.telemetry_count++;
+
+    if (telemetry_stream) {
+      fprintf(telemetry_stream, "%d\t%s\t%d\t%e\t%e\t%d\t%d\t%d\t%e\t%e\t%e\n", solve, name, record.iter,
+	      record.residual, record.residual_hq, record.reliable_update, (int)record.precision,
+	      record.precision_switch, record.secs, record.matvec_secs, record.reduction_secs);
+    }
+
+    last_precision = precision;
+    iteration_start = now;
+    matvec_secs = 0.0;
+    reduce_start = blas_reduce_secs;
+  }
+
+  void closeSolverTelemetry()
+  {
+    if (telemetry_stream) fclose(telemetry_stream);
+    telemetry_stream = NULL;
+    telemetry_stream_init = false;
+  }
+
 } // namespace quda
@@ -1,4 +1,13 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <vector>
+
 #include <quda_internal.h>
+#include <comm_quda.h>
+#include <perf_counter_quda.h>
 
 namespace quda {
 
@@ -41,5 +50,288 @@ namespace quda {
 				       "comms", "comms start", "comms query", "constant", 
 				       "total" };
   
-}
 
+
+  /**
+   * Hierarchical tracing.  Each thread records its own timeline: a
+   * stack of open scopes, the list of completed scopes (the events
+   * written to the Chrome trace) and a tree of scope paths with
+   * aggregated counts, times and, if QUDA_PERF_COUNTERS is set,
+   * hardware counter values (the summary).  Threads only touch
+   * their own record, so the lock is only taken when a thread first
+   * traces and when the results are written.
+   */
+  bool traceEnabled = false;
+
+  namespace {
+
+    struct TraceNode {
+      std::string name;
+      int parent;
+      std::vector<int> children;
+      long count;
+      double time; // inclusive time
+      PerfSample counters; // inclusive counter values
+    };
+
+    struct TraceOpen {
+      const char *name;
+      int node;
+      double start;
+      PerfSample counters;
+    };
+
+    struct TraceEvent {
+      int node;
+      double start;
+      double end;
+    };
+
+    struct ThreadTrace {
+      int tid;
+      std::vector<TraceNode> nodes; // node 0 is the root
+      std::vector<TraceOpen> stack;
+      std::vector<TraceEvent> events;
+      bool truncated;
+    };
+
+    std::string trace_prefix;
+    size_t trace_max_events = 1000000; // per thread
+    double trace_t0 = 0.0;
+
+    std::vector<ThreadTrace*> trace_threads;
+    pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+    __thread ThreadTrace *local_trace = NULL;
+
+    double traceTime()
+    {
+      timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      return ts.tv_sec + 1e-9*ts.tv_nsec;
+    }
+
+    ThreadTrace &threadTrace()
+    {
+      if (!local_trace) {
+	local_trace = new ThreadTrace;
+	TraceNode root;
+	root.parent = -1;
+	root.count = 0;
+	root.time = 0.0;
+	perfClear(root.counters);
+	local_trace->nodes.push_back(root);
+	local_trace->truncated = false;
+
+	pthread_mutex_lock(&trace_lock);
+	local_trace->tid = trace_threads.size();
+	trace_threads.push_back(local_trace);
+	pthread_mutex_unlock(&trace_lock);
+      }
+      return *local_trace;
+    }
+
+    // close the scope at position i of the stack
+    void closeScope(ThreadTrace &t, size_t i, double end, const PerfSample &counters)
+    {
+      TraceNode &node = t.nodes[t.stack[i].node];
+      node.count++;
+      node.time += end - t.stack[i].start;
+      if (perfEnabled) perfAccumulate(node.counters, t.stack[i].counters, counters);
+
+      if (t.events.size() < trace_max_events) {
+	TraceEvent e;
+	e.node = t.stack[i].node;
+	e.start = t.stack[i].start;
+	e.end = end;
+	t.events.push_back(e);
+      } else {
+	t.truncated = true;
+      }
+
+      t.stack.erase(t.stack.begin() + i);
+    }
+
+    void jsonString(FILE *fp, const std::string &str)
+    {
+      fputc('"', fp);
+      for (size_t i=0; i<str.size(); i++) {
+	if (str[i] == '"' || str[i] == '\\') fputc('\\', fp);
+	fputc(str[i], fp);
+      }
+      fputc('"', fp);
+    }
+
+    std::string tracePath(const ThreadTrace &t, int node)
+    {
+      std::string path = t.nodes[node].name;
+      for (int p = t.nodes[node].parent; p > 0; p = t.nodes[p].parent) path = t.nodes[p].name + "/" + path;
+      return path;
+    }
+
+    void writeSummary(FILE *fp, const ThreadTrace &t, int node, int depth)
+    {
+      const TraceNode &n = t.nodes[node];
+      if (node > 0) {
+	double self = n.time;
+	for (size_t c=0; c<n.children.size(); c++) self -= t.nodes[n.children[c]].time;
+	fprintf(fp, "%d\t%d\t%s\t%ld\t%.9f\t%.9f\t%.3f", t.tid, depth, tracePath(t, node).c_str(),
+		n.count, n.time, self, n.count ? 1e6*n.time/n.count : 0.0);
+	if (perfEnabled) {
+	  const double *c = n.counters.value;
+	  fprintf(fp, "\t%.0f\t%.0f\t%.3f\t%.0f\t%.3f", c[QUDA_PERF_CYCLES], c[QUDA_PERF_INSTRUCTIONS],
+		  c[QUDA_PERF_CYCLES] > 0 ? c[QUDA_PERF_INSTRUCTIONS] / c[QUDA_PERF_CYCLES] : 0.0,
+		  c[QUDA_PERF_LLC_READ_MISSES] + c[QUDA_PERF_LLC_WRITE_MISSES],
+		  n.time > 0 ? 1e-9 * perfMemoryBytes(n.counters) / n.time : 0.0);
+	  if (perfCounterAvailable(QUDA_PERF_FLOPS)) fprintf(fp, "\t%.3f", n.time > 0 ? 1e-9 * c[QUDA_PERF_FLOPS] / n.time : 0.0);
+	  else fprintf(fp, "\t-");
+	}
+	fprintf(fp, "\n");
+      }
+      for (size_t c=0; c<n.children.size(); c++) writeSummary(fp, t, n.children[c], depth+1);
+    }
+
+  } // anonymous namespace
+
+
+  void traceInit()
+  {
+    char *prefix = getenv("QUDA_PROFILE_TRACE");
+    if (!prefix || traceEnabled) return;
+    trace_prefix = prefix;
+
+    char *max_events = getenv("QUDA_PROFILE_TRACE_MAX_EVENTS");
+    if (max_events) trace_max_events = strtoul(max_events, NULL, 10);
+
+    trace_t0 = traceTime();
+    traceEnabled = true;
+  }
+
+
+  void traceBegin(const char *name)
+  {
+    ThreadTrace &t = threadTrace();
+    int parent = t.stack.empty() ? 0 : t.stack.back().node;
+
+    int node = -1;
+    const std::vector<int> &children = t.nodes[parent].children;
+    for (size_t c=0; c<children.size(); c++) {
+      if (strcmp(t.nodes[children[c]].name.c_str(), name) == 0) { node = children[c]; break; }
+    }
+
+    if (node < 0) {
+      TraceNode n;
+      n.name = name;
+      n.parent = parent;
+      n.count = 0;
+      n.time = 0.0;
+      perfClear(n.counters);
+      node = t.nodes.size();
+      t.nodes.push_back(n);
+      t.nodes[parent].children.push_back(node);
+    }
+
+    TraceOpen open;
+    open.name = name;
+    open.node = node;
+    perfCountersRead(open.counters);
+    open.start = traceTime();
+    t.stack.push_back(open);
+  }
+
+
+  void traceEnd(const char *name)
+  {
+    double end = traceTime();
+    PerfSample counters;
+    perfCountersRead(counters);
+    ThreadTrace &t = threadTrace();
+
+    // match the innermost open scope of this name; scopes that were
+    // opened before tracing was enabled are simply not found
+    for (size_t i=t.stack.size(); i>0; i--) {
+      if (t.stack[i-1].name == name || strcmp(t.nodes[t.stack[i-1].node].name.c_str(), name) == 0) {
+	closeScope(t, i-1, end, counters);
+	return;
+      }
+    }
+  }
+
+
+  void traceFinalize()
+  {
+    if (!traceEnabled) return;
+    traceEnabled = false;
+
+    double end = traceTime();
+    PerfSample counters;
+    perfCountersRead(counters);
+    int rank = comm_rank();
+
+    pthread_mutex_lock(&trace_lock);
+
+    // close anything still open, e.g., endQuda itself
+    for (size_t i=0; i<trace_threads.size(); i++) {
+      ThreadTrace &t = *trace_threads[i];
+      while (!t.stack.empty()) {
+	// counters are per thread, so we only have end values for our own scopes
+	const PerfSample &c = (&t == local_trace) ? counters : t.stack.back().counters;
+	closeScope(t, t.stack.size()-1, end, c);
+      }
+    }
+
+    char name[1024];
+    snprintf(name, sizeof(name), "%s.%d.json", trace_prefix.c_str(), rank);
+    FILE *fp = fopen(name, "w");
+    if (!fp) {
+      warningQuda("Unable to open trace file %s", name);
+    } else {
+      fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+      fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"rank %d\"}}",
+	      rank, rank);
+      for (size_t i=0; i<trace_threads.size(); i++) {
+	const ThreadTrace &t = *trace_threads[i];
+	fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+		rank, t.tid, t.tid);
+	for (size_t e=0; e<t.events.size(); e++) {
+	  fprintf(fp, ",\n{\"name\":");
+	  jsonString(fp, t.nodes[t.events[e].node].name);
+	  fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+		  1e6*(t.events[e].start - trace_t0), 1e6*(t.events[e].end - t.events[e].start), rank, t.tid);
+	}
+	if (t.truncated) warningQuda("Trace of thread %d truncated after %lu events (QUDA_PROFILE_TRACE_MAX_EVENTS)",
+				     t.tid, (unsigned long)trace_max_events);
+      }
+      fprintf(fp, "\n]}\n");
+      fclose(fp);
+    }
+
+    snprintf(name, sizeof(name), "%s.%d.tsv", trace_prefix.c_str(), rank);
+    fp = fopen(name, "w");
+    if (!fp) {
+      warningQuda("Unable to open trace summary file %s", name);
+    } else {
+      fprintf(fp, "thread\tdepth\tscope\tcount\ttotal(s)\tself(s)\tmean(us)");
+      if (perfEnabled) fprintf(fp, "\tcycles\tinstructions\tIPC\tLLC misses\tGB/s\tGFLOP/s");
+      fprintf(fp, "\n");
+      for (size_t i=0; i<trace_threads.size(); i++) writeSummary(fp, *trace_threads[i], 0, 0);
+      fclose(fp);
+    }
+
+    // the per-thread records are retained (other threads hold pointers
+    // to them) but emptied so that a subsequent initQuda starts afresh
+    for (size_t i=0; i<trace_threads.size(); i++) {
+      ThreadTrace &t = *trace_threads[i];
+      t.nodes.resize(1);
+      t.nodes[0].children.clear();
+      t.stack.clear();
+      t.events.clear();
+      t.truncated = false;
+    }
+
+    pthread_mutex_unlock(&trace_lock);
+
+    printfQuda("Wrote trace to %s.<rank>.json and summary to %s.<rank>.tsv\n",
+	       trace_prefix.c_str(), trace_prefix.c_str());
+  }
+
+}
@@ -2,20 +2,40 @@
 #include <comm_quda.h>
 #include <quda.h> // for QUDA_VERSION_STRING
 #include <sys/stat.h> // for stat()
-#include <fcntl.h>
 #include <cfloat> // for FLT_MAX
 #include <ctime>
 #include <fstream>
 #include <typeinfo>
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 #include <unistd.h>
+#include <pthread.h>
+#if __cplusplus >= 201103L
+#include <unordered_map>
+#else
+#include <tr1/unordered_map>
+#endif
 
 namespace quda {
 
 static const std::string quda_hash = QUDA_HASH; // defined in lib/Makefile
 static std::string resource_path;
-static std::map<TuneKey, TuneParam> tunecache;
-static size_t initial_cache_size = 0;
+
+struct TuneKeyHash {
+  size_t operator()(const TuneKey &key) const { return static_cast<size_t>(key.hash); }
+};
+
+// the hash map guarantees that references to entries remain valid as the cache grows, which the
+// memoized pointer in Tunable relies upon (entries are never erased)
+#if __cplusplus >= 201103L
+typedef std::unordered_map<TuneKey, TuneParam, TuneKeyHash> TuneCache;
+#else
+typedef std::tr1::unordered_map<TuneKey, TuneParam, TuneKeyHash> TuneCache;
+#endif
+static TuneCache tunecache;
+static std::vector<TuneKey> tuned_keys; // entries tuned since the last save
 
 #define STR_(x) #x
 #define STR(x) STR_(x)
@@ -23,10 +43,51 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
 #undef STR
 #undef STR_
 
+  const char *getTuneBackendString(QudaTuneBackend backend)
+  {
+    switch (backend) {
+    case QUDA_TUNE_BACKEND_CUDA: return "cuda";
+    case QUDA_TUNE_BACKEND_CPU: return "cpu";
+    default: errorQuda("Unknown tune backend %d", backend);
+    }
+    return NULL;
+  }
+
+
+  int hostThreadCount()
+  {
+    static int count = 0;
+    if (!count) {
+      char *env = getenv("QUDA_HOST_THREADS");
+      count = env ? atoi(env) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+      if (count < 1) count = 1;
+    }
+    return count;
+  }
+
+
+  /**
+   * Add an entry to a cache.  If the key is already present, the entry with the faster recorded
+   * time wins; entries without a recorded time (negative) lose to those with one.  Existing entries
+   * are assigned to rather than replaced, so memoized pointers into the cache stay valid.
+   */
+  static void mergeTuneParam(TuneCache &cache, const TuneKey &key, const TuneParam &param)
+  {
+    TuneCache::iterator entry = cache.find(key);
+    if (entry == cache.end()) {
+      cache[key] = param;
+    } else if (param.time >= 0 && (entry->second.time < 0 || param.time < entry->second.time)) {
+      entry->second = param;
+    }
+  }
+
+
   /**
    * Deserialize tunecache from an istream, useful for reading a file or receiving from other nodes.
+   * Caches written before host tuning was introduced lack the backend, host-parameter and time
+   * columns; these are read with legacy=true and treated as untimed CUDA entries.
    */
-  static void deserializeTuneCache(std::istream &in)
+  static void deserializeTuneCache(std::istream &in, TuneCache &cache, bool legacy=false)
   {
     std::string line;
     std::stringstream ls;
@@ -38,31 +99,46 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
       if (!line.length()) continue; // skip blank lines (e.g., at end of file)
       ls.clear();
       ls.str(line);
+      if (legacy) key.backend = getTuneBackendString(QUDA_TUNE_BACKEND_CUDA);
+      else ls >> key.backend;
       ls >> key.volume >> key.name >> key.aux >> param.block.x >> param.block.y >> param.block.z;
       ls >> param.grid.x >> param.grid.y >> param.grid.z >> param.shared_bytes;
+      if (!legacy) ls >> param.threads >> param.tile.x >> param.tile.y >> param.tile.z >> param.simd >> param.time;
+      else param.time = -1;
       ls.ignore(1); // throw away tab before comment
       getline(ls, param.comment); // assume anything remaining on the line is a comment
       param.comment += "\n"; // our convention is to include the newline, since ctime() likes to do this
-      tunecache[key] = param;
+      key.rehash();
+      mergeTuneParam(cache, key, param);
     }
   }
 
 
+  static void serializeTuneParam(std::ostream &out, const TuneKey &key, const TuneParam &param)
+  {
+    out << key.backend << "\t" << key.volume << "\t" << key.name << "\t" << key.aux << "\t";
+    out << param.block.x << "\t" << param.block.y << "\t" << param.block.z << "\t";
+    out << param.grid.x << "\t" << param.grid.y << "\t" << param.grid.z << "\t";
+    out << param.shared_bytes << "\t";
+    out << param.threads << "\t" << param.tile.x << "\t" << param.tile.y << "\t" << param.tile.z << "\t";
+    out << param.simd << "\t" << param.time << "\t" << param.comment; // param.comment ends with a newline
+  }
+
+
   /**
    * Serialize tunecache to an ostream, useful for writing to a file or sending to other nodes.
    */
-  static void serializeTuneCache(std::ostream &out)
+  static void serializeTuneCache(std::ostream &out, const TuneCache &cache)
   {
-    std::map<TuneKey, TuneParam>::iterator entry;
-
-    for (entry = tunecache.begin(); entry != tunecache.end(); entry++) {
-      TuneKey key = entry->first;
-      TuneParam param = entry->second;
+    // write the entries in key order so that the file is stable from one run to the next
+    std::map<TuneKey, const TuneParam*> sorted;
+    for (TuneCache::const_iterator entry = cache.begin(); entry != cache.end(); entry++) {
+      sorted[entry->first] = &entry->second;
+    }
 
-      out << key.volume << "\t" << key.name << "\t" << key.aux << "\t";
-      out << param.block.x << "\t" << param.block.y << "\t" << param.block.z << "\t";
-      out << param.grid.x << "\t" << param.grid.y << "\t" << param.grid.z << "\t";
-      out << param.shared_bytes << "\t" << param.comment; // param.comment ends with a newline
+    std::map<TuneKey, const TuneParam*>::iterator entry;
+    for (entry = sorted.begin(); entry != sorted.end(); entry++) {
+      serializeTuneParam(out, entry->first, *entry->second);
     }
   }
 
@@ -78,7 +154,7 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
     size_t size;
 
     if (comm_rank() == 0) {
-      serializeTuneCache(serialized);
+      serializeTuneCache(serialized, tunecache);
       size = serialized.str().length();
     }
     comm_broadcast(&size, sizeof(size_t));
@@ -91,7 +167,7 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
 	comm_broadcast(serstr, size);
 	serstr[size] ='\0'; // null-terminate
 	serialized.str(serstr);
-	deserializeTuneCache(serialized);
+	deserializeTuneCache(serialized, tunecache);
 	delete[] serstr;
       }
     }
@@ -99,6 +175,95 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
   }
 
 
+  /**
+   * Gather the entries tuned since the last save on every node and merge them into each node's
+   * tunecache, keeping the fastest parameters for each key.  Returns the total number of entries
+   * contributed, which is the same on all nodes.
+   */
+  static int gatherTuneCache()
+  {
+    std::stringstream serialized;
+    for (size_t i=0; i<tuned_keys.size(); i++) {
+      serializeTuneParam(serialized, tuned_keys[i], tunecache[tuned_keys[i]]);
+    }
+    int count = tuned_keys.size();
+    tuned_keys.clear();
+
+#ifdef MULTI_GPU
+    comm_allreduce_int(&count);
+    if (count == 0) return 0;
+
+    const std::string local = serialized.str();
+    size_t size = local.length();
+    size_t *sizes = new size_t[comm_size()];
+    comm_allgather(sizes, &size, sizeof(size_t));
+
+    size_t max_size = 0;
+    for (int r=0; r<comm_size(); r++) max_size = sizes[r] > max_size ? sizes[r] : max_size;
+
+    char *send = new char[max_size];
+    char *recv = new char[max_size * comm_size()];
+    memset(send, 0, max_size);
+    memcpy(send, local.c_str(), size);
+    comm_allgather(recv, send, max_size);
+
+    for (int r=0; r<comm_size(); r++) {
+      if (r == comm_rank() || sizes[r] == 0) continue;
+      std::stringstream remote(std::string(recv + r*max_size, sizes[r]));
+      deserializeTuneCache(remote, tunecache);
+    }
+
+    delete []recv;
+    delete []send;
+    delete []sizes;
+#endif
+
+    return count;
+  }
+
+
+  /**
+   * Read a cache file, merging its entries into the given cache.  Returns false if the file does not
+   * exist.  A file written by a different version of QUDA is an error if fatal is set; otherwise it
+   * is ignored with a warning.
+   */
+  static bool readTuneCacheFile(const std::string &cache_path, TuneCache &cache, bool fatal)
+  {
+    std::string line, token;
+    std::ifstream cache_file;
+    std::stringstream ls;
+
+    cache_file.open(cache_path.c_str());
+    if (!cache_file) return false;
+
+    if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
+    getline(cache_file, line);
+    ls.str(line);
+    ls >> token;
+    if (token.compare("tunecache")) errorQuda("Bad format in %s", cache_path.c_str());
+    ls >> token;
+    if (token.compare(quda_version)) {
+      if (fatal) errorQuda("Cache file %s does not match current QUDA version", cache_path.c_str());
+      warningQuda("Cache file %s does not match current QUDA version and will be overwritten", cache_path.c_str());
+      return false;
+    }
+    ls >> token;
+    if (token.compare(quda_hash) && fatal) warningQuda("Cache file %s does not match current QUDA build", cache_path.c_str());
+
+    if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
+    getline(cache_file, line); // eat the blank line
+
+    if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
+    getline(cache_file, line); // the description line tells us which columns are present
+    bool legacy = (line.compare(0, 7, "volume\t") == 0);
+
+    deserializeTuneCache(cache_file, cache, legacy);
+    cache_file.close();
+
+    return true;
+  }
+
+
   /*
    * Read tunecache from disk.
    */
@@ -106,9 +271,6 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
   {
     char *path;
     struct stat pstat;
-    std::string cache_path, line, token;
-    std::ifstream cache_file;
-    std::stringstream ls;
 
     path = getenv("QUDA_RESOURCE_PATH");
     if (!path) {
@@ -127,36 +289,12 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
     if (comm_rank() == 0) {
 #endif
 
-      cache_path = resource_path;
-      cache_path += "/tunecache.tsv";
-      cache_file.open(cache_path.c_str());
-
-      if (cache_file) {
-
-	if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-	getline(cache_file, line);
-	ls.str(line);
-	ls >> token;
-	if (token.compare("tunecache")) errorQuda("Bad format in %s", cache_path.c_str());
-	ls >> token;
-	if (token.compare(quda_version)) errorQuda("Cache file %s does not match current QUDA version", cache_path.c_str());
-	ls >> token;
-	if (token.compare(quda_hash)) warningQuda("Cache file %s does not match current QUDA build", cache_path.c_str());
-      
-	if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-	getline(cache_file, line); // eat the blank line
-      
-	if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-	getline(cache_file, line); // eat the description line
-      
-	deserializeTuneCache(cache_file);
-	cache_file.close();      
-	initial_cache_size = tunecache.size();
+      std::string cache_path = resource_path + "/tunecache.tsv";
 
+      if (readTuneCacheFile(cache_path, tunecache, true)) {
 	if (verbosity >= QUDA_SUMMARIZE) {
-	  printfQuda("Loaded %d sets of cached parameters from %s\n", static_cast<int>(initial_cache_size), cache_path.c_str());
+	  printfQuda("Loaded %d sets of cached parameters from %s\n", static_cast<int>(tunecache.size()), cache_path.c_str());
 	}
-      
       } else {
 	warningQuda("Cache file not found.  All kernels will be re-tuned (if tuning is enabled).");
       }
@@ -170,66 +308,400 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
 
 
   /**
-   * Write tunecache to disk.
+   * Write tunecache to disk.  This must be called on all nodes.  Entries tuned on any node are first
+   * merged into node 0's cache, together with any entries written to the file by other jobs since it
+   * was loaded.  The file is then replaced atomically by writing a temporary file in the same
+   * directory and renaming it over the original, so no lock file is needed and readers never see a
+   * partially written cache.  (Entries written by another job between our read and our rename are
+   * lost; they will be re-tuned and merged the next time.)
    */
   void saveTuneCache(QudaVerbosity verbosity)
   {
     time_t now;
-    int lock_handle;
-    std::string lock_path, cache_path;
+    std::string cache_path, tmp_path;
     std::ofstream cache_file;
 
     if (resource_path.empty()) return;
 
-    //FIXME: We should really check to see if any nodes have tuned a kernel that was not also tuned on node 0, since as things
-    //       stand, the corresponding launch parameters would never get cached to disk in this situation.  This will come up if we
-    //       ever support different subvolumes per GPU (as might be convenient for lattice volumes that don't divide evenly).
+    if (gatherTuneCache() == 0) return;
 
 #ifdef MULTI_GPU
     if (comm_rank() == 0) {
 #endif
 
-      if (tunecache.size() == initial_cache_size) return;
+      cache_path = resource_path + "/tunecache.tsv";
+      readTuneCacheFile(cache_path, tunecache, false);
+
+      char host[256] = "";
+      gethostname(host, sizeof(host)-1);
+      std::stringstream tmp;
+      tmp << cache_path << ".tmp." << host << "." << getpid();
+      tmp_path = tmp.str();
 
-      // Acquire lock.  Note that this is only robust if the filesystem supports flock() semantics, which is true for
-      // NFS on recent versions of linux but not Lustre by default (unless the filesystem was mounted with "-o flock").
-      lock_path = resource_path + "/tunecache.lock";
-      lock_handle = open(lock_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
-      if (lock_handle == -1) {
-	warningQuda("Unable to lock cache file.  Tuned launch parameters will not be cached to disk.  "
-		    "If you are certain that no other instances of QUDA are accessing this filesystem, "
-		    "please manually remove %s", lock_path.c_str());
+      cache_file.open(tmp_path.c_str());
+      if (!cache_file) {
+	warningQuda("Unable to open %s.  Tuned launch parameters will not be cached to disk.", tmp_path.c_str());
 	return;
       }
-      char msg[] = "If no instances of applications using QUDA are running,\n"
-	"this lock file shouldn't be here and is safe to delete.";
-      int stat = write(lock_handle, msg, sizeof(msg)); // check status to avoid compiler warning
-      if (stat == -1) warningQuda("Unable to write to lock file for some bizarre reason");
 
-      cache_path = resource_path + "/tunecache.tsv";
-      cache_file.open(cache_path.c_str());
-    
       if (verbosity >= QUDA_SUMMARIZE) {
 	printfQuda("Saving %d sets of cached parameters to %s\n", static_cast<int>(tunecache.size()), cache_path.c_str());
       }
     
       time(&now);
       cache_file << "tunecache\t" << quda_version << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
-      cache_file << "volume\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\tcomment" << std::endl;
-      serializeTuneCache(cache_file);
+      cache_file << "backend\tvolume\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\t"
+		 << "threads\ttile.x\ttile.y\ttile.z\tsimd\ttime\tcomment" << std::endl;
+      serializeTuneCache(cache_file, tunecache);
       cache_file.close();
 
-      // Release lock.
-      close(lock_handle);
-      remove(lock_path.c_str());
-
-      initial_cache_size = tunecache.size();
+      if (cache_file.fail()) {
+	warningQuda("Error writing %s.  Tuned launch parameters will not be cached to disk.", tmp_path.c_str());
+	remove(tmp_path.c_str());
+      } else if (rename(tmp_path.c_str(), cache_path.c_str())) {
+	warningQuda("Unable to rename %s to %s.  Tuned launch parameters will not be cached to disk.",
+		    tmp_path.c_str(), cache_path.c_str());
+	remove(tmp_path.c_str());
+      }
 
 #ifdef MULTI_GPU
     }
 #endif
   }
 
+
+  static double hostTime()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9*ts.tv_nsec;
+  }
+
+
+  /**
+   * Time tunable.tuningIter() invocations of apply() with the currently active parameters,
+   * returning the time per call in seconds.  Device kernels are timed with CUDA events, host
+   * kernels with the monotonic host clock.  On failure, error describes what went wrong.
+   */
+  static bool host_timing = false; // don't profile host kernels while tuning them
+
+  static float timeTunable(Tunable &tunable, cudaEvent_t &start, cudaEvent_t &end, std::string &error)
+  {
+    float elapsed_time;
+    error.clear();
+
+    if (tunable.backend() == QUDA_TUNE_BACKEND_CPU) {
+      host_timing = true;
+      double t0 = hostTime();
+      for (int i=0; i<tunable.tuningIter(); i++) {
+	tunable.apply(0);  // calls tuneLaunch() again, which simply returns the currently active param
+      }
+      elapsed_time = hostTime() - t0;
+      host_timing = false;
+    } else {
+      cudaDeviceSynchronize();
+      cudaGetLastError(); // clear error counter
+      cudaEventRecord(start, 0);
+      for (int i=0; i<tunable.tuningIter(); i++) {
+	tunable.apply(0);  // calls tuneLaunch() again, which simply returns the currently active param
+      }
+      cudaEventRecord(end, 0);
+      cudaEventSynchronize(end);
+      cudaEventElapsedTime(&elapsed_time, start, end);
+      cudaDeviceSynchronize();
+      cudaError_t cuda_error = cudaGetLastError();
+      if (cuda_error != cudaSuccess) error = cudaGetErrorString(cuda_error);
+      elapsed_time /= 1e3;
+    }
+
+    return elapsed_time / tunable.tuningIter();
+  }
+
+
+  /**
+   * Search the parameter space of a Tunable for the fastest launch parameters.
+   *
+   * The candidates are first enumerated with initTuneParam()/advanceTuneParam().  Each field of
+   * TuneParam is then an axis of the space, and a candidate's coordinate on an axis is the rank of
+   * its value among all values taken on that axis.  Small spaces are searched exhaustively; larger
+   * ones coarse-to-fine: a coarse sub-lattice of about coarse_points candidates is measured first,
+   * and a pattern search (moving along one or two axes at a time, so that valleys running diagonally
+   * such as threads x tile are followed, and halving the step whenever no neighbour improves on the
+   * current centre) refines from the best refine_starts coarse candidates.
+   *
+   * Each candidate is timed up to QUDA_TUNE_REPEATS times (default 5) and scored by the trimmed
+   * mean, which rejects the outliers that would otherwise produce mis-tuned entries.  A candidate is
+   * abandoned as soon as its fastest sample (of at least two) is more than QUDA_TUNE_PRUNE (default 1.5) times slower
+   * than the best score so far (branch and bound).  Setting QUDA_TUNE_EXHAUSTIVE=1 disables the
+   * coarse-to-fine search.
+   */
+  class TuneSearch {
+
+    static const int naxis = 12;
+    static const int coarse_points = 32; // size of the coarse lattice
+    static const int refine_starts = 4;  // number of coarse candidates to refine from
+    static const int exhaustive_limit = 64; // search exhaustively below this many candidates
+    static const int max_candidates = 1<<20; // guard against runaway advanceTuneParam()
+
+    Tunable &tunable;
+    TuneParam &active; // the parameters returned by calls to tuneLaunch() from within apply()
+    const QudaVerbosity verbosity;
+    cudaEvent_t &start, &end;
+
+    std::vector<TuneParam> candidates;
+    std::vector<int> coord; // candidates.size() x naxis
+    std::vector<float> score; // trimmed-mean time, or FLT_MAX if failed or pruned
+    std::vector<bool> measured;
+    int extent[naxis]; // number of distinct values on each axis
+    int step[naxis];   // coarse lattice spacing on each axis
+    int best;
+    int nmeasured, npruned;
+
+    int repeats;
+    float prune;
+    bool exhaustive;
+
+    static void axes(const TuneParam &param, int *value)
+    {
+      value[0] = param.block.x; value[1] = param.block.y; value[2] = param.block.z;
+      value[3] = param.grid.x; value[4] = param.grid.y; value[5] = param.grid.z;
+      value[6] = param.shared_bytes; value[7] = param.threads;
+      value[8] = param.tile.x; value[9] = param.tile.y; value[10] = param.tile.z;
+      value[11] = param.simd;
+    }
+
+    void enumerate()
+    {
+      TuneParam param;
+      tunable.initTuneParam(param);
+      do {
+	candidates.push_back(param);
+	if (candidates.size() > (size_t)max_candidates)
+	  errorQuda("More than %d candidate launch parameters for %s", max_candidates, typeid(tunable).name());
+      } while (tunable.advanceTuneParam(param));
+
+      const int n = candidates.size();
+      std::vector<int> value(n*naxis);
+      for (int i=0; i<n; i++) axes(candidates[i], &value[i*naxis]);
+
+      coord.resize(n*naxis);
+      for (int a=0; a<naxis; a++) {
+	std::vector<int> distinct;
+	for (int i=0; i<n; i++) distinct.push_back(value[i*naxis+a]);
+	std::sort(distinct.begin(), distinct.end());
+	distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+	for (int i=0; i<n; i++) {
+	  coord[i*naxis+a] = std::lower_bound(distinct.begin(), distinct.end(), value[i*naxis+a]) - distinct.begin();
+	}
+	extent[a] = distinct.size();
+	step[a] = 1;
+      }
+
+      // coarsen the axis with the most lattice points until the coarse lattice fits the budget
+      while (true) {
+	int points = 1, widest = 0;
+	for (int a=0; a<naxis; a++) {
+	  int pa = (extent[a] + step[a] - 1) / step[a];
+	  points *= pa;
+	  if (pa > (extent[widest] + step[widest] - 1) / step[widest]) widest = a;
+	}
+	if (points <= coarse_points) break;
+	step[widest] *= 2;
+      }
+
+      score.assign(n, FLT_MAX);
+      measured.assign(n, false);
+    }
+
+    /** the mean of the samples after discarding the fastest and slowest fifth */
+    static float trimmedMean(std::vector<float> &sample)
+    {
+      std::sort(sample.begin(), sample.end());
+      const size_t trim = sample.size() / 5;
+      double sum = 0.0;
+      for (size_t i=trim; i<sample.size()-trim; i++) sum += sample[i];
+      return sum / (sample.size() - 2*trim);
+    }
+
+    void measure(int i)
+    {
+      if (measured[i]) return;
+      measured[i] = true;
+      nmeasured++;
+
+      active = candidates[i];
+      tunable.checkLaunchParam(active);
+
+      std::vector<float> sample;
+      std::string error;
+      float fastest = FLT_MAX;
+      for (int r=0; r<repeats; r++) {
+	float t = timeTunable(tunable, start, end, error);
+	if (!error.empty()) {
+	  if (verbosity >= QUDA_DEBUG_VERBOSE)
+	    printfQuda("    %s gives %s\n", tunable.paramString(active).c_str(), error.c_str());
+	  return;
+	}
+	sample.push_back(t);
+	if (t < fastest) fastest = t;
+	// two samples are required so that a single outlier cannot prune the best candidate
+	if (best >= 0 && prune > 0 && (r > 0 || repeats == 1) && fastest > prune * score[best]) {
+	  npruned++;
+	  if (verbosity >= QUDA_DEBUG_VERBOSE)
+	    printfQuda("    %s pruned after %d of %d at %s\n", tunable.paramString(active).c_str(),
+		       r+1, repeats, tunable.perfString(fastest).c_str());
+	  return;
+	}
+      }
+
+      score[i] = trimmedMean(sample);
+      if (best < 0 || score[i] < score[best]) best = i;
+      if (verbosity >= QUDA_DEBUG_VERBOSE)
+	printfQuda("    %s gives %s\n", tunable.paramString(active).c_str(), tunable.perfString(score[i]).c_str());
+    }
+
+    /** whether candidate i is displaced from centre by +/-s[a] along one or two axes a */
+    bool neighbour(int i, int centre, const int *s) const
+    {
+      int moved = 0;
+      for (int a=0; a<naxis; a++) {
+	int d = abs(coord[i*naxis+a] - coord[centre*naxis+a]);
+	if (d == 0) continue;
+	if (d != s[a] || ++moved > 2) return false;
+      }
+      return moved > 0;
+    }
+
+    void refine(int centre)
+    {
+      int s[naxis];
+      for (int a=0; a<naxis; a++) s[a] = step[a];
+
+      while (true) {
+	int next = centre;
+	for (int i=0; i<(int)candidates.size(); i++) {
+	  if (!neighbour(i, centre, s)) continue;
+	  measure(i);
+	  if (score[i] < score[next]) next = i;
+	}
+	if (next != centre) {
+	  centre = next;
+	  continue;
+	}
+
+	bool finest = true;
+	for (int a=0; a<naxis; a++) {
+	  if (s[a] > 1) finest = false;
+	  s[a] = (s[a] + 1) / 2;
+	}
+	if (finest) break;
+      }
+    }
+
+  public:
+    TuneSearch(Tunable &tunable, TuneParam &active, QudaVerbosity verbosity, cudaEvent_t &start, cudaEvent_t &end)
+      : tunable(tunable), active(active), verbosity(verbosity), start(start), end(end),
+	best(-1), nmeasured(0), npruned(0)
+    {
+      char *env = getenv("QUDA_TUNE_REPEATS");
+      repeats = env ? atoi(env) : 5;
+      if (repeats < 1) repeats = 1;
+      env = getenv("QUDA_TUNE_PRUNE");
+      prune = env ? atof(env) : 1.5;
+      env = getenv("QUDA_TUNE_EXHAUSTIVE");
+      exhaustive = env && strcmp(env, "0");
+    }
+
+    /** returns false if no candidate could be launched successfully */
+    bool run(TuneParam &best_param, float &best_time)
+    {
+      enumerate();
+      const int n = candidates.size();
+
+      // warm up (caches, clocks, lazy allocation) so the first candidate is not penalized
+      std::string error;
+      active = candidates[0];
+      tunable.checkLaunchParam(active);
+      timeTunable(tunable, start, end, error);
+
+      if (exhaustive || n <= exhaustive_limit) {
+	for (int i=0; i<n; i++) measure(i);
+      } else {
+	for (int i=0; i<n; i++) {
+	  bool coarse = true;
+	  for (int a=0; a<naxis; a++) if (coord[i*naxis+a] % step[a]) coarse = false;
+	  if (coarse) measure(i);
+	}
+
+	// refine from the best few coarse candidates
+	std::vector<std::pair<float,int> > coarse;
+	for (int i=0; i<n; i++) if (measured[i] && score[i] < FLT_MAX) coarse.push_back(std::make_pair(score[i], i));
+	std::sort(coarse.begin(), coarse.end());
+	for (int k=0; k<(int)coarse.size() && k<refine_starts; k++) refine(coarse[k].second);
+	if (best < 0) for (int i=0; i<n; i++) measure(i); // nothing on the coarse lattice worked
+      }
+
+      if (verbosity >= QUDA_DEBUG_VERBOSE)
+	printfQuda("Measured %d of %d candidates (%d pruned)\n", nmeasured, n, npruned);
+
+      if (best < 0) return false;
+      best_param = candidates[best];
+      best_time = score[best];
+      return true;
+    }
+
+  };
+
+
+  struct RooflineStats {
+    long calls;
+    long timed_calls; // launches whose tuned time is known
+    double flops;     // from Tunable::flops(), over the timed launches
+    double bytes;     // from Tunable::bytes(), over the timed launches
+    double time;      // sum of the tuned times
+  };
+
+#if __cplusplus >= 201103L
+  typedef std::unordered_map<TuneKey, RooflineStats, TuneKeyHash> RooflineMap;
+#else
+  typedef std::tr1::unordered_map<TuneKey, RooflineStats, TuneKeyHash> RooflineMap;
+#endif
+  static RooflineMap roofline_stats;
+
+  static bool rooflineEnabled()
+  {
+    static int enabled = -1;
+    if (enabled < 0) {
+      char *env = getenv("QUDA_ROOFLINE");
+      enabled = (env && strcmp(env, "0")) ? 1 : 0;
+    }
+    return enabled;
+  }
+
+  /**
+   * Account for one launch of a device kernel.  Timing each launch
+   * would require synchronization, so the time of a launch is taken to
+   * be that measured when the kernel was tuned.
+   */
+  static void recordLaunch(const TuneKey &key, const TuneParam &param, long long flops, long long bytes)
+  {
+    RooflineMap::iterator it = roofline_stats.find(key);
+    if (it == roofline_stats.end()) {
+      RooflineStats stats;
+      stats.calls = stats.timed_calls = 0;
+      stats.flops = stats.bytes = stats.time = 0.0;
+      it = roofline_stats.insert(std::make_pair(key, stats)).first;
+    }
+    RooflineStats &stats = it->second;
+    stats.calls++;
+    if (param.time > 0 && param.time < FLT_MAX) {
+      stats.timed_calls++;
+      stats.flops += flops;
+      stats.bytes += bytes;
+      stats.time += param.time;
+    }
+  }
+
   /**
    * Return the optimal launch parameters for a given kernel, either by retrieving them from tunecache or autotuning
    * on the spot.
@@ -245,63 +717,53 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
     static TuneParam param;
 
     TuneParam best_param;
-    cudaError_t error;
     cudaEvent_t start, end;
-    float elapsed_time, best_time;
+    float best_time;
     time_t now;
 
-    const TuneKey key = tunable.tuneKey();
+    TuneKey key = tunable.tuneKey();
+    const bool device = (tunable.backend() == QUDA_TUNE_BACKEND_CUDA);
+    if (!device) {
+      key.backend = getTuneBackendString(tunable.backend());
+      key.rehash();
+    }
+
+    TuneCache::const_iterator entry;
 
     if (enabled == QUDA_TUNE_NO) {
       tunable.defaultTuneParam(param);
       tunable.checkLaunchParam(param);
-    } else if (tunecache.count(key)) {
-      param = tunecache[key];
+    } else if (tunable.cached_param && tunable.cached_hash == key.hash) {
+      // same launch as last time: the entry has already been validated
+      if (device && rooflineEnabled()) recordLaunch(key, *tunable.cached_param, tunable.flops(), tunable.bytes());
+      globalReduce = reduceState;
+      return *tunable.cached_param;
+    } else if ((entry = tunecache.find(key)) != tunecache.end()) {
+      param = entry->second;
       tunable.checkLaunchParam(param);
+      tunable.cached_hash = key.hash;
+      tunable.cached_param = &entry->second;
     } else if (!tuning) {
 
       tuning = true;
       active_tunable = &tunable;
-      best_time = FLT_MAX;
 
       if (verbosity >= QUDA_DEBUG_VERBOSE) printfQuda("PreTune %s\n", key.name.c_str());
       tunable.preTune();
 
-      cudaEventCreate(&start);
-      cudaEventCreate(&end);
+      if (device) {
+	cudaEventCreate(&start);
+	cudaEventCreate(&end);
+      }
 
       if (verbosity >= QUDA_DEBUG_VERBOSE) {
-	printfQuda("Tuning %s with %s at vol=%s\n", key.name.c_str(), key.aux.c_str(), key.volume.c_str());
+	printfQuda("Tuning %s with %s at vol=%s on %s\n", key.name.c_str(), key.aux.c_str(), key.volume.c_str(),
+		   key.backend.c_str());
       }
 
-      tunable.initTuneParam(param);
-      while (tuning) {
-	cudaDeviceSynchronize();
-	cudaGetLastError(); // clear error counter
-	tunable.checkLaunchParam(param);
-	cudaEventRecord(start, 0);
-	for (int i=0; i<tunable.tuningIter(); i++) {
-	  tunable.apply(0);  // calls tuneLaunch() again, which simply returns the currently active param
-	}
-	cudaEventRecord(end, 0);
-	cudaEventSynchronize(end);
-	cudaEventElapsedTime(&elapsed_time, start, end);
-	cudaDeviceSynchronize();
-	error = cudaGetLastError();
-	elapsed_time /= (1e3 * tunable.tuningIter());
-	if ((elapsed_time < best_time) && (error == cudaSuccess)) {
-	  best_time = elapsed_time;
-	  best_param = param;
-	}
-	if ((verbosity >= QUDA_DEBUG_VERBOSE)) {
-	  if (error == cudaSuccess)
-	    printfQuda("    %s gives %s\n", tunable.paramString(param).c_str(), 
-		       tunable.perfString(elapsed_time).c_str());
-	  else 
-	    printfQuda("    %s gives %s\n", tunable.paramString(param).c_str(), cudaGetErrorString(error));
-	}
-	tuning = tunable.advanceTuneParam(param);
-      }
+      TuneSearch search(tunable, param, verbosity, start, end);
+      if (!search.run(best_param, best_time)) best_time = FLT_MAX;
+      tuning = false;
 
       if (best_time == FLT_MAX) {
 	errorQuda("Auto-tuning failed for %s with %s at vol=%s", key.name.c_str(), key.aux.c_str(), key.volume.c_str());
@@ -314,22 +776,193 @@ static const std::string quda_version = STR(QUDA_VERSION_MAJOR) "." STR(QUDA_VER
       best_param.comment = "# " + tunable.perfString(best_time) + ", tuned ";
       best_param.comment += ctime(&now); // includes a newline
 
-      cudaEventDestroy(start);
-      cudaEventDestroy(end);
+      if (device) {
+	cudaEventDestroy(start);
+	cudaEventDestroy(end);
+      }
 
       if (verbosity >= QUDA_DEBUG_VERBOSE) printfQuda("PostTune %s\n", key.name.c_str());
       tunable.postTune();
+      best_param.time = best_time;
       param = best_param;
       tunecache[key] = best_param;
+      tuned_keys.push_back(key);
 
     } else if (&tunable != active_tunable) {
       errorQuda("Unexpected call to tuneLaunch() in %s::apply()", typeid(tunable).name());
     }
 
+    if (device && !tuning && rooflineEnabled()) recordLaunch(key, param, tunable.flops(), tunable.bytes());
+
     // restore the original reduction state
     globalReduce = reduceState;
 
     return param;
   }
 
+
+  struct HostKernelStats {
+    long calls;
+    double time;
+    double flops; // from Tunable::flops()
+    double bytes; // from Tunable::bytes()
+    PerfSample counters;
+  };
+
+  static std::map<std::string, HostKernelStats> host_kernel_stats;
+  static pthread_mutex_t host_kernel_lock = PTHREAD_MUTEX_INITIALIZER;
+
+  HostKernelScope::HostKernelScope(const Tunable &tunable) : tunable(tunable), active(perfEnabled && !host_timing)
+  {
+    if (!active) return;
+    const TuneKey key = tunable.tuneKey();
+    name = key.name + " " + key.aux + " " + key.volume;
+    if (traceEnabled) traceBegin(name.c_str());
+    perfCountersReadPool(counters);
+    start = hostTime();
+  }
+
+  HostKernelScope::~HostKernelScope()
+  {
+    if (!active) return;
+    double end = hostTime();
+    PerfSample end_counters;
+    perfCountersReadPool(end_counters);
+    if (traceEnabled) traceEnd(name.c_str());
+
+    pthread_mutex_lock(&host_kernel_lock);
+    std::map<std::string, HostKernelStats>::iterator it = host_kernel_stats.find(name);
+    if (it == host_kernel_stats.end()) {
+      HostKernelStats stats;
+      stats.calls = 0;
+      stats.time = stats.flops = stats.bytes = 0.0;
+      perfClear(stats.counters);
+      it = host_kernel_stats.insert(std::make_pair(name, stats)).first;
+    }
+    HostKernelStats &stats = it->second;
+    stats.calls++;
+    stats.time += end - start;
+    stats.flops += tunable.flops();
+    stats.bytes += tunable.bytes();
+    perfAccumulate(stats.counters, counters, end_counters);
+    pthread_mutex_unlock(&host_kernel_lock);
+  }
+
+  /**
+   * For each host kernel, compare the achieved rates implied by the
+   * flops() and bytes() estimates with those measured by the counters.
+   * The measured traffic counts last-level cache misses on the calling
+   * thread, so a kernel that achieves close to the memory bandwidth of
+   * the node is bandwidth bound, and a measured arithmetic intensity
+   * (flops per byte) well above the machine balance means it is compute
+   * bound.
+   */
+  void printHostKernelProfile()
+  {
+    if (!perfEnabled || host_kernel_stats.empty()) return;
+
+    const bool have_cycles = perfCounterAvailable(QUDA_PERF_CYCLES) && perfCounterAvailable(QUDA_PERF_INSTRUCTIONS);
+    const bool have_bytes = perfCounterAvailable(QUDA_PERF_LLC_READ_MISSES) || perfCounterAvailable(QUDA_PERF_LLC_WRITE_MISSES);
+    const bool have_flops = perfCounterAvailable(QUDA_PERF_FLOPS);
+
+    printfQuda("\n   Host kernel profile (rank %d)\n", comm_rank());
+    for (std::map<std::string, HostKernelStats>::const_iterator it = host_kernel_stats.begin();
+	 it != host_kernel_stats.end(); ++it) {
+      const HostKernelStats &s = it->second;
+      const double *c = s.counters.value;
+      printfQuda("     %s\n", it->first.c_str());
+      printfQuda("       %ld calls, %f secs, estimated %.2f GFLOP/s %.2f GB/s\n", s.calls, s.time,
+		 1e-9*s.flops/s.time, 1e-9*s.bytes/s.time);
+
+      char measured[256];
+      int len = sprintf(measured, "       measured");
+      if (have_flops) len += sprintf(measured+len, " %.2f GFLOP/s", 1e-9*c[QUDA_PERF_FLOPS]/s.time);
+      else len += sprintf(measured+len, " n/a GFLOP/s");
+      if (have_bytes) len += sprintf(measured+len, " %.2f GB/s", 1e-9*perfMemoryBytes(s.counters)/s.time);
+      else len += sprintf(measured+len, " n/a GB/s");
+      if (have_flops && have_bytes && perfMemoryBytes(s.counters) > 0)
+	len += sprintf(measured+len, ", %.2f flop/byte", c[QUDA_PERF_FLOPS]/perfMemoryBytes(s.counters));
+      if (have_cycles && c[QUDA_PERF_CYCLES] > 0)
+	len += sprintf(measured+len, ", IPC %.2f", c[QUDA_PERF_INSTRUCTIONS]/c[QUDA_PERF_CYCLES]);
+      printfQuda("%s\n", measured);
+    }
+  }
+
+  /**
+   * Peak device bandwidth (GB/s) and single-precision throughput
+   * (GFLOP/s), from the device properties unless overridden by
+   * QUDA_PEAK_GBPS and QUDA_PEAK_GFLOPS.  The latter should be set when
+   * most of the work is done in double precision.
+   */
+  static void devicePeaks(double &gbytes, double &gflops)
+  {
+#if CUDART_VERSION >= 5000
+    gbytes = 2.0 * 1e-6*deviceProp.memoryClockRate * deviceProp.memoryBusWidth / 8; // double data rate
+#else
+    gbytes = 0.0;
+#endif
+    int cores; // single-precision cores per multiprocessor
+    switch (deviceProp.major) {
+    case 1: cores = 8; break;
+    case 2: cores = (deviceProp.minor == 0) ? 32 : 48; break;
+    case 3: cores = 192; break;
+    case 6: cores = (deviceProp.minor == 0) ? 64 : 128; break;
+    case 7: cores = 64; break;
+    case 8: cores = (deviceProp.minor == 0) ? 64 : 128; break;
+    default: cores = 128;
+    }
+    gflops = 2.0 * cores * deviceProp.multiProcessorCount * 1e-6*deviceProp.clockRate; // fused multiply-add
+
+    char *env;
+    if ((env = getenv("QUDA_PEAK_GBPS"))) gbytes = atof(env);
+    if ((env = getenv("QUDA_PEAK_GFLOPS"))) gflops = atof(env);
+  }
+
+  /**
+   * Place each device kernel launched in this run on the roofline of
+   * the device: its arithmetic intensity (flops per byte) bounds the
+   * attainable throughput by min(peak flops, intensity * peak
+   * bandwidth), and a kernel is memory bound when the bandwidth term is
+   * the smaller one.  Kernels are listed in decreasing order of total
+   * time.
+   */
+  void printRooflineProfile()
+  {
+    if (!rooflineEnabled() || roofline_stats.empty()) return;
+
+    double peak_gbytes, peak_gflops;
+    devicePeaks(peak_gbytes, peak_gflops);
+
+    std::vector<std::pair<double, const std::pair<const TuneKey, RooflineStats>*> > order;
+    for (RooflineMap::const_iterator it = roofline_stats.begin(); it != roofline_stats.end(); ++it) {
+      order.push_back(std::make_pair(-it->second.time, &*it));
+    }
+    std::sort(order.begin(), order.end());
+
+    printfQuda("\n   Roofline profile (rank %d, peak %.1f GB/s, %.1f GFLOP/s)\n", comm_rank(), peak_gbytes, peak_gflops);
+    printfQuda("     %8s %10s %9s %9s %7s %8s %6s  %s\n", "calls", "time(s)", "GFLOP/s", "GB/s", "flop/B",
+	       "%peakBW", "%roof", "kernel");
+    for (size_t i=0; i<order.size(); i++) {
+      const TuneKey &key = order[i].second->first;
+      const RooflineStats &s = order[i].second->second;
+      std::string name = key.name + " " + key.aux + " " + key.volume;
+      if (s.timed_calls == 0 || s.time <= 0.0) {
+	printfQuda("     %8ld %10s %9s %9s %7s %8s %6s  %s\n", s.calls, "n/a", "n/a", "n/a", "n/a", "n/a", "n/a", name.c_str());
+	continue;
+      }
+      // scale the timed launches up to all launches
+      const double time = s.time * s.calls / s.timed_calls;
+      const double gflops = 1e-9 * s.flops / s.time;
+      const double gbytes = 1e-9 * s.bytes / s.time;
+      const double intensity = s.bytes > 0 ? s.flops / s.bytes : 0.0;
+      double roof = intensity * peak_gbytes; // attainable GFLOP/s
+      if (roof > peak_gflops || s.bytes == 0) roof = peak_gflops;
+      const double bw_frac = peak_gbytes > 0 ? 100.0 * gbytes / peak_gbytes : 0.0;
+      // kernels without flops (copies) are measured against the bandwidth alone
+      const double roof_frac = s.flops > 0 ? (roof > 0 ? 100.0 * gflops / roof : 0.0) : bw_frac;
+      printfQuda("     %8ld %10.4f %9.2f %9.2f %7.2f %8.1f %6.1f  %s\n", s.calls, time, gflops, gbytes, intensity,
+		 bw_frac, roof_frac, name.c_str());
+    }
+  }
+
 } // namespace quda
@@ -633,7 +633,8 @@ static double HOST_REUNIT_SVD_ABS_ERROR;
       void preTune() { ; }
       void postTune() { cudaMemset(fails, 0, sizeof(int)); } // reset fails counter
       
-      long long flops() const { return 0; } // FIXME: add flops counter
+      long long flops() const { return 0; } // FIXME: add flops counter (the SVD fallback is data dependent)
+      long long bytes() const { return gauge.Bytes() + oldForce.Bytes() + newForce.Bytes(); }
       
       TuneKey tuneKey() const {
 	std::stringstream vol, aux;
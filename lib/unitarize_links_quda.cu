@@ -435,7 +435,8 @@ namespace {
     void preTune() { ; }
     void postTune() { cudaMemset(fails, 0, sizeof(int)); } // reset fails counter
     
-    long long flops() const { return 0; } // FIXME: add flops counter
+    long long flops() const { return 0; } // FIXME: add flops counter (the SVD fallback is data dependent)
+    long long bytes() const { return inField.Bytes() + outField.Bytes(); }
 
     TuneKey tuneKey() const {
       std::stringstream vol, aux;
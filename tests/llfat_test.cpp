@@ -29,6 +29,7 @@ extern QudaReconstructType link_recon;
 extern QudaPrecision prec;
 static QudaPrecision cpu_prec = QUDA_DOUBLE_PRECISION;
 static QudaGaugeFieldOrder gauge_order = QUDA_QDP_GAUGE_ORDER;
+static QudaFieldLocation fat_link_location = QUDA_CUDA_FIELD_LOCATION;
 
 static size_t gSize;
 
@@ -63,6 +64,7 @@ llfat_test(int test)
   qudaGaugeParam.gauge_order = gauge_order;
   qudaGaugeParam.type=QUDA_WILSON_LINKS;
   qudaGaugeParam.reconstruct = link_recon;
+  qudaGaugeParam.fat_link_location = fat_link_location;
   /*
      qudaGaugeParam.flag = QUDA_FAT_PRESERVE_CPU_GAUGE
      | QUDA_FAT_PRESERVE_GPU_GAUGE
@@ -193,7 +195,12 @@ llfat_test(int test)
   }
   void* longlink_ptr = longlink;
 #ifdef MULTI_GPU
-  if(!test) longlink_ptr = NULL; // Have to have an extended volume for the long-link calculation
+  // Have to have an extended volume for the long-link calculation,
+  // unless the host fattening exchanges the halo itself
+  const bool long_links = test || fat_link_location == QUDA_CPU_FIELD_LOCATION;
+  if(!long_links) longlink_ptr = NULL;
+#else
+  const bool long_links = true;
 #endif
 
   gettimeofday(&t0, NULL);
@@ -329,13 +336,13 @@ llfat_test(int test)
       res &= compare_floats(fat_reflink[dir], myfatlink[dir], V*gaugeSiteSize, 1e-3, qudaGaugeParam.cpu_prec);
     }
     
-    strong_check_link(myfatlink, "GPU results: ",
+    strong_check_link(myfatlink, "QUDA results: ",
 		      fat_reflink, "CPU reference results:",
 		      V, qudaGaugeParam.cpu_prec);
     
     printfQuda("Fat-link test %s\n\n",(1 == res) ? "PASSED" : "FAILED");
 #ifdef MULTI_GPU
-    if(test){
+    if(long_links){
 #endif
       printfQuda("Checking long links...\n");
       res = 1;
@@ -343,7 +350,7 @@ llfat_test(int test)
 	res &= compare_floats(long_reflink[dir], mylonglink[dir], V*gaugeSiteSize, 1e-3, qudaGaugeParam.cpu_prec);
       }
       
-      strong_check_link(mylonglink, "GPU results: ",
+      strong_check_link(mylonglink, "QUDA results: ",
 			long_reflink, "CPU reference results:",
 			V, qudaGaugeParam.cpu_prec);
       
@@ -358,11 +365,7 @@ llfat_test(int test)
 
   int volume = qudaGaugeParam.X[0]*qudaGaugeParam.X[1]*qudaGaugeParam.X[2]*qudaGaugeParam.X[3];
   int flops= 61632;
-#ifdef MULTI_GPU
-  if(test) flops += (252*4); // long-link contribution 
-#else
-  flops += (252*4); // 2*117 + 18 (two matrix-matrix multiplications and a matrix rescale)
-#endif
+  if(long_links) flops += (252*4); // 2*117 + 18 (two matrix-matrix multiplications and a matrix rescale)
 
   double perf = 1.0* flops*volume/(secs*1024*1024*1024);
   printfQuda("link computation time =%.2f ms, flops= %.2f Gflops\n", secs*1000, perf);
@@ -409,12 +412,13 @@ display_test_info(int test)
 {
   printfQuda("running the following test:\n");
 
-  printfQuda("link_precision           link_reconstruct           space_dimension        T_dimension       Test          Ordering\n");
-  printfQuda("%s                       %s                         %d/%d/%d/                  %d             %d              %s \n", 
+  printfQuda("link_precision           link_reconstruct           space_dimension        T_dimension       Test          Ordering       Location\n");
+  printfQuda("%s                       %s                         %d/%d/%d/                  %d             %d              %s            %s\n", 
       get_prec_str(prec),
       get_recon_str(link_recon), 
       xdim, ydim, zdim, tdim, test, 
-      get_gauge_order_str(gauge_order));
+      get_gauge_order_str(gauge_order),
+      (fat_link_location == QUDA_CPU_FIELD_LOCATION) ? "cpu" : "gpu");
 
 #ifdef MULTI_GPU
   printfQuda("Grid partition info:     X  Y  Z  T\n");
@@ -437,6 +441,7 @@ usage_extra(char** argv )
   printfQuda("                                                0: standard method\n");
   printfQuda("                                                1: extended volume method\n");
   printfQuda("    --gauge-order <qdp/milc>		   # ordering of the input gauge-field\n");
+  printfQuda("    --fat-location <gpu/cpu>                 # where the links are fattened (default gpu)\n");
   return ;
 }
 
@@ -461,6 +466,36 @@ main(int argc, char **argv)
       continue;
     }
 
+    if( strcmp(argv[i], "--test") == 0){
+      if(i+1 >= argc){
+        usage(argv);
+      }
+      test = atoi(argv[i+1]);
+      if(test != 0 && test != 1){
+        fprintf(stderr, "Error: invalid test method %s\n", argv[i+1]);
+        exit(1);
+      }
+      i++;
+      continue;
+    }
+
+    if( strcmp(argv[i], "--fat-location") == 0){
+      if(i+1 >= argc){
+        usage(argv);
+      }
+
+      if(strcmp(argv[i+1], "cpu") == 0){
+        fat_link_location = QUDA_CPU_FIELD_LOCATION;
+      }else if(strcmp(argv[i+1], "gpu") == 0){
+        fat_link_location = QUDA_CUDA_FIELD_LOCATION;
+      }else{
+        fprintf(stderr, "Error: unsupported fat-link location\n");
+        exit(1);
+      }
+      i++;
+      continue;
+    }
+
     if( strcmp(argv[i], "--gauge-order") == 0){
       if(i+1 >= argc){
         usage(argv);
@@ -484,7 +519,7 @@ main(int argc, char **argv)
 
 
 #ifdef MULTI_GPU
-  if(gauge_order == QUDA_MILC_GAUGE_ORDER && test == 0){
+  if(gauge_order == QUDA_MILC_GAUGE_ORDER && test == 0 && fat_link_location == QUDA_CUDA_FIELD_LOCATION){
     errorQuda("ERROR: milc format for multi-gpu with test0 is not supported yet!\n");
   }
 #endif
@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include <iostream>
 
 #include <quda_internal.h>
@@ -11,6 +13,7 @@
 
 #include <color_spinor_field.h>
 #include <blas_quda.h>
+#include <site_order_quda.h>
 
 using namespace quda;
 
@@ -198,6 +201,230 @@ void packTest() {
 
 }
 
+// round trip a host spinor through the other host layouts and back
+void hostSpinorTest() {
+
+  ColorSpinorParam hostParam;
+  hostParam.nColor = 3;
+  hostParam.nSpin = 4;
+  hostParam.nDim = 4;
+  for (int d=0; d<4; d++) hostParam.x[d] = param.X[d];
+  hostParam.precision = QUDA_DOUBLE_PRECISION;
+  hostParam.pad = 0;
+  hostParam.siteSubset = QUDA_FULL_SITE_SUBSET; // required by the Morton order
+  hostParam.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  hostParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+  hostParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  hostParam.create = QUDA_NULL_FIELD_CREATE;
+
+  cpuColorSpinorField src(hostParam);
+  cpuColorSpinorField dst(hostParam);
+  src.Source(QUDA_RANDOM_SOURCE);
+  double src_norm = normCpu(src);
+
+  // half precision keeps about 15 bits relative to the largest element of each site
+  struct { QudaFieldOrder order; QudaSiteOrder site; QudaPrecision prec; double tol; const char *name; } layout[] = {
+    { QUDA_AOSOA_FIELD_ORDER, QUDA_EVEN_ODD_SITE_ORDER, QUDA_DOUBLE_PRECISION, 1e-15, "AoSoA double" },
+    { QUDA_AOSOA_FIELD_ORDER, QUDA_EVEN_ODD_SITE_ORDER, QUDA_SINGLE_PRECISION, 1e-6, "AoSoA single" },
+    { QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, QUDA_EVEN_ODD_SITE_ORDER, QUDA_HALF_PRECISION, 1e-4, "space-spin-color half" },
+    { QUDA_SPACE_COLOR_SPIN_FIELD_ORDER, QUDA_EVEN_ODD_SITE_ORDER, QUDA_HALF_PRECISION, 1e-4, "space-color-spin half" },
+    { QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, QUDA_MORTON_SITE_ORDER, QUDA_DOUBLE_PRECISION, 1e-15, "Morton double" },
+    { QUDA_AOSOA_FIELD_ORDER, QUDA_MORTON_SITE_ORDER, QUDA_SINGLE_PRECISION, 1e-6, "Morton AoSoA single" },
+  };
+
+  for (unsigned int i=0; i<sizeof(layout)/sizeof(layout[0]); i++) {
+    hostParam.fieldOrder = layout[i].order;
+    hostParam.siteOrder = layout[i].site;
+    hostParam.precision = layout[i].prec;
+    cpuColorSpinorField tmp(hostParam);
+
+    tmp = src;
+    dst = tmp;
+
+    double dev = sqrt(xmyNormCpu(src, dst) / src_norm);
+    printf("Host spinor %s round trip: relative deviation = %e, test %s\n",
+	   layout[i].name, dev, dev <= layout[i].tol ? "PASSED" : "FAILED");
+  }
+
+}
+
+// relative deviation of a half precision field from its double precision reference
+static double halfDeviation(const cpuColorSpinorField &ref, const cpuColorSpinorField &half) {
+  ColorSpinorParam tmpParam(ref);
+  tmpParam.create = QUDA_ZERO_FIELD_CREATE;
+  cpuColorSpinorField tmp(tmpParam);
+  tmp.copy(half);
+  return sqrt(xmyNormCpu(ref, tmp) / normCpu(ref));
+}
+
+// compare the half precision host BLAS with the same operations on double copies
+void hostHalfBlasTest() {
+
+  ColorSpinorParam hostParam;
+  hostParam.nColor = 3;
+  hostParam.nSpin = 4;
+  hostParam.nDim = 4;
+  for (int d=0; d<4; d++) hostParam.x[d] = param.X[d];
+  hostParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+  hostParam.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  hostParam.gammaBasis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  hostParam.create = QUDA_NULL_FIELD_CREATE;
+
+  // the padded FLOAT4 field has aligned parity halves and norms; its
+  // double precision reference is a FLOAT2 field with the same (zero) pad
+  struct { QudaFieldOrder order; QudaFieldOrder refOrder; int pad; const char *name; } layout[] = {
+    { QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, 0, "space-spin-color" },
+    { QUDA_FLOAT4_FIELD_ORDER, QUDA_FLOAT2_FIELD_ORDER, param.X[0]*param.X[1]*param.X[2]/2, "FLOAT4" },
+  };
+
+  // tuning re-runs the in-place kernels, which must then restore their output
+  QudaTune tuning = getTuning();
+  setTuning(QUDA_TUNE_YES);
+
+  const double tol = 1e-4;
+  const double a = 0.7;
+  const Complex ca(0.3, -1.1), cb(-0.6, 0.4);
+
+  for (unsigned int i=0; i<sizeof(layout)/sizeof(layout[0]); i++) {
+    hostParam.precision = QUDA_DOUBLE_PRECISION;
+    hostParam.fieldOrder = layout[i].refOrder;
+    hostParam.pad = layout[i].pad;
+    hostParam.create = QUDA_ZERO_FIELD_CREATE;
+    cpuColorSpinorField x(hostParam), y(hostParam), z(hostParam);
+
+    hostParam.precision = QUDA_HALF_PRECISION;
+    hostParam.fieldOrder = layout[i].order;
+    hostParam.create = QUDA_NULL_FIELD_CREATE;
+    cpuColorSpinorField xHalf(hostParam), yHalf(hostParam), zHalf(hostParam);
+
+    // each operation starts both from the same half precision values;
+    // copy() rather than assignment keeps the zeroed pads of the references
+    x.Source(QUDA_RANDOM_SOURCE);
+    y.Source(QUDA_RANDOM_SOURCE);
+    z.Source(QUDA_RANDOM_SOURCE);
+    xHalf.copy(x); yHalf.copy(y); zHalf.copy(z);
+    x.copy(xHalf); y.copy(yHalf); z.copy(zHalf);
+
+    double dev[5];
+    const char *op[5] = { "norm", "cDotProduct", "axpy", "caxpy", "cxpaypbz" };
+
+    double x2 = normCpu(x);
+    dev[0] = fabs(normCpu(xHalf) / x2 - 1.0);
+    dev[1] = abs(cDotProductCpu(xHalf, yHalf) - cDotProductCpu(x, y)) / sqrt(x2 * normCpu(y));
+
+    axpyCpu(a, xHalf, yHalf);
+    axpyCpu(a, x, y);
+    dev[2] = halfDeviation(y, yHalf);
+    y.copy(yHalf);
+
+    caxpyCpu(ca, xHalf, yHalf);
+    caxpyCpu(ca, x, y);
+    dev[3] = halfDeviation(y, yHalf);
+    y.copy(yHalf);
+
+    cxpaypbzCpu(xHalf, ca, yHalf, cb, zHalf);
+    cxpaypbzCpu(x, ca, y, cb, z);
+    dev[4] = halfDeviation(z, zHalf);
+
+    for (int j=0; j<5; j++) {
+      printf("Host half %s %s: relative deviation = %e, test %s\n",
+	     layout[i].name, op[j], dev[j], dev[j] <= tol ? "PASSED" : "FAILED");
+    }
+  }
+
+  setTuning(tuning);
+}
+
+// check every entry of the Morton neighbour tables against the site coordinates
+void mortonTest() {
+
+  const int *X = param.X;
+  const MortonSiteOrder &morton = mortonSiteOrder(X);
+  const int volumeCB = morton.VolumeCB();
+  int fail = 0;
+
+  for (int parity=0; parity<2; parity++) {
+    const int *from = morton.FromCurve(parity);
+    const int *to = morton.ToCurve(1-parity);
+    const int *neighbour = morton.Neighbours(parity);
+
+    for (int i=0; i<volumeCB; i++) {
+      // the lexicographic index of checkerboard site cb is 2*cb or 2*cb+1
+      int x[4];
+      for (int l=2*from[i]; l<2*from[i]+2; l++) {
+	x[0] = l % X[0];
+	x[1] = (l / X[0]) % X[1];
+	x[2] = (l / (X[0]*X[1])) % X[2];
+	x[3] = l / (X[0]*X[1]*X[2]);
+	if (((x[0] + x[1] + x[2] + x[3]) & 1) == parity) break;
+      }
+
+      for (int mu=0; mu<4; mu++) {
+	for (int d=0; d<2; d++) {
+	  int y[4] = { x[0], x[1], x[2], x[3] };
+	  y[mu] = (y[mu] + (d == 0 ? 1 : X[mu]-1)) % X[mu];
+	  int l = ((y[3]*X[2] + y[2])*X[1] + y[1])*X[0] + y[0];
+	  if (((y[0] + y[1] + y[2] + y[3]) & 1) == parity || neighbour[8*i + 2*mu + d] != to[l/2]) fail++;
+	}
+      }
+    }
+  }
+
+  printf("Morton neighbour table: %d of %d entries wrong, test %s\n",
+	 fail, 16*volumeCB, fail == 0 ? "PASSED" : "FAILED");
+}
+
+// round trip a host gauge field through the compressed host storage and back
+void hostGaugeTest() {
+
+#ifdef BUILD_QDP_INTERFACE
+  param.type = QUDA_WILSON_LINKS;
+  param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+  construct_gauge_field(qdpCpuGauge_p, 1, param.cpu_prec, &param);
+
+  void *outGauge_p[4];
+  for (int dir = 0; dir < 4; dir++) outGauge_p[dir] = malloc(V*gaugeSiteSize*param.cpu_prec);
+
+  GaugeFieldParam gParam(qdpCpuGauge_p, param);
+  cpuGaugeField in(gParam);
+  gParam.gauge = outGauge_p;
+  cpuGaugeField out(gParam);
+
+  struct { QudaGaugeFieldOrder order; QudaReconstructType recon; double tol; const char *name; } layout[] = {
+    { QUDA_QDP_GAUGE_ORDER, QUDA_RECONSTRUCT_12, 1e-12, "QDP 12" },
+    { QUDA_QDP_GAUGE_ORDER, QUDA_RECONSTRUCT_8, 1e-10, "QDP 8" },
+#ifdef BUILD_MILC_INTERFACE
+    { QUDA_MILC_GAUGE_ORDER, QUDA_RECONSTRUCT_12, 1e-12, "MILC 12" },
+#endif
+    { QUDA_AOSOA_GAUGE_ORDER, QUDA_RECONSTRUCT_8, 1e-10, "AoSoA 8" },
+  };
+
+  for (unsigned int i=0; i<sizeof(layout)/sizeof(layout[0]); i++) {
+    gParam.create = QUDA_NULL_FIELD_CREATE;
+    gParam.order = layout[i].order;
+    gParam.reconstruct = layout[i].recon;
+    cpuGaugeField packed(gParam);
+
+    for (int dir = 0; dir < 4; dir++) memset(outGauge_p[dir], 0, V*gaugeSiteSize*param.cpu_prec);
+    packed.copy(in);
+    out.copy(packed);
+
+    double dev = 0.0;
+    for (int dir = 0; dir < 4; dir++) {
+      for (int j = 0; j < V*gaugeSiteSize; j++) {
+	double a = (param.cpu_prec == QUDA_DOUBLE_PRECISION) ? ((double*)qdpCpuGauge_p[dir])[j] : ((float*)qdpCpuGauge_p[dir])[j];
+	double b = (param.cpu_prec == QUDA_DOUBLE_PRECISION) ? ((double*)outGauge_p[dir])[j] : ((float*)outGauge_p[dir])[j];
+	if (fabs(a-b) > dev) dev = fabs(a-b);
+      }
+    }
+    printf("Host gauge %s round trip: max deviation = %e, test %s\n",
+	   layout[i].name, dev, dev <= layout[i].tol ? "PASSED" : "FAILED");
+  }
+
+  for (int dir = 0; dir < 4; dir++) free(outGauge_p[dir]);
+#endif
+}
+
 extern void usage(char**);
 
 int main(int argc, char **argv) {
@@ -214,6 +441,10 @@ int main(int argc, char **argv) {
 
   init();
   packTest();
+  hostSpinorTest();
+  hostHalfBlasTest();
+  mortonTest();
+  hostGaugeTest();
   end();
 
   finalizeComms();
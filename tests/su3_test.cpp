@@ -1,12 +1,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+
+#include <complex>
+#include <vector>
 
 #include <test_util.h>
 #include <dslash_util.h>
 
 #include <gauge_qio.h>
 
+#include <comm_quda.h>
+
 #ifdef QMP_COMMS
 #include <qmp.h>
 #endif
@@ -81,6 +87,263 @@ void end() {
   }
 }
 
+// c = a b, or c = a b^dag if dag is set
+static void su3Mult(double *c, const double *a, const double *b, bool dag) {
+  for (int i=0; i<3; i++) {
+    for (int j=0; j<3; j++) {
+      double re = 0.0, im = 0.0;
+      for (int k=0; k<3; k++) {
+	const double *x = a + 2*(3*i+k);
+	const double *y = dag ? b + 2*(3*j+k) : b + 2*(3*k+j);
+	const double y_im = dag ? -y[1] : y[1];
+	re += x[0]*y[0] - x[1]*y_im;
+	im += x[0]*y_im + x[1]*y[0];
+      }
+      c[2*(3*i+j)+0] = re;
+      c[2*(3*i+j)+1] = im;
+    }
+  }
+}
+
+// the link U_mu(x) of a QDP-ordered field
+static double* linkAt(void **gauge, const int x[4], int mu) {
+  int idx = ((x[3]*Z[2] + x[2])*Z[1] + x[1])*Z[0] + x[0];
+  int oddBit = (x[0] + x[1] + x[2] + x[3]) & 1;
+  return (double*)gauge[mu] + (oddBit*Vh + idx/2)*gaugeSiteSize;
+}
+
+// Product of the links along a path starting at x0, with step +(mu+1)
+// forwards and -(mu+1) backwards in dimension mu, wrapping periodically
+static void pathProduct(double *P, void **gauge, const int x0[4], const int *path, int length) {
+  int x[4] = { x0[0], x0[1], x0[2], x0[3] };
+  double tmp[18];
+  for (int i=0; i<18; i++) P[i] = (i % 8 == 0) ? 1.0 : 0.0;
+
+  for (int k=0; k<length; k++) {
+    int mu = abs(path[k]) - 1;
+    if (path[k] > 0) {
+      su3Mult(tmp, P, linkAt(gauge, x, mu), false);
+      x[mu] = (x[mu] + 1) % Z[mu];
+    } else {
+      x[mu] = (x[mu] - 1 + Z[mu]) % Z[mu];
+      su3Mult(tmp, P, linkAt(gauge, x, mu), true);
+    }
+    memcpy(P, tmp, sizeof(tmp));
+  }
+}
+
+static double reTrace(const double *P) { return P[0] + P[8] + P[16]; }
+
+typedef std::complex<double> Complex;
+
+// Traceless clover-leaf field strength F = (Q - Q^dag)/(8i) in the mu-nu plane at x
+static void cloverField(Complex F[3][3], void **gauge, const int x[4], int mu, int nu) {
+  const int m = mu+1, n = nu+1;
+  const int leaf[4][4] = { { m, n, -m, -n }, { n, -m, -n, m }, { -m, -n, m, n }, { -n, m, n, -m } };
+  double Q[18] = { }, P[18];
+  for (int l=0; l<4; l++) {
+    pathProduct(P, gauge, x, leaf[l], 4);
+    for (int i=0; i<18; i++) Q[i] += P[i];
+  }
+
+  Complex tr = 0.0;
+  for (int i=0; i<3; i++) {
+    for (int j=0; j<3; j++) {
+      Complex q_ij(Q[2*(3*i+j)], Q[2*(3*i+j)+1]), q_ji(Q[2*(3*j+i)], Q[2*(3*j+i)+1]);
+      F[i][j] = (q_ij - std::conj(q_ji)) / Complex(0.0, 8.0);
+    }
+    tr += F[i][i];
+  }
+  for (int i=0; i<3; i++) F[i][i] -= tr / 3.0;
+}
+
+static double reTraceProduct(Complex A[3][3], Complex B[3][3]) {
+  double sum = 0.0;
+  for (int i=0; i<3; i++)
+    for (int j=0; j<3; j++) sum += std::real(A[i][j]*B[j][i]);
+  return sum;
+}
+
+// Reference gauge observables of a QDP-ordered single-rank field,
+// computed loop by loop from the links with the conventions of
+// gaugeObservablesQuda()
+static void observablesReference(QudaGaugeObservableParam &ref, void **gauge) {
+  double plaq[2] = { 0.0, 0.0 }, rect = 0.0, poly[2] = { 0.0, 0.0 }, qcharge = 0.0;
+  double P[18];
+
+  for (int t=0; t<Z[3]; t++) {
+    for (int z=0; z<Z[2]; z++) {
+      for (int y=0; y<Z[1]; y++) {
+	for (int x=0; x<Z[0]; x++) {
+	  const int c[4] = { x, y, z, t };
+
+	  for (int mu=0; mu<4; mu++) {
+	    for (int nu=0; nu<4; nu++) {
+	      if (nu == mu) continue;
+	      const int m = mu+1, n = nu+1;
+	      if (nu > mu) {
+		const int path[4] = { m, n, -m, -n };
+		pathProduct(P, gauge, c, path, 4);
+		plaq[nu == 3] += reTrace(P) / 3.0;
+	      }
+	      const int path[6] = { m, m, n, -m, -m, -n };
+	      pathProduct(P, gauge, c, path, 6);
+	      rect += reTrace(P) / 3.0;
+	    }
+	  }
+
+	  Complex F[6][3][3]; // planes 01, 02, 03, 12, 13, 23
+	  for (int mu=0, p=0; mu<4; mu++)
+	    for (int nu=mu+1; nu<4; nu++, p++) cloverField(F[p], gauge, c, mu, nu);
+	  double q = (reTraceProduct(F[0], F[5]) - reTraceProduct(F[1], F[4]) + reTraceProduct(F[2], F[3]))
+	    / (4.0*M_PI*M_PI);
+	  if (ref.qcharge_density) ref.qcharge_density[((t*Z[2] + z)*Z[1] + y)*Z[0] + x] = q;
+	  qcharge += q;
+
+	  if (t == 0) {
+	    std::vector<int> path(Z[3], 4);
+	    pathProduct(P, gauge, c, &path[0], Z[3]);
+	    poly[0] += reTrace(P) / 3.0;
+	    poly[1] += (P[1] + P[9] + P[17]) / 3.0;
+	  }
+	}
+      }
+    }
+  }
+
+  ref.plaquette[1] = plaq[0] / (3.0*V);
+  ref.plaquette[2] = plaq[1] / (3.0*V);
+  ref.plaquette[0] = 0.5*(ref.plaquette[1] + ref.plaquette[2]);
+  ref.rectangle = rect / (12.0*V);
+  ref.polyakov_loop[0] = poly[0] / (Z[0]*Z[1]*Z[2]);
+  ref.polyakov_loop[1] = poly[1] / (Z[0]*Z[1]*Z[2]);
+  ref.qcharge = qcharge;
+}
+
+// Compare the host gauge observables of the field with ref, within tol,
+// including the charge density if ref has one
+static bool compareObservables(const char *name, void **links, const QudaGaugeObservableParam &ref, double tol) {
+  std::vector<double> density(V);
+  QudaGaugeObservableParam obs;
+  obs.qcharge_density = &density[0];
+  param.location = QUDA_CPU_FIELD_LOCATION;
+  gaugeObservablesQuda(links, &param, &obs);
+
+  printf("%s: plaquette = %e (spatial %e, temporal %e), rectangle = %e\n", name,
+	 obs.plaquette[0], obs.plaquette[1], obs.plaquette[2], obs.rectangle);
+  printf("%s: Polyakov loop = (%e, %e), topological charge = %e\n", name,
+	 obs.polyakov_loop[0], obs.polyakov_loop[1], obs.qcharge);
+
+  double dev = 0.0;
+  for (int i=0; i<3; i++) dev = MAX(dev, fabs(obs.plaquette[i] - ref.plaquette[i]));
+  dev = MAX(dev, fabs(obs.rectangle - ref.rectangle));
+  for (int i=0; i<2; i++) dev = MAX(dev, fabs(obs.polyakov_loop[i] - ref.polyakov_loop[i]));
+  dev = MAX(dev, fabs(obs.qcharge - ref.qcharge));
+
+  double density_dev = 0.0;
+  for (int i=0; i<V; i++) {
+    double expected = ref.qcharge_density ? ref.qcharge_density[i] : 0.0;
+    density_dev = MAX(density_dev, fabs(density[i] - expected));
+  }
+
+  printf("%s: max deviation = %e, charge density max deviation = %e\n", name, dev, density_dev);
+  return dev < tol && density_dev < tol;
+}
+
+// a random SU(3) matrix determined by the global site index n
+static void siteSU3(double *g, long long n) {
+  unsigned long long seed = 0x9e3779b97f4a7c15ULL * (unsigned long long)(n + 1);
+  Complex u[3][3];
+  for (int i=0; i<2; i++) {
+    for (int j=0; j<3; j++) {
+      double r[2];
+      for (int k=0; k<2; k++) {
+	seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+	r[k] = (seed >> 11) * (1.0/9007199254740992.0) - 0.5;
+      }
+      u[i][j] = Complex(r[0], r[1]);
+    }
+  }
+
+  // Gram-Schmidt on the first two rows, the third is their conjugate cross product
+  double norm0 = sqrt(std::norm(u[0][0]) + std::norm(u[0][1]) + std::norm(u[0][2]));
+  for (int j=0; j<3; j++) u[0][j] /= norm0;
+  Complex dot = std::conj(u[0][0])*u[1][0] + std::conj(u[0][1])*u[1][1] + std::conj(u[0][2])*u[1][2];
+  for (int j=0; j<3; j++) u[1][j] -= dot*u[0][j];
+  double norm1 = sqrt(std::norm(u[1][0]) + std::norm(u[1][1]) + std::norm(u[1][2]));
+  for (int j=0; j<3; j++) u[1][j] /= norm1;
+  for (int j=0; j<3; j++) u[2][j] = std::conj(u[0][(j+1)%3]*u[1][(j+2)%3] - u[0][(j+2)%3]*u[1][(j+1)%3]);
+
+  for (int i=0; i<3; i++) {
+    for (int j=0; j<3; j++) {
+      g[2*(3*i+j)+0] = std::real(u[i][j]);
+      g[2*(3*i+j)+1] = std::imag(u[i][j]);
+    }
+  }
+}
+
+// Gauge transform of the unit field, U_mu(x) = G(x) G(x+mu)^dag, with G
+// a function of the global coordinates, so that the links in the halo
+// of each rank differ from its own and the loops are still those of
+// the unit field
+static void pureGaugeField(void **links) {
+  int L[4], offset[4];
+  for (int d=0; d<4; d++) {
+    L[d] = Z[d]*comm_dim(d);
+    offset[d] = Z[d]*comm_coord(d);
+  }
+
+  double g[18], h[18];
+  for (int t=0; t<Z[3]; t++) {
+    for (int z=0; z<Z[2]; z++) {
+      for (int y=0; y<Z[1]; y++) {
+	for (int x=0; x<Z[0]; x++) {
+	  const int c[4] = { x, y, z, t };
+	  int X[4];
+	  for (int d=0; d<4; d++) X[d] = c[d] + offset[d];
+	  siteSU3(g, (((long long)X[3]*L[2] + X[2])*L[1] + X[1])*L[0] + X[0]);
+	  for (int mu=0; mu<4; mu++) {
+	    int Y[4] = { X[0], X[1], X[2], X[3] };
+	    Y[mu] = (Y[mu] + 1) % L[mu];
+	    siteSU3(h, (((long long)Y[3]*L[2] + Y[2])*L[1] + Y[1])*L[0] + Y[0]);
+	    su3Mult(linkAt(links, c, mu), g, h, true);
+	  }
+	}
+      }
+    }
+  }
+}
+
+// compare the host gauge observables with references computed in the test
+void observablesTest() {
+  // the unit gauge field, for which every rank knows the answer
+  construct_gauge_field(new_gauge, 0, param.cpu_prec, &param);
+  QudaGaugeObservableParam unit;
+  unit.plaquette[0] = unit.plaquette[1] = unit.plaquette[2] = 1.0;
+  unit.rectangle = 1.0;
+  unit.polyakov_loop[0] = 1.0;
+  unit.polyakov_loop[1] = 0.0;
+  unit.qcharge = 0.0;
+  unit.qcharge_density = NULL; // zero everywhere
+  bool pass = compareObservables("Unit gauge", new_gauge, unit, 1e-12);
+
+  // a pure gauge field has the same loops, but needs the right halo links
+  pureGaugeField(new_gauge);
+  pass &= compareObservables("Pure gauge", new_gauge, unit, 1e-12);
+
+  if (comm_size() > 1) {
+    printf("Reference loops are single-rank only, skipping the random field\n");
+  } else {
+    std::vector<double> density(V);
+    QudaGaugeObservableParam ref;
+    ref.qcharge_density = &density[0];
+    observablesReference(ref, gauge);
+    pass &= compareObservables("Test field", gauge, ref, 1e-10);
+  }
+
+  printf("Gauge observables test %s\n", pass ? "PASSED" : "FAILED");
+}
+
 extern void usage(char**);
 
 void SU3Test(int argc, char **argv) {
@@ -110,6 +373,8 @@ void SU3Test(int argc, char **argv) {
 
   check_gauge(gauge, new_gauge, 1e-3, param.cpu_prec);
 
+  observablesTest();
+
   end();
 }
 
@@ -0,0 +1,587 @@
+// tune_sweep.cpp
+//
+// Offline autotuning sweep: runs every kernel family that QUDA tunes
+// (dslash, blas, reductions, field copies, link fattening, gauge force
+// and gauge update) for each requested combination of local volume,
+// precision, reconstruct and dslash type, so that the tunecache in
+// QUDA_RESOURCE_PATH is fully populated before production jobs start.
+//
+// The tunecache is saved after every combination, and each completed
+// combination is recorded in QUDA_RESOURCE_PATH/tune_sweep.progress.
+// An interrupted sweep can therefore be resumed by re-running the same
+// command: completed combinations are skipped, and any kernel already
+// present in the tunecache is not re-tuned.  Pass --restart to ignore
+// the progress file.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include <util_quda.h>
+#include <test_util.h>
+#include <dslash_util.h>
+#include "misc.h"
+
+#include <comm_quda.h>
+#include <tune_quda.h>
+
+#include <quda.h>
+
+#define MAX(a,b) ((a)>(b)?(a):(b))
+
+extern QudaDslashType dslash_type;
+extern bool tune;
+extern int device;
+extern int xdim;
+extern int ydim;
+extern int zdim;
+extern int tdim;
+extern int Lsdim;
+extern int niter;
+extern int gridsize_from_cmdline[];
+extern QudaPrecision prec_sloppy;
+
+extern void usage(char** );
+
+namespace {
+
+  struct Volume {
+    int X[4];
+  };
+
+  std::vector<Volume> volumes;
+  std::vector<QudaPrecision> precs;
+  std::vector<QudaReconstructType> recons;
+  std::vector<QudaDslashType> dslash_types;
+  bool restart = false;
+
+  std::string progress_path;
+  std::set<std::string> completed;
+
+  const QudaPrecision cpu_prec = QUDA_DOUBLE_PRECISION;
+
+
+  // split a comma separated list, calling parse() on each item
+  template <typename T>
+  void parseList(std::vector<T> &list, const char *arg, T (*parse)(char*))
+  {
+    std::string s(arg);
+    size_t start = 0;
+    while (start <= s.size()) {
+      size_t end = s.find(',', start);
+      if (end == std::string::npos) end = s.size();
+      std::string item = s.substr(start, end - start);
+      if (item.size() > 0) list.push_back(parse(const_cast<char*>(item.c_str())));
+      start = end + 1;
+    }
+  }
+
+  Volume parseVolume(char *s)
+  {
+    Volume v;
+    if (sscanf(s, "%dx%dx%dx%d", &v.X[0], &v.X[1], &v.X[2], &v.X[3]) != 4) {
+      fprintf(stderr, "ERROR: invalid volume %s (expected XxYxZxT)\n", s);
+      exit(1);
+    }
+    return v;
+  }
+
+  std::string comboKey(const Volume &v, QudaPrecision p, QudaReconstructType r, const char *type)
+  {
+    char key[256];
+    snprintf(key, sizeof(key), "%dx%dx%dx%d %s %s %s", v.X[0], v.X[1], v.X[2], v.X[3],
+	     get_prec_str(p), get_recon_str(r), type);
+    return std::string(key);
+  }
+
+
+  // Read the list of completed combinations on rank 0.  The decision
+  // to skip a combination is broadcast from rank 0 so that all ranks
+  // stay in step, mirroring how the tunecache itself is loaded.
+  void loadProgress()
+  {
+    const char *path = getenv("QUDA_RESOURCE_PATH");
+    if (!path) {
+      warningQuda("QUDA_RESOURCE_PATH is not set; the sweep cannot be resumed if interrupted");
+      return;
+    }
+    progress_path = std::string(path) + "/tune_sweep.progress";
+    if (restart || comm_rank() != 0) return;
+
+    FILE *fp = fopen(progress_path.c_str(), "r");
+    if (!fp) return;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+      size_t len = strlen(line);
+      if (len > 0 && line[len-1] == '\n') line[len-1] = '\0';
+      if (line[0] != '\0' && line[0] != '#') completed.insert(std::string(line));
+    }
+    fclose(fp);
+    printfQuda("Resuming tuning sweep: %lu combinations already completed\n", (unsigned long)completed.size());
+  }
+
+  bool isCompleted(const std::string &key)
+  {
+    int done = (comm_rank() == 0 && completed.count(key)) ? 1 : 0;
+    comm_broadcast(&done, sizeof(int));
+    return done;
+  }
+
+  // save the tunecache and then record the combination as done
+  void markCompleted(const std::string &key)
+  {
+    quda::saveTuneCache(getVerbosity());
+    if (comm_rank() != 0 || progress_path.size() == 0) return;
+    FILE *fp = fopen(progress_path.c_str(), "a");
+    if (!fp) {
+      warningQuda("Unable to write tuning sweep progress to %s", progress_path.c_str());
+      return;
+    }
+    fprintf(fp, "%s\n", key.c_str());
+    fclose(fp);
+  }
+
+
+  void setGaugeParam(QudaGaugeParam &gauge_param, const Volume &v, QudaPrecision p,
+		     QudaPrecision p_sloppy, QudaReconstructType r)
+  {
+    for (int d=0; d<4; d++) gauge_param.X[d] = v.X[d];
+    gauge_param.anisotropy = 1.0;
+    gauge_param.type = QUDA_WILSON_LINKS;
+    gauge_param.gauge_order = QUDA_QDP_GAUGE_ORDER;
+    gauge_param.t_boundary = QUDA_ANTI_PERIODIC_T;
+    gauge_param.cpu_prec = cpu_prec;
+    gauge_param.cuda_prec = p;
+    gauge_param.reconstruct = r;
+    gauge_param.cuda_prec_sloppy = p_sloppy;
+    gauge_param.reconstruct_sloppy = r;
+    gauge_param.cuda_prec_precondition = p_sloppy;
+    gauge_param.reconstruct_precondition = r;
+    gauge_param.gauge_fix = QUDA_GAUGE_FIXED_NO;
+    gauge_param.ga_pad = 0;
+
+    // For multi-GPU, ga_pad must be large enough to store a time-slice
+#ifdef MULTI_GPU
+    int pad_size = MAX(v.X[1]*v.X[2]*v.X[3]/2, v.X[0]*v.X[2]*v.X[3]/2);
+    pad_size = MAX(pad_size, v.X[0]*v.X[1]*v.X[3]/2);
+    pad_size = MAX(pad_size, v.X[0]*v.X[1]*v.X[2]/2);
+    gauge_param.ga_pad = pad_size;
+#endif
+  }
+
+  void setInvertParam(QudaInvertParam &inv_param, QudaPrecision p, QudaPrecision p_sloppy)
+  {
+    inv_param.tol = 1e-12; // we want the solver to run for exactly maxiter iterations
+    inv_param.residual_type = QUDA_L2_RELATIVE_RESIDUAL;
+    inv_param.maxiter = niter;
+    inv_param.reliable_delta = 1e-2;
+    inv_param.pipeline = 0;
+    inv_param.gcrNkrylov = 10;
+    inv_param.inv_type_precondition = QUDA_INVALID_INVERTER;
+
+    inv_param.cpu_prec = cpu_prec;
+    inv_param.cuda_prec = p;
+    inv_param.cuda_prec_sloppy = p_sloppy;
+    inv_param.cuda_prec_precondition = p_sloppy;
+    inv_param.preserve_source = QUDA_PRESERVE_SOURCE_YES;
+    inv_param.gamma_basis = QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+    inv_param.dirac_order = QUDA_DIRAC_ORDER;
+    inv_param.dagger = QUDA_DAG_NO;
+
+    inv_param.input_location = QUDA_CPU_FIELD_LOCATION;
+    inv_param.output_location = QUDA_CPU_FIELD_LOCATION;
+
+    inv_param.tune = QUDA_TUNE_YES;
+    inv_param.sp_pad = 0;
+    inv_param.cl_pad = 0;
+    inv_param.verbosity = QUDA_SUMMARIZE;
+  }
+
+  void randomSpinor(void *v, size_t length)
+  {
+    for (size_t i=0; i<length; i++) ((double*)v)[i] = rand() / (double)RAND_MAX;
+  }
+
+
+  // Solves plus the individual operators for the Wilson-like actions
+  void sweepWilson(const Volume &v, QudaPrecision p, QudaPrecision p_sloppy,
+		   QudaReconstructType r, QudaDslashType type)
+  {
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    QudaInvertParam inv_param = newQudaInvertParam();
+    setGaugeParam(gauge_param, v, p, p_sloppy, r);
+    setInvertParam(inv_param, p, p_sloppy);
+
+    inv_param.dslash_type = type;
+    inv_param.Ls = 1;
+    double mass = -0.4125;
+    inv_param.kappa = 1.0 / (2.0 * (1 + 3/gauge_param.anisotropy + mass));
+    inv_param.mass_normalization = QUDA_KAPPA_NORMALIZATION;
+    inv_param.solver_normalization = QUDA_DEFAULT_NORMALIZATION;
+    inv_param.matpc_type = QUDA_MATPC_EVEN_EVEN;
+
+    if (type == QUDA_TWISTED_MASS_DSLASH) {
+      inv_param.mu = 0.12;
+      inv_param.epsilon = 0.1385;
+      inv_param.matpc_type = QUDA_MATPC_EVEN_EVEN_ASYMMETRIC;
+    } else if (type == QUDA_DOMAIN_WALL_DSLASH) {
+      inv_param.mass = 0.02;
+      inv_param.m5 = -1.8;
+      inv_param.Ls = Lsdim;
+    }
+
+    if (type == QUDA_CLOVER_WILSON_DSLASH) {
+      inv_param.clover_cpu_prec = cpu_prec;
+      inv_param.clover_cuda_prec = p;
+      inv_param.clover_cuda_prec_sloppy = p_sloppy;
+      inv_param.clover_cuda_prec_precondition = p_sloppy;
+      inv_param.clover_order = QUDA_PACKED_CLOVER_ORDER;
+    }
+
+    if (type == QUDA_DOMAIN_WALL_DSLASH) dw_setDims(gauge_param.X, inv_param.Ls);
+    else setDims(gauge_param.X);
+    setSpinorSiteSize(24);
+
+    void *gauge[4];
+    for (int dir=0; dir<4; dir++) gauge[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+    construct_gauge_field(gauge, 1, gauge_param.cpu_prec, &gauge_param);
+    loadGaugeQuda((void*)gauge, &gauge_param);
+
+    void *clover_inv = 0;
+    if (type == QUDA_CLOVER_WILSON_DSLASH) {
+      clover_inv = malloc(V*cloverSiteSize*sizeof(double));
+      construct_clover_field(clover_inv, 0.0, 1.0, inv_param.clover_cpu_prec);
+      loadCloverQuda(NULL, clover_inv, &inv_param);
+    }
+
+    // the doublet operator acts on two flavours
+    int nflavor = (type == QUDA_TWISTED_MASS_DSLASH) ? 2 : 1;
+    size_t length = (size_t)V*spinorSiteSize*inv_param.Ls*nflavor;
+    void *spinorIn = malloc(length*sizeof(double));
+    void *spinorOut = malloc(length*sizeof(double));
+    randomSpinor(spinorIn, length);
+
+    QudaTwistFlavorType flavors[] = { QUDA_TWIST_MINUS, QUDA_TWIST_NONDEG_DOUBLET };
+    int nvariant = (type == QUDA_TWISTED_MASS_DSLASH) ? 2 : 1;
+
+    for (int variant=0; variant<nvariant; variant++) {
+      if (type == QUDA_TWISTED_MASS_DSLASH) {
+	inv_param.twist_flavor = flavors[variant];
+	inv_param.Ls = (inv_param.twist_flavor == QUDA_TWIST_NONDEG_DOUBLET) ? 2 : 1;
+      }
+
+      // BiCGstab on the preconditioned system, then CG on the normal system
+      if (type != QUDA_DOMAIN_WALL_DSLASH && inv_param.twist_flavor != QUDA_TWIST_NONDEG_DOUBLET) {
+	inv_param.inv_type = QUDA_BICGSTAB_INVERTER;
+	inv_param.solve_type = QUDA_DIRECT_PC_SOLVE;
+	inv_param.solution_type = QUDA_MATPC_SOLUTION;
+	memset(spinorOut, 0, length*sizeof(double));
+	invertQuda(spinorOut, spinorIn, &inv_param);
+      }
+
+      inv_param.inv_type = QUDA_CG_INVERTER;
+      inv_param.solve_type = QUDA_NORMOP_PC_SOLVE;
+      inv_param.solution_type = QUDA_MATPC_SOLUTION;
+      memset(spinorOut, 0, length*sizeof(double));
+      invertQuda(spinorOut, spinorIn, &inv_param);
+
+      // the operators on their own, with and without dagger
+      for (int dag=0; dag<2; dag++) {
+	inv_param.dagger = dag ? QUDA_DAG_YES : QUDA_DAG_NO;
+	MatQuda(spinorOut, spinorIn, &inv_param);
+	MatDagMatQuda(spinorOut, spinorIn, &inv_param);
+      }
+      inv_param.dagger = QUDA_DAG_NO;
+    }
+
+    freeGaugeQuda();
+    if (type == QUDA_CLOVER_WILSON_DSLASH) freeCloverQuda();
+
+    free(spinorOut);
+    free(spinorIn);
+    if (clover_inv) free(clover_inv);
+    for (int dir=0; dir<4; dir++) free(gauge[dir]);
+  }
+
+
+  void sweepStaggered(const Volume &v, QudaPrecision p, QudaPrecision p_sloppy,
+		      QudaReconstructType r)
+  {
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    QudaInvertParam inv_param = newQudaInvertParam();
+    setGaugeParam(gauge_param, v, p, p_sloppy, r);
+    setInvertParam(inv_param, p, p_sloppy);
+
+    double tadpole_coeff = 0.8;
+    gauge_param.tadpole_coeff = tadpole_coeff;
+    gauge_param.scale = -1.0/(24.0*tadpole_coeff*tadpole_coeff);
+
+    inv_param.dslash_type = QUDA_ASQTAD_DSLASH;
+    inv_param.mass = 0.5;
+    inv_param.inv_type = QUDA_CG_INVERTER;
+    inv_param.solution_type = QUDA_MATPCDAG_MATPC_SOLUTION;
+    inv_param.solve_type = QUDA_NORMOP_PC_SOLVE;
+    inv_param.mass_normalization = QUDA_MASS_NORMALIZATION;
+    inv_param.reliable_delta = 1e-1;
+
+    setDims(gauge_param.X);
+
+    void *fatlink[4], *longlink[4];
+    for (int dir=0; dir<4; dir++) {
+      fatlink[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+      longlink[dir] = malloc(V*gaugeSiteSize*sizeof(double));
+    }
+    construct_fat_long_gauge_field(fatlink, longlink, 1, gauge_param.cpu_prec, &gauge_param);
+
+    int fat_pad = gauge_param.ga_pad;
+    gauge_param.type = QUDA_ASQTAD_FAT_LINKS;
+    gauge_param.reconstruct = gauge_param.reconstruct_sloppy = QUDA_RECONSTRUCT_NO;
+    loadGaugeQuda((void*)fatlink, &gauge_param);
+
+    gauge_param.type = QUDA_ASQTAD_LONG_LINKS;
+    gauge_param.ga_pad = 3*fat_pad;
+    gauge_param.reconstruct = gauge_param.reconstruct_sloppy = r;
+    loadGaugeQuda((void*)longlink, &gauge_param);
+
+    inv_param.sp_pad = fat_pad;
+
+    size_t length = (size_t)Vh*6;
+    void *spinorIn = malloc(length*sizeof(double));
+    void *spinorOut = malloc(length*sizeof(double));
+    randomSpinor(spinorIn, length);
+
+    QudaMatPCType matpc[] = { QUDA_MATPC_EVEN_EVEN, QUDA_MATPC_ODD_ODD };
+    for (int i=0; i<2; i++) {
+      inv_param.matpc_type = matpc[i];
+      memset(spinorOut, 0, length*sizeof(double));
+      invertQuda(spinorOut, spinorIn, &inv_param);
+      MatDagMatQuda(spinorOut, spinorIn, &inv_param);
+    }
+
+    freeGaugeQuda();
+
+    free(spinorOut);
+    free(spinorIn);
+    for (int dir=0; dir<4; dir++) {
+      free(longlink[dir]);
+      free(fatlink[dir]);
+    }
+  }
+
+
+  // Link fattening, gauge force and gauge update.  These kernels run in
+  // the precision of the host fields, so half precision is skipped.
+  void sweepLinks(const Volume &v, QudaPrecision p, QudaReconstructType r)
+  {
+    if (p == QUDA_HALF_PRECISION) return;
+
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    setGaugeParam(gauge_param, v, p, p, r);
+    gauge_param.cpu_prec = p;
+    gauge_param.preserve_gauge = 0;
+    setDims(gauge_param.X);
+
+    size_t gSize = p;
+    void *sitelink[4];
+    for (int dir=0; dir<4; dir++) sitelink[dir] = malloc(V*gaugeSiteSize*gSize);
+    createSiteLinkCPU(sitelink, p, 1);
+
+#ifdef GPU_FATLINK
+    {
+      void *fatlink = malloc(4*V*gaugeSiteSize*gSize);
+      void *longlink = malloc(4*V*gaugeSiteSize*gSize);
+      double act_path_coeff[6];
+      for (int i=0; i<6; i++) act_path_coeff[i] = 0.1*i;
+#ifdef MULTI_GPU
+      void *longlink_ptr = NULL; // the long links need an extended volume
+#else
+      void *longlink_ptr = longlink;
+#endif
+      computeKSLinkQuda(fatlink, longlink_ptr, sitelink, act_path_coeff, &gauge_param,
+			QUDA_COMPUTE_FAT_STANDARD);
+      free(longlink);
+      free(fatlink);
+    }
+#endif
+
+    // the gauge force and update use the MILC ordering
+    void *milc_sitelink = malloc(4*V*gaugeSiteSize*gSize);
+    for (int i=0; i<V; i++) {
+      for (int dir=0; dir<4; dir++) {
+	memcpy((char*)milc_sitelink + (4*i+dir)*gaugeSiteSize*gSize,
+	       (char*)sitelink[dir] + i*gaugeSiteSize*gSize, gaugeSiteSize*gSize);
+      }
+    }
+    gauge_param.gauge_order = QUDA_MILC_GAUGE_ORDER;
+
+    void *mom = malloc(4*V*momSiteSize*gSize);
+    memset(mom, 0, 4*V*momSiteSize*gSize);
+    createMomCPU(mom, p);
+
+#if defined(GPU_GAUGE_FORCE) && !defined(MULTI_GPU)
+    {
+      // the six plaquette staples for each direction
+      const int num_paths = 6, path_length = 3;
+      int length[num_paths];
+      double loop_coeff_d[num_paths];
+      float loop_coeff_f[num_paths];
+      for (int i=0; i<num_paths; i++) {
+	length[i] = path_length;
+	loop_coeff_d[i] = loop_coeff_f[i] = 1.0;
+      }
+      void *loop_coeff = (p == QUDA_SINGLE_PRECISION) ? (void*)loop_coeff_f : (void*)loop_coeff_d;
+
+      int **input_path_buf[4];
+      for (int mu=0; mu<4; mu++) {
+	input_path_buf[mu] = (int**)malloc(num_paths*sizeof(int*));
+	int n = 0;
+	for (int nu=0; nu<4; nu++) {
+	  if (nu == mu) continue;
+	  int up[] = { nu, 7-mu, 7-nu }, down[] = { 7-nu, 7-mu, nu };
+	  input_path_buf[mu][n] = (int*)malloc(path_length*sizeof(int));
+	  memcpy(input_path_buf[mu][n++], up, sizeof(up));
+	  input_path_buf[mu][n] = (int*)malloc(path_length*sizeof(int));
+	  memcpy(input_path_buf[mu][n++], down, sizeof(down));
+	}
+      }
+
+      double timeinfo[3];
+      computeGaugeForceQuda(mom, milc_sitelink, input_path_buf, length, loop_coeff,
+			    num_paths, path_length, 0.3, &gauge_param, timeinfo);
+
+      for (int mu=0; mu<4; mu++) {
+	for (int i=0; i<num_paths; i++) free(input_path_buf[mu][i]);
+	free(input_path_buf[mu]);
+      }
+    }
+#elif defined(GPU_GAUGE_FORCE)
+    printfQuda("Skipping the gauge force: multi-GPU runs need an extended gauge field\n");
+#endif
+
+    updateGaugeFieldQuda(milc_sitelink, mom, 0.1, &gauge_param);
+
+    free(mom);
+    free(milc_sitelink);
+    for (int dir=0; dir<4; dir++) free(sitelink[dir]);
+  }
+
+
+  void sweep()
+  {
+    for (unsigned int iv=0; iv<volumes.size(); iv++) {
+      const Volume &v = volumes[iv];
+      for (unsigned int ip=0; ip<precs.size(); ip++) {
+	QudaPrecision p = precs[ip];
+	// mixed precision solves use --prec_sloppy when it is lower
+	QudaPrecision p_sloppy = (prec_sloppy != QUDA_INVALID_PRECISION && prec_sloppy < p) ? prec_sloppy : p;
+
+	for (unsigned int ir=0; ir<recons.size(); ir++) {
+	  QudaReconstructType r = recons[ir];
+
+	  std::string key = comboKey(v, p, r, "links");
+	  if (!isCompleted(key)) {
+	    printfQuda("Tuning %s\n", key.c_str());
+	    sweepLinks(v, p, r);
+	    markCompleted(key);
+	  }
+
+	  for (unsigned int id=0; id<dslash_types.size(); id++) {
+	    QudaDslashType type = dslash_types[id];
+	    key = comboKey(v, p, r, get_dslash_type_str(type));
+	    if (isCompleted(key)) {
+	      printfQuda("Skipping %s (already tuned)\n", key.c_str());
+	      continue;
+	    }
+	    printfQuda("Tuning %s\n", key.c_str());
+
+	    if (type == QUDA_ASQTAD_DSLASH) sweepStaggered(v, p, p_sloppy, r);
+	    else sweepWilson(v, p, p_sloppy, r, type);
+
+	    markCompleted(key);
+	  }
+	}
+      }
+    }
+  }
+
+} // anonymous namespace
+
+
+void usage_extra(char** argv )
+{
+  printfQuda("Extra options:\n");
+  printfQuda("    --volumes <XxYxZxT,...>                   # Local volumes to tune (default from --xdim etc.)\n");
+  printfQuda("    --precs <double,single,half>              # Precisions to tune (default all)\n");
+  printfQuda("    --recons <18,12,8>                        # Link reconstructions to tune (default 18,12,8)\n");
+  printfQuda("    --dslash_types <wilson,clover,...>        # Dslash types to tune (default from --dslash_type)\n");
+  printfQuda("    --restart                                 # Ignore the progress of a previous sweep\n");
+  printfQuda("Note: --niter sets the number of solver iterations for each combination\n");
+  return ;
+}
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++){
+    if(process_command_line_option(argc, argv, &i) == 0){
+      continue;
+    }
+
+    if (strcmp(argv[i], "--restart") == 0) {
+      restart = true;
+      continue;
+    }
+
+    if (i+1 >= argc) usage(argv);
+    if (strcmp(argv[i], "--volumes") == 0) {
+      parseList(volumes, argv[++i], parseVolume);
+    } else if (strcmp(argv[i], "--precs") == 0) {
+      parseList(precs, argv[++i], get_prec);
+    } else if (strcmp(argv[i], "--recons") == 0) {
+      parseList(recons, argv[++i], get_recon);
+    } else if (strcmp(argv[i], "--dslash_types") == 0) {
+      parseList(dslash_types, argv[++i], get_dslash_type);
+    } else {
+      printfQuda("ERROR: Invalid option:%s\n", argv[i]);
+      usage(argv);
+    }
+  }
+
+  if (volumes.size() == 0) {
+    Volume v;
+    v.X[0] = xdim; v.X[1] = ydim; v.X[2] = zdim; v.X[3] = tdim;
+    volumes.push_back(v);
+  }
+  if (precs.size() == 0) {
+    precs.push_back(QUDA_DOUBLE_PRECISION);
+    precs.push_back(QUDA_SINGLE_PRECISION);
+    precs.push_back(QUDA_HALF_PRECISION);
+  }
+  if (recons.size() == 0) {
+    recons.push_back(QUDA_RECONSTRUCT_NO);
+    recons.push_back(QUDA_RECONSTRUCT_12);
+    recons.push_back(QUDA_RECONSTRUCT_8);
+  }
+  if (dslash_types.size() == 0) dslash_types.push_back(dslash_type);
+
+  if (!tune) {
+    printfQuda("ERROR: the tuning sweep requires --tune true\n");
+    exit(1);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  initQuda(device);
+  setVerbosity(QUDA_SUMMARIZE);
+  loadProgress();
+
+  sweep();
+
+  endQuda();
+  finalizeComms();
+
+  return 0;
+}